@@ -0,0 +1,962 @@
+/**
+ * @file tlist_bench.c
+ * @brief Microbenchmarks of the list operations, for catching performance regressions.
+ *
+ * Each workload runs for every selected element type, backend and size. A
+ * case runs in a child process of its own, so its peak RSS and heap state
+ * do not depend on the cases run before it. The timed part of a case is
+ * repeated until it has run for `--min-time` milliseconds. The report gives
+ * the mean time per operation, the heap allocations per operation (counted
+ * by wrapping `malloc` at link time, where the toolchain allows it) and the
+ * child's peak RSS.
+ *
+ *     tlist_bench [--format json|csv] [--output FILE] [--sizes N,N,...]
+ *                 [--types int,float,double,string,ptr] [--backends NAME,...]
+ *                 [--workloads NAME,...] [--min-time MS] [--no-fork]
+ *                 [--baseline FILE] [--threshold PERCENT] [--list]
+ *
+ * `--baseline` reads an earlier report (JSON or CSV) and adds each case's
+ * change against it. The exit status is 1 if any case got slower by more
+ * than the threshold or allocates more per operation than before, so the
+ * report can gate an upgrade.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "Tlist.h"
+#include <errno.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+
+/** Node visits (or moved slots) a case may spend per repetition on operations that are O(n). */
+#define BENCH_LINEAR_BUDGET (1L << 24)
+
+/** Element operations a repetition of a read-only workload performs at least, passing over small lists several times. */
+#define BENCH_MIN_BATCH (1L << 14)
+
+/** Number of distinct values pushed into `STRING` and `T` lists. */
+#define BENCH_POOL 4096
+
+/** Upper bound on the repetitions of one case. */
+#define BENCH_MAX_REPS 100000
+
+/** Wall-clock time, as a multiple of `--min-time`, after which a case stops repeating even if its untimed setup took most of it. */
+#define BENCH_WALL_FACTOR 5
+
+/* Allocation counting ----------------------------------------------------- */
+
+static atomic_long allocations;
+
+#ifdef TLIST_BENCH_WRAP
+// The build links with --wrap for these, so every call made by the library
+// (and by this file) lands here first.
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *pointer, size_t size);
+void *__real_aligned_alloc(size_t alignment, size_t size);
+
+void *__wrap_malloc(size_t size){
+    atomic_fetch_add_explicit(&allocations, 1, memory_order_relaxed);
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size){
+    atomic_fetch_add_explicit(&allocations, 1, memory_order_relaxed);
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *pointer, size_t size){
+    atomic_fetch_add_explicit(&allocations, 1, memory_order_relaxed);
+    return __real_realloc(pointer, size);
+}
+
+void *__wrap_aligned_alloc(size_t alignment, size_t size){
+    atomic_fetch_add_explicit(&allocations, 1, memory_order_relaxed);
+    return __real_aligned_alloc(alignment, size);
+}
+
+#define COUNTS_ALLOCATIONS true
+#else
+#define COUNTS_ALLOCATIONS false
+#endif
+
+/* Cases ------------------------------------------------------------------- */
+
+/**
+ * @struct Case
+ * @brief One workload run on one type, backend and size.
+ */
+typedef struct Case{
+    Type _type;
+    int _flags;
+    long _size;
+    List _list;         /**< Prefilled with `_size` elements before each repetition, if the workload asks for it. */
+    List _other;        /**< Second list, for workloads that need one. */
+    char _path[64];     /**< Image file of the `image_*` workloads. */
+    uint64_t _seed;     /**< State of the index generator. */
+} Case;
+
+static char *stringPool[BENCH_POOL];
+static long pointerPool[BENCH_POOL];
+static volatile double sink;
+
+/** @brief Builds the strings pushed into `STRING` lists: mostly short ones stored inline, one in four long. */
+static void fillPools(void){
+    for (int i = 0; i < BENCH_POOL; i++){
+        char buffer[64];
+        if (i % 4 == 3) snprintf(buffer, sizeof buffer, "a longer value that lives on the heap %d", i);
+        else snprintf(buffer, sizeof buffer, "value-%d", i);
+        stringPool[i] = malloc(strlen(buffer) + 1);
+        if (stringPool[i] == NULL) {
+            fprintf(stderr, "Error in tlist_bench: Memory allocation failed.\n");
+            exit(EXIT_FAILURE);
+        }
+        strcpy(stringPool[i], buffer);
+        pointerPool[i] = i;
+    }
+}
+
+/** @brief Pushes the `i`-th value of the case's type. */
+static void pushNth(List list, Type type, long i){
+    switch (type){
+        case INT: list->methods->push(list, (int)i); break;
+        case FLOAT: list->methods->push(list, (float)i); break;
+        case DOUBLE: list->methods->push(list, (double)i); break;
+        case STRING: list->methods->push(list, stringPool[i % BENCH_POOL]); break;
+        case T: list->methods->push(list, &pointerPool[i % BENCH_POOL]); break;
+    }
+}
+
+/** @brief Inserts the `i`-th value of the case's type at `index`. */
+static void insertNth(List list, Type type, int index, long i){
+    switch (type){
+        case INT: list->methods->insert(list, index, (int)i); break;
+        case FLOAT: list->methods->insert(list, index, (float)i); break;
+        case DOUBLE: list->methods->insert(list, index, (double)i); break;
+        case STRING: list->methods->insert(list, index, stringPool[i % BENCH_POOL]); break;
+        case T: list->methods->insert(list, index, &pointerPool[i % BENCH_POOL]); break;
+    }
+}
+
+/** @brief Frees a value returned by `pop` or `pick`; `T` values belong to the caller. */
+static void dropValue(Type type, void *value){
+    if (type != T) free(value);
+}
+
+static List newCaseList(const Case *c){
+    List list = newListWithFlags(c->_type, c->_flags);
+    if (list == NULL) exit(EXIT_FAILURE);
+    return list;
+}
+
+static List filledList(const Case *c){
+    List list = newCaseList(c);
+    for (long i = 0; i < c->_size; i++) pushNth(list, c->_type, i);
+    return list;
+}
+
+static void freeList(List list){
+    if (list == NULL) return;
+    listDestroy(list);
+    free(list);
+}
+
+/** @brief xorshift64, cheap enough not to show in the timings. */
+static long randomIndex(Case *c, long bound){
+    c->_seed ^= c->_seed << 13;
+    c->_seed ^= c->_seed >> 7;
+    c->_seed ^= c->_seed << 17;
+    return (long)(c->_seed % (uint64_t)bound);
+}
+
+/** @brief Whether a positional lookup walks the list instead of indexing an array. */
+static bool walksToIndex(const Case *c){
+    return !(c->_flags & LIST_VECTOR);
+}
+
+/** @brief Number of O(n) operations that fit in `BENCH_LINEAR_BUDGET`, between 1 and `cap`. */
+static long linearOps(const Case *c, long cap){
+    long ops = BENCH_LINEAR_BUDGET / (c->_size > 0 ? c->_size : 1);
+    if (ops > cap) ops = cap;
+    return ops < 1 ? 1 : ops;
+}
+
+/** @brief Number of passes a read-only workload makes over the list, so that small lists still time a useful batch. */
+static long passes(const Case *c){
+    return c->_size >= BENCH_MIN_BATCH ? 1 : (BENCH_MIN_BATCH + c->_size - 1) / c->_size;
+}
+
+static bool isNumeric(Type type){
+    return type == INT || type == FLOAT || type == DOUBLE;
+}
+
+/* Workloads --------------------------------------------------------------- */
+
+/** How a workload wants `_list` prepared. */
+typedef enum Prefill{
+    PREFILL_NONE,   /**< `_list` starts out `NULL`. */
+    PREFILL_EACH,   /**< A new list of `_size` elements before each repetition. */
+    PREFILL_ONCE    /**< One list of `_size` elements for all repetitions: the workload only reads it. */
+} Prefill;
+
+/**
+ * @struct Workload
+ * @brief A timed operation pattern.
+ */
+typedef struct Workload{
+    const char *_name;
+    const char *_description;
+    Prefill _prefill;
+    int _fixedFlags;                    /**< Backend the workload always uses, or -1 to follow `--backends`. */
+    const char *_fixedBackend;          /**< Name reported for `_fixedFlags`. */
+    bool (*_applies)(const Case *c);    /**< `NULL` if the workload applies to every case. */
+    void (*_setup)(Case *c);            /**< Untimed preparation, after the prefill. */
+    long (*_run)(Case *c);              /**< Timed part; returns the number of operations performed. */
+} Workload;
+
+static long runPush(Case *c){
+    c->_list = newCaseList(c);
+    for (long i = 0; i < c->_size; i++) pushNth(c->_list, c->_type, i);
+    return c->_size;
+}
+
+static long runFifoChurn(Case *c){
+    long ops = c->_size < BENCH_MIN_BATCH ? BENCH_MIN_BATCH : c->_size;
+    for (long i = 0; i < ops; i++){
+        pushNth(c->_list, c->_type, i);
+        dropValue(c->_type, listPop(c->_list));
+    }
+    return ops;
+}
+
+static long runGetRandom(Case *c){
+    long ops = walksToIndex(c) ? linearOps(c, c->_size) : c->_size * passes(c);
+    for (long i = 0; i < ops; i++){
+        sink = (double)(uintptr_t)listGet(c->_list, (int)randomIndex(c, c->_size));
+    }
+    return ops;
+}
+
+static long runGetSequential(Case *c){
+    long rounds = passes(c);
+    for (long r = 0; r < rounds; r++){
+        for (long i = 0; i < c->_size; i++){
+            sink = (double)(uintptr_t)listGet(c->_list, (int)i);
+        }
+    }
+    return rounds * c->_size;
+}
+
+static long runIterator(Case *c){
+    long rounds = passes(c);
+    for (long r = 0; r < rounds; r++){
+        TIterator it = newIterator(c->_list);
+        while (it->hasNext(it)) sink = (double)(uintptr_t)it->next(it);
+        it->free(it);
+    }
+    return rounds * c->_size;
+}
+
+static long runForeachMacro(Case *c){
+    long rounds = passes(c);
+    for (long r = 0; r < rounds; r++){
+        TLIST_FOREACH(c->_list, value) {
+            sink = (double)(uintptr_t)value;
+        }
+    }
+    return rounds * c->_size;
+}
+
+static double visited;
+
+static void visitValue(void *value){
+    visited += (double)(uintptr_t)value;
+}
+
+static long runForeach(Case *c){
+    long rounds = passes(c);
+    for (long r = 0; r < rounds; r++) listForeach(c->_list, visitValue);
+    sink = visited;
+    return rounds * c->_size;
+}
+
+static long runInsertMiddle(Case *c){
+    long ops = linearOps(c, c->_size);
+    for (long i = 0; i < ops; i++){
+        insertNth(c->_list, c->_type, listLen(c->_list) / 2, i);
+    }
+    return ops;
+}
+
+static long runDeleteMiddle(Case *c){
+    long ops = linearOps(c, (c->_size + 1) / 2);
+    for (long i = 0; i < ops; i++){
+        listRemove(c->_list, listLen(c->_list) / 2);
+    }
+    return ops;
+}
+
+static long runDuplicate(Case *c){
+    long ops = 1024;
+    for (long i = 0; i < ops; i++) freeList(duplicate(c->_list));
+    return ops;
+}
+
+static long runDuplicateWrite(Case *c){
+    long ops = linearOps(c, 1024);
+    for (long i = 0; i < ops; i++){
+        List copy = duplicate(c->_list);
+        pushNth(copy, c->_type, i);
+        freeList(copy);
+    }
+    return ops;
+}
+
+static bool appliesNumeric(const Case *c){
+    return isNumeric(c->_type);
+}
+
+static long runSumReduce(Case *c){
+    long rounds = passes(c);
+    for (long r = 0; r < rounds; r++) sink = listSum(c->_list);
+    return rounds * c->_size;
+}
+
+static double foreachSum;
+
+static void addInt(void *value){ foreachSum += *(int *)value; }
+static void addFloat(void *value){ foreachSum += *(float *)value; }
+static void addDouble(void *value){ foreachSum += *(double *)value; }
+
+static void (*adder(Type type))(void *){
+    return type == INT ? addInt : type == FLOAT ? addFloat : addDouble;
+}
+
+static long runSumForeach(Case *c){
+    long rounds = passes(c);
+    for (long r = 0; r < rounds; r++){
+        foreachSum = 0;
+        listForeach(c->_list, adder(c->_type));
+        sink = foreachSum;
+    }
+    return rounds * c->_size;
+}
+
+/** @brief Per-element work of the `parallel_*` workloads: a few dependent floating-point operations. */
+static void parallelWork(void *value){
+    double x = (double)(uintptr_t)value;
+    for (int i = 0; i < 16; i++) x = x * 0.999 + 1.0;
+    if (x < 0) sink = x;
+}
+
+static long runParallel(Case *c, int threads){
+    long rounds = passes(c);
+    for (long r = 0; r < rounds; r++) parallelForeach(c->_list, parallelWork, threads);
+    return rounds * c->_size;
+}
+
+static long runParallel1(Case *c){ return runParallel(c, 1); }
+static long runParallel2(Case *c){ return runParallel(c, 2); }
+static long runParallel4(Case *c){ return runParallel(c, 4); }
+static long runParallel8(Case *c){ return runParallel(c, 8); }
+
+static bool appliesInt(const Case *c){
+    return c->_type == INT;
+}
+
+/**
+ * @struct Exchange
+ * @brief Shared state of the producers and consumers of the `mpmc_*` workloads.
+ */
+typedef struct Exchange{
+    List _list;
+    long _perProducer;
+    atomic_long _remaining;     /**< Elements still to be consumed. */
+    pthread_mutex_t *_lock;     /**< Guards every call on `_list` in `mpmc_mutex`, `NULL` otherwise. */
+} Exchange;
+
+/** Producer and consumer threads each of the `mpmc_*` workloads starts. */
+#define BENCH_MPMC_THREADS 2
+
+static void *produce(void *argument){
+    Exchange *e = argument;
+    for (long i = 0; i < e->_perProducer; i++){
+        if (e->_lock != NULL) pthread_mutex_lock(e->_lock);
+        e->_list->methods->push(e->_list, (int)i);
+        if (e->_lock != NULL) pthread_mutex_unlock(e->_lock);
+    }
+    return NULL;
+}
+
+static void *consume(void *argument){
+    Exchange *e = argument;
+    int value;
+    while (atomic_load_explicit(&e->_remaining, memory_order_relaxed) > 0){
+        if (e->_lock != NULL) pthread_mutex_lock(e->_lock);
+        bool popped = popInto(e->_list, &value);
+        if (e->_lock != NULL) pthread_mutex_unlock(e->_lock);
+        if (popped) atomic_fetch_sub_explicit(&e->_remaining, 1, memory_order_relaxed);
+        else sched_yield();
+    }
+    return NULL;
+}
+
+static long exchange(Case *c, pthread_mutex_t *lock){
+    Exchange e = { ._list = newCaseList(c), ._lock = lock };
+    e._perProducer = (c->_size < BENCH_MIN_BATCH ? BENCH_MIN_BATCH : c->_size) / BENCH_MPMC_THREADS;
+    atomic_init(&e._remaining, e._perProducer * BENCH_MPMC_THREADS);
+    pthread_t threads[2 * BENCH_MPMC_THREADS];
+    for (int i = 0; i < BENCH_MPMC_THREADS; i++){
+        pthread_create(&threads[2 * i], NULL, consume, &e);
+        pthread_create(&threads[2 * i + 1], NULL, produce, &e);
+    }
+    for (int i = 0; i < 2 * BENCH_MPMC_THREADS; i++) pthread_join(threads[i], NULL);
+    c->_other = e._list;
+    return e._perProducer * BENCH_MPMC_THREADS;
+}
+
+static long runMpmc(Case *c){
+    return exchange(c, NULL);
+}
+
+/** @brief The `mpmc_queue` exchange on a plain list behind one mutex, the baseline the lock-free queue is compared against. */
+static long runMpmcMutex(Case *c){
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+    long ops = exchange(c, &lock);
+    pthread_mutex_destroy(&lock);
+    return ops;
+}
+
+static void setupSplice(Case *c){
+    c->_other = newCaseList(c);
+}
+
+static long runSplice(Case *c){
+    long ops = linearOps(c, 1024);
+    int half = (int)(c->_size / 2);
+    for (long i = 0; i < ops; i++){
+        spliceRange(c->_other, 0, c->_list, 0, half);
+        spliceRange(c->_list, listLen(c->_list), c->_other, 0, half);
+    }
+    return 2 * ops;
+}
+
+static bool appliesImage(const Case *c){
+    return c->_type != T;
+}
+
+static void setupImage(Case *c){
+    snprintf(c->_path, sizeof c->_path, "/tmp/tlist_bench.%ld.img", (long)getpid());
+    if (!saveList(c->_list, c->_path)) exit(EXIT_FAILURE);
+    freeList(c->_list);
+    c->_list = NULL;
+}
+
+static long runImageLoad(Case *c){
+    c->_list = loadList(c->_path, c->_flags);
+    if (c->_list == NULL) exit(EXIT_FAILURE);
+    return c->_size;
+}
+
+/** @brief Maps the image and reads every element once, so that the pages are actually touched. */
+static long runImageMmap(Case *c){
+    c->_list = mmapList(c->_path);
+    if (c->_list == NULL) exit(EXIT_FAILURE);
+    TLIST_FOREACH(c->_list, value) {
+        sink = (double)(uintptr_t)value;
+    }
+    return c->_size;
+}
+
+static const Workload workloads[] = {
+    { "push", "push n elements onto an empty list", PREFILL_NONE, -1, NULL, NULL, NULL, runPush },
+    { "pop_fifo", "FIFO churn: push at the tail and pop the head of an n-element list", PREFILL_EACH, -1, NULL, NULL, NULL, runFifoChurn },
+    { "get_random", "get at random indices", PREFILL_ONCE, -1, NULL, NULL, NULL, runGetRandom },
+    { "get_sequential", "get at ascending indices", PREFILL_ONCE, -1, NULL, NULL, NULL, runGetSequential },
+    { "iterator", "full traversal with a heap TIterator", PREFILL_ONCE, -1, NULL, NULL, NULL, runIterator },
+    { "iterator_inline", "full traversal with TLIST_FOREACH", PREFILL_ONCE, -1, NULL, NULL, NULL, runForeachMacro },
+    { "foreach", "full traversal with the foreach method", PREFILL_ONCE, -1, NULL, NULL, NULL, runForeach },
+    { "insert_middle", "insert at the middle index", PREFILL_EACH, -1, NULL, NULL, NULL, runInsertMiddle },
+    { "delete_middle", "remove at the middle index", PREFILL_EACH, -1, NULL, NULL, NULL, runDeleteMiddle },
+    { "duplicate", "duplicate and free the copy", PREFILL_ONCE, -1, NULL, NULL, NULL, runDuplicate },
+    { "duplicate_write", "duplicate, write to the copy, free it", PREFILL_ONCE, -1, NULL, NULL, NULL, runDuplicateWrite },
+    { "sum_reduce", "listSum over the list", PREFILL_ONCE, -1, NULL, appliesNumeric, NULL, runSumReduce },
+    { "sum_foreach", "the same sum through foreach", PREFILL_ONCE, -1, NULL, appliesNumeric, NULL, runSumForeach },
+    { "parallel_t1", "parallelForeach on 1 thread", PREFILL_ONCE, -1, NULL, NULL, NULL, runParallel1 },
+    { "parallel_t2", "parallelForeach on 2 threads", PREFILL_ONCE, -1, NULL, NULL, NULL, runParallel2 },
+    { "parallel_t4", "parallelForeach on 4 threads", PREFILL_ONCE, -1, NULL, NULL, NULL, runParallel4 },
+    { "parallel_t8", "parallelForeach on 8 threads", PREFILL_ONCE, -1, NULL, NULL, NULL, runParallel8 },
+    { "mpmc_queue", "2 producers and 2 consumers on a LIST_QUEUE list", PREFILL_NONE, LIST_QUEUE, "queue", appliesInt, NULL, runMpmc },
+    { "mpmc_sync", "2 producers and 2 consumers on a LIST_SYNC list", PREFILL_NONE, LIST_SYNC, "sync", appliesInt, NULL, runMpmc },
+    { "mpmc_mutex", "2 producers and 2 consumers on a plain list behind a mutex", PREFILL_NONE, LIST_DEFAULT, "mutex", appliesInt, NULL, runMpmcMutex },
+    { "splice", "move half of the list to another list and back", PREFILL_EACH, -1, NULL, NULL, setupSplice, runSplice },
+    { "image_load", "loadList of a saved image", PREFILL_EACH, -1, NULL, appliesImage, setupImage, runImageLoad },
+    { "image_mmap", "mmapList of a saved image and one traversal", PREFILL_EACH, LIST_VECTOR, "mmap", appliesImage, setupImage, runImageMmap },
+};
+
+#define WORKLOAD_COUNT (sizeof workloads / sizeof *workloads)
+
+/* Selection --------------------------------------------------------------- */
+
+static const struct { const char *_name; Type _type; } typeNames[] = {
+    { "int", INT }, { "float", FLOAT }, { "double", DOUBLE }, { "string", STRING }, { "ptr", T },
+};
+
+static const struct { const char *_name; int _flags; } backendNames[] = {
+    { "default", LIST_DEFAULT }, { "slab", LIST_SLAB }, { "doubly", LIST_DOUBLY },
+    { "unrolled", LIST_UNROLLED }, { "vector", LIST_VECTOR }, { "sync", LIST_SYNC },
+    { "arena", LIST_ARENA }, { "intern", LIST_INTERN },
+};
+
+#define TYPE_COUNT (sizeof typeNames / sizeof *typeNames)
+#define BACKEND_COUNT (sizeof backendNames / sizeof *backendNames)
+
+/**
+ * @struct Config
+ * @brief Command-line options.
+ */
+typedef struct Config{
+    bool _json;
+    FILE *_out;
+    long _sizes[32];
+    int _sizeCount;
+    bool _types[TYPE_COUNT];
+    bool _backends[BACKEND_COUNT];
+    bool _workloads[WORKLOAD_COUNT];
+    double _minTime;        /**< Seconds. */
+    bool _fork;
+    const char *_baseline;
+    double _threshold;      /**< Allowed slowdown, as a fraction. */
+} Config;
+
+/** @brief Marks the names of a comma-separated list in `selected`; returns `false` on an unknown name. */
+static bool selectNames(const char *list, const char *const *names, size_t count, bool *selected){
+    memset(selected, 0, count * sizeof(bool));
+    const char *p = list;
+    while (*p != '\0'){
+        size_t length = strcspn(p, ",");
+        bool found = false;
+        for (size_t i = 0; i < count; i++){
+            if (strlen(names[i]) == length && strncmp(names[i], p, length) == 0) {
+                selected[i] = true;
+                found = true;
+            }
+        }
+        if (!found) {
+            fprintf(stderr, "Error in tlist_bench: Unknown name \"%.*s\".\n", (int)length, p);
+            return false;
+        }
+        p += length;
+        if (*p == ',') p++;
+    }
+    return true;
+}
+
+static void usage(FILE *out){
+    fprintf(out,
+        "Usage: tlist_bench [options]\n"
+        "  --format json|csv       report format (default json)\n"
+        "  --output FILE           write the report to FILE instead of stdout\n"
+        "  --sizes N,N,...         list sizes (default 10,1000,100000,10000000)\n"
+        "  --types NAME,...        int, float, double, string, ptr (default all)\n"
+        "  --backends NAME,...     default, slab, doubly, unrolled, vector, sync, arena, intern\n"
+        "                          (default: default,slab,unrolled,vector)\n"
+        "  --workloads NAME,...    workloads to run (default all; see --list)\n"
+        "  --min-time MS           minimum timed duration per case (default 200)\n"
+        "  --no-fork               run every case in this process; peak RSS is then cumulative\n"
+        "  --baseline FILE         compare against an earlier JSON or CSV report\n"
+        "  --threshold PERCENT     slowdown that counts as a regression (default 10)\n"
+        "  --list                  list the workloads and exit\n");
+}
+
+static bool parseArguments(int argc, char **argv, Config *config){
+    const char *typeList[TYPE_COUNT], *backendList[BACKEND_COUNT], *workloadList[WORKLOAD_COUNT];
+    for (size_t i = 0; i < TYPE_COUNT; i++) typeList[i] = typeNames[i]._name;
+    for (size_t i = 0; i < BACKEND_COUNT; i++) backendList[i] = backendNames[i]._name;
+    for (size_t i = 0; i < WORKLOAD_COUNT; i++) workloadList[i] = workloads[i]._name;
+
+    *config = (Config){ ._json = true, ._out = stdout, ._minTime = 0.2, ._fork = true, ._threshold = 0.10 };
+    long defaultSizes[] = { 10, 1000, 100000, 10000000 };
+    config->_sizeCount = 4;
+    memcpy(config->_sizes, defaultSizes, sizeof defaultSizes);
+    for (size_t i = 0; i < TYPE_COUNT; i++) config->_types[i] = true;
+    selectNames("default,slab,unrolled,vector", backendList, BACKEND_COUNT, config->_backends);
+    for (size_t i = 0; i < WORKLOAD_COUNT; i++) config->_workloads[i] = true;
+
+    for (int i = 1; i < argc; i++){
+        const char *option = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        bool takesValue = true;
+        if (strcmp(option, "--list") == 0) {
+            for (size_t w = 0; w < WORKLOAD_COUNT; w++) printf("%-16s %s\n", workloads[w]._name, workloads[w]._description);
+            exit(EXIT_SUCCESS);
+        } else if (strcmp(option, "--help") == 0) {
+            usage(stdout);
+            exit(EXIT_SUCCESS);
+        } else if (strcmp(option, "--no-fork") == 0) {
+            config->_fork = false;
+            takesValue = false;
+        } else if (value == NULL) {
+            usage(stderr);
+            return false;
+        } else if (strcmp(option, "--format") == 0) {
+            if (strcmp(value, "json") != 0 && strcmp(value, "csv") != 0) {
+                fprintf(stderr, "Error in tlist_bench: Unknown format \"%s\".\n", value);
+                return false;
+            }
+            config->_json = strcmp(value, "json") == 0;
+        } else if (strcmp(option, "--output") == 0) {
+            config->_out = fopen(value, "w");
+            if (config->_out == NULL) {
+                fprintf(stderr, "Error in tlist_bench: Cannot open %s: %s.\n", value, strerror(errno));
+                return false;
+            }
+        } else if (strcmp(option, "--sizes") == 0) {
+            config->_sizeCount = 0;
+            for (const char *p = value; *p != '\0' && config->_sizeCount < 32;){
+                char *end;
+                long size = strtol(p, &end, 10);
+                if (end == p || size < 1 || size > INT32_MAX || (*end != ',' && *end != '\0')) {
+                    fprintf(stderr, "Error in tlist_bench: Invalid size list \"%s\".\n", value);
+                    return false;
+                }
+                config->_sizes[config->_sizeCount++] = size;
+                p = *end == ',' ? end + 1 : end;
+            }
+        } else if (strcmp(option, "--types") == 0) {
+            if (!selectNames(value, typeList, TYPE_COUNT, config->_types)) return false;
+        } else if (strcmp(option, "--backends") == 0) {
+            if (!selectNames(value, backendList, BACKEND_COUNT, config->_backends)) return false;
+        } else if (strcmp(option, "--workloads") == 0) {
+            if (!selectNames(value, workloadList, WORKLOAD_COUNT, config->_workloads)) return false;
+        } else if (strcmp(option, "--min-time") == 0) {
+            config->_minTime = atof(value) / 1000;
+        } else if (strcmp(option, "--baseline") == 0) {
+            config->_baseline = value;
+        } else if (strcmp(option, "--threshold") == 0) {
+            config->_threshold = atof(value) / 100;
+        } else {
+            usage(stderr);
+            return false;
+        }
+        if (takesValue) i++;
+    }
+    return true;
+}
+
+/* Running ----------------------------------------------------------------- */
+
+/**
+ * @struct Result
+ * @brief Measurements of one case, passed from the child to the parent through a pipe.
+ */
+typedef struct Result{
+    char _workload[32];
+    char _type[16];
+    char _backend[16];
+    long _size;
+    long _ops;
+    double _nsPerOp;
+    double _allocsPerOp;    /**< Negative when allocations are not counted. */
+    long _peakRssKb;
+} Result;
+
+static double now(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/** @brief Runs the repetitions of a case and fills in its timings. */
+static void measure(const Workload *w, Case *c, const Config *config, Result *result){
+    double elapsed = 0;
+    double wallStart = now();
+    long ops = 0;
+    long allocs = 0;
+    int reps = 0;
+    List kept = w->_prefill == PREFILL_ONCE ? filledList(c) : NULL;
+    do {
+        c->_list = w->_prefill == PREFILL_EACH ? filledList(c) : kept;
+        c->_other = NULL;
+        if (w->_setup != NULL) w->_setup(c);
+        long before = atomic_load(&allocations);
+        double start = now();
+        ops += w->_run(c);
+        elapsed += now() - start;
+        allocs += atomic_load(&allocations) - before;
+        if (c->_list != kept) freeList(c->_list);
+        freeList(c->_other);
+        if (c->_path[0] != '\0') remove(c->_path);
+        c->_path[0] = '\0';
+        reps++;
+    } while (elapsed < config->_minTime && reps < BENCH_MAX_REPS
+        && now() - wallStart < BENCH_WALL_FACTOR * config->_minTime);
+    freeList(kept);
+    result->_ops = ops;
+    result->_nsPerOp = elapsed * 1e9 / (double)ops;
+    result->_allocsPerOp = COUNTS_ALLOCATIONS ? (double)allocs / (double)ops : -1;
+}
+
+/** @brief Runs a case in a child process, or in this one with `--no-fork`. */
+static bool runCase(const Workload *w, Case *c, const Config *config, Result *result){
+    if (!config->_fork) {
+        measure(w, c, config, result);
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        result->_peakRssKb = usage.ru_maxrss;
+        return true;
+    }
+    int fds[2];
+    if (pipe(fds) != 0) {
+        fprintf(stderr, "Error in tlist_bench: pipe failed: %s.\n", strerror(errno));
+        return false;
+    }
+    fflush(NULL);
+    pid_t pid = fork();
+    if (pid < 0) {
+        fprintf(stderr, "Error in tlist_bench: fork failed: %s.\n", strerror(errno));
+        return false;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        measure(w, c, config, result);
+        parallelShutdown();
+        bool written = write(fds[1], result, sizeof *result) == (ssize_t)sizeof *result;
+        _exit(written ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    close(fds[1]);
+    ssize_t got = read(fds[0], result, sizeof *result);
+    close(fds[0]);
+    int status;
+    struct rusage usage;
+    if (wait4(pid, &status, 0, &usage) < 0 || got != (ssize_t)sizeof *result
+        || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+        fprintf(stderr, "Error in tlist_bench: Case %s/%s/%s/%ld failed.\n",
+            result->_workload, result->_type, result->_backend, result->_size);
+        return false;
+    }
+    result->_peakRssKb = usage.ru_maxrss;
+    return true;
+}
+
+/* Baseline ---------------------------------------------------------------- */
+
+/**
+ * @struct Baseline
+ * @brief Results read from an earlier report.
+ */
+typedef struct Baseline{
+    Result *_results;
+    size_t _count;
+    size_t _capacity;
+} Baseline;
+
+/** @brief Copies the value of `"key": ...` from a JSON line into `out`; returns `false` if absent. */
+static bool jsonField(const char *line, const char *key, char *out, size_t size){
+    char pattern[40];
+    snprintf(pattern, sizeof pattern, "\"%s\":", key);
+    const char *p = strstr(line, pattern);
+    if (p == NULL) return false;
+    p += strlen(pattern);
+    while (*p == ' ') p++;
+    if (*p == '"') p++;
+    size_t length = strcspn(p, "\",}");
+    if (length >= size) length = size - 1;
+    memcpy(out, p, length);
+    out[length] = '\0';
+    return true;
+}
+
+/** @brief Copies column `column` of a CSV line into `out`. */
+static bool csvField(const char *line, int column, char *out, size_t size){
+    for (int i = 0; i < column; i++){
+        line = strchr(line, ',');
+        if (line == NULL) return false;
+        line++;
+    }
+    size_t length = strcspn(line, ",\r\n");
+    if (length >= size) length = size - 1;
+    memcpy(out, line, length);
+    out[length] = '\0';
+    return true;
+}
+
+static const char *const reportColumns[] = { "workload", "type", "backend", "size", "ops", "ns_per_op", "allocs_per_op", "peak_rss_kb" };
+
+static bool loadBaseline(const char *path, Baseline *baseline){
+    FILE *in = fopen(path, "r");
+    if (in == NULL) {
+        fprintf(stderr, "Error in tlist_bench: Cannot open %s: %s.\n", path, strerror(errno));
+        return false;
+    }
+    char line[1024];
+    int columns[8];
+    bool csv = false;
+    while (fgets(line, sizeof line, in) != NULL){
+        if (!csv && strncmp(line, "workload,", 9) == 0) {
+            // Locate the columns by name, so reports with extra columns still load.
+            csv = true;
+            for (int k = 0; k < 8; k++){
+                columns[k] = -1;
+                char name[32];
+                for (int col = 0; csvField(line, col, name, sizeof name); col++){
+                    if (strcmp(name, reportColumns[k]) == 0) columns[k] = col;
+                }
+            }
+            continue;
+        }
+        char fields[8][64];
+        bool complete = true;
+        for (int k = 0; k < 8 && complete; k++){
+            if (k == 4 || k == 7) {
+                fields[k][0] = '\0';
+                continue;
+            }
+            complete = csv ? columns[k] >= 0 && csvField(line, columns[k], fields[k], sizeof fields[k])
+                           : jsonField(line, reportColumns[k], fields[k], sizeof fields[k]);
+        }
+        if (!complete) continue;
+        if (baseline->_count == baseline->_capacity) {
+            baseline->_capacity = baseline->_capacity == 0 ? 64 : baseline->_capacity * 2;
+            baseline->_results = realloc(baseline->_results, baseline->_capacity * sizeof(Result));
+            if (baseline->_results == NULL) {
+                fprintf(stderr, "Error in tlist_bench: Memory allocation failed.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        Result *r = &baseline->_results[baseline->_count++];
+        memset(r, 0, sizeof *r);
+        snprintf(r->_workload, sizeof r->_workload, "%.31s", fields[0]);
+        snprintf(r->_type, sizeof r->_type, "%.15s", fields[1]);
+        snprintf(r->_backend, sizeof r->_backend, "%.15s", fields[2]);
+        r->_size = atol(fields[3]);
+        r->_nsPerOp = atof(fields[5]);
+        r->_allocsPerOp = strcmp(fields[6], "null") == 0 || fields[6][0] == '\0' ? -1 : atof(fields[6]);
+    }
+    fclose(in);
+    return true;
+}
+
+static const Result *findBaseline(const Baseline *baseline, const Result *result){
+    for (size_t i = 0; i < baseline->_count; i++){
+        const Result *r = &baseline->_results[i];
+        if (r->_size == result->_size && strcmp(r->_workload, result->_workload) == 0
+            && strcmp(r->_type, result->_type) == 0 && strcmp(r->_backend, result->_backend) == 0) return r;
+    }
+    return NULL;
+}
+
+/* Report ------------------------------------------------------------------ */
+
+static void reportHeader(const Config *config){
+    if (config->_json) {
+        fprintf(config->_out, "{\n  \"simd\": \"%s\",\n  \"min_time_ms\": %.0f,\n  \"allocations_counted\": %s,\n  \"results\": [\n",
+            simdLevel(), config->_minTime * 1000, COUNTS_ALLOCATIONS ? "true" : "false");
+    } else {
+        for (size_t k = 0; k < 8; k++) fprintf(config->_out, "%s%s", k == 0 ? "" : ",", reportColumns[k]);
+        fprintf(config->_out, "%s\n", config->_baseline != NULL ? ",baseline_ns_per_op,change_pct,regression" : "");
+    }
+}
+
+/** @brief Writes one result; returns whether it is a regression against `base`. */
+static bool reportResult(const Config *config, const Result *r, const Result *base, bool first){
+    bool regression = false;
+    double change = 0;
+    if (base != NULL) {
+        change = base->_nsPerOp > 0 ? (r->_nsPerOp / base->_nsPerOp - 1) * 100 : 0;
+        regression = change > config->_threshold * 100
+            || (r->_allocsPerOp >= 0 && base->_allocsPerOp >= 0 && r->_allocsPerOp > base->_allocsPerOp + 0.005);
+    }
+    char allocs[32];
+    if (r->_allocsPerOp < 0) snprintf(allocs, sizeof allocs, "%s", config->_json ? "null" : "");
+    else snprintf(allocs, sizeof allocs, "%.3f", r->_allocsPerOp);
+    if (config->_json) {
+        fprintf(config->_out, "%s    {\"workload\": \"%s\", \"type\": \"%s\", \"backend\": \"%s\", \"size\": %ld, "
+            "\"ops\": %ld, \"ns_per_op\": %.3f, \"allocs_per_op\": %s, \"peak_rss_kb\": %ld",
+            first ? "" : ",\n", r->_workload, r->_type, r->_backend, r->_size, r->_ops, r->_nsPerOp, allocs, r->_peakRssKb);
+        if (base != NULL) {
+            fprintf(config->_out, ", \"baseline_ns_per_op\": %.3f, \"change_pct\": %.1f, \"regression\": %s",
+                base->_nsPerOp, change, regression ? "true" : "false");
+        }
+        fprintf(config->_out, "}");
+    } else {
+        fprintf(config->_out, "%s,%s,%s,%ld,%ld,%.3f,%s,%ld", r->_workload, r->_type, r->_backend,
+            r->_size, r->_ops, r->_nsPerOp, allocs, r->_peakRssKb);
+        if (config->_baseline != NULL) {
+            if (base != NULL) fprintf(config->_out, ",%.3f,%.1f,%d", base->_nsPerOp, change, regression);
+            else fprintf(config->_out, ",,,");
+        }
+        fprintf(config->_out, "\n");
+    }
+    fflush(config->_out);
+    if (regression) {
+        fprintf(stderr, "Regression: %s/%s/%s/%ld %.1f ns/op (baseline %.1f, %+.1f%%)\n",
+            r->_workload, r->_type, r->_backend, r->_size, r->_nsPerOp, base->_nsPerOp, change);
+    }
+    return regression;
+}
+
+static void reportFooter(const Config *config){
+    if (config->_json) fprintf(config->_out, "\n  ]\n}\n");
+}
+
+int main(int argc, char **argv){
+    Config config;
+    if (!parseArguments(argc, argv, &config)) return 2;
+    Baseline baseline = { 0 };
+    if (config._baseline != NULL && !loadBaseline(config._baseline, &baseline)) return 2;
+    fillPools();
+    reportHeader(&config);
+
+    bool first = true;
+    int regressions = 0;
+    int failures = 0;
+    for (size_t w = 0; w < WORKLOAD_COUNT; w++){
+        if (!config._workloads[w]) continue;
+        const Workload *workload = &workloads[w];
+        for (size_t t = 0; t < TYPE_COUNT; t++){
+            if (!config._types[t]) continue;
+            for (size_t b = 0; b < BACKEND_COUNT; b++){
+                if (!config._backends[b]) continue;
+                int flags = backendNames[b]._flags;
+                // The string flags are ignored for other types, which would only repeat the default backend.
+                if ((flags & (LIST_ARENA | LIST_INTERN)) && typeNames[t]._type != STRING) continue;
+                for (int s = 0; s < config._sizeCount; s++){
+                    Case c = { ._type = typeNames[t]._type, ._flags = flags, ._size = config._sizes[s], ._seed = 88172645463325252ULL };
+                    Result result = { ._size = c._size };
+                    if (workload->_fixedFlags >= 0) c._flags = workload->_fixedFlags;
+                    if (workload->_applies != NULL && !workload->_applies(&c)) continue;
+                    snprintf(result._workload, sizeof result._workload, "%s", workload->_name);
+                    snprintf(result._type, sizeof result._type, "%s", typeNames[t]._name);
+                    snprintf(result._backend, sizeof result._backend, "%s",
+                        workload->_fixedFlags >= 0 ? workload->_fixedBackend : backendNames[b]._name);
+                    if (!runCase(workload, &c, &config, &result)) {
+                        failures++;
+                        continue;
+                    }
+                    const Result *base = config._baseline != NULL ? findBaseline(&baseline, &result) : NULL;
+                    regressions += reportResult(&config, &result, base, first);
+                    first = false;
+                }
+                // Workloads with a fixed backend run once per type and size.
+                if (workload->_fixedFlags >= 0) break;
+            }
+        }
+    }
+    reportFooter(&config);
+    if (config._out != stdout) fclose(config._out);
+    free(baseline._results);
+    parallelShutdown();
+    if (failures > 0) return 2;
+    return regressions > 0 ? 1 : 0;
+}
@@ -1,7 +1,20 @@
 #ifndef T_LIST
 #define T_LIST
 
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
 
+/**
+ * @name Version
+ * Version 2 replaced the eleven method pointers of `struct Lista` with the
+ * shared `methods` table; see `TLIST_COMPAT_METHODS` in the README.
+ * @{
+ */
+#define TLIST_VERSION_MAJOR 2
+#define TLIST_VERSION_MINOR 0
+#define TLIST_VERSION_PATCH 0
+/** @} */
 
 /**
  * @enum Type
@@ -15,6 +28,24 @@ typedef enum Type{
     DOUBLE  /**< Double type. The list stores a copy of the value. */
 } Type;
 
+/**
+ * @enum ListFlag
+ * @brief Opt-in behaviours that can be combined (bitwise OR) when creating a list.
+ *
+ * See `newListWithFlags`. Lists created with `newList` use `LIST_DEFAULT`.
+ */
+typedef enum ListFlag{
+    LIST_DEFAULT = 0,       /**< Plain list: every node is allocated with `malloc` and released with `free`. */
+    LIST_SLAB    = 1 << 0,  /**< Nodes are carved from large blocks owned by the list and recycled through a free list. */
+    LIST_UNROLLED = 1 << 1, /**< Elements are stored in small contiguous chunks (an unrolled linked list) instead of one node each. */
+    LIST_VECTOR  = 1 << 2,  /**< Elements are stored in one growable contiguous array with O(1) indexed access. */
+    LIST_QUEUE   = 1 << 3,  /**< Lock-free FIFO: `push`, `pop`, `popInto`, `pushArray` and `len` may be called from any number of threads. */
+    LIST_SYNC    = 1 << 4,  /**< Every method takes a reader-writer lock, so the list can be shared between threads. */
+    LIST_DOUBLY  = 1 << 5,  /**< Nodes also link to their predecessor: O(1) `popBack` and `removeNode`, reverse iteration. */
+    LIST_ARENA   = 1 << 6,  /**< `STRING` values are bump-allocated in large blocks owned by the list and freed all at once. */
+    LIST_INTERN  = 1 << 7   /**< `STRING` values are stored once per distinct string, in the arena; implies `LIST_ARENA`. */
+} ListFlag;
+
 /**
  * @brief Opaque pointer to the list structure.
  */
@@ -25,28 +56,68 @@ typedef struct Lista *List;
  */
 typedef struct Node *Node;
 
+/**
+ * @brief Opaque pointer to the node pool used by `LIST_SLAB` lists.
+ */
+typedef struct NodePool *NodePool;
+
 /**
  * @brief Opaque pointer to the iterator structure.
  */
 typedef struct TIterator* TIterator;
 
 /**
- * @struct Lista
- * @brief Represents a generic singly linked list.
+ * @typedef Comparator
+ * @brief Orders two elements, given as returned by `get`; returns <0, 0 or >0 like `strcmp`.
+ */
+typedef int (*Comparator)(const void *a, const void *b);
+
+/**
+ * @typedef Hasher
+ * @brief Hashes an element, given as returned by `get`. Equal elements must hash alike.
+ */
+typedef size_t (*Hasher)(const void *value);
+
+/**
+ * @typedef Equality
+ * @brief Tells whether two elements, given as returned by `get`, are equal.
+ */
+typedef bool (*Equality)(const void *a, const void *b);
+
+/**
+ * @struct TAllocator
+ * @brief Memory functions of a list created with `newListWithAllocator`.
  *
- * This structure encapsulates the state of the list and provides function
- * pointers that act as methods for list manipulation. It's designed to be
- * an opaque type to the user, who should interact with it via the `List` pointer.
+ * `alloc` and `realloc` return `NULL` on failure, like `malloc`; the list
+ * then reports the error and exits, as it does when `malloc` fails.
+ * `realloc` also receives the current size of the block. `free` is never
+ * called with `NULL`. `context` is passed as the first argument of each
+ * function, for example a jemalloc arena index or a pool.
  */
-struct Lista{
-    /* List state */
-    Node _head;      /**< Pointer to the first node in the list. */
-    Node _tail;      /**< Pointer to the last node in the list. */
-    Type _type;      /**< The data type of the elements stored in the list. */
-    size_t _size;    /**< The size in bytes of the data type stored (for value types). */
-    int _length;     /**< The number of elements in the list. */
+typedef struct TAllocator{
+    void *(*alloc)(void *context, size_t size);
+    void *(*realloc)(void *context, void *ptr, size_t oldSize, size_t size);
+    void (*free)(void *context, void *ptr);
+    void *context;
+} TAllocator;
+
+/**
+ * @brief Opaque bump allocator handed out by `newRegion`.
+ */
+typedef struct TRegion TRegion;
 
-    /* Methods */
+/**
+ * @struct ListMethods
+ * @brief The methods of a list, shared by every list with the same storage backend and `Type`.
+ *
+ * Each list points at one of these constant tables through its `methods`
+ * field, so a method call reads `list->methods->push(list, 10)`. The
+ * `listPop`, `listGet`, ... wrappers below make the same calls. Code written
+ * for the `list->push(list, 10)` spelling of version 1 compiles when the
+ * library is built with `TLIST_COMPAT_METHODS`, at the cost of eleven
+ * pointers per list.
+ */
+struct ListMethods{
     /** @brief Adds an element to the end of the list. */
     void (*push)(List this, ...);
     /** @brief Removes and returns the first element of the list. */
@@ -69,6 +140,114 @@ struct Lista{
     void *(*pick)(List this, int index);
     /** @brief Applies a function to each element of the list. */
     void (*foreach)(List this, void(*function)(void* data));
+
+    /**
+     * @name Backend primitives
+     * Non-variadic primitives of the storage backend. Values are passed the
+     * way `pushArray` stores them: the address of the value for `INT`,
+     * `FLOAT` and `DOUBLE`, the pointer itself for `STRING` and `T`. The
+     * typed entry points (`pushInt`, `getDouble`, ...) call these directly,
+     * avoiding `va_arg` and the per-call switch on `_type`.
+     * @{
+     */
+    /** @brief Appends a value. */
+    void (*pushValue)(List this, void *val);
+    /** @brief Inserts a value at an index. */
+    void (*insertValue)(List this, int index, void *val);
+    /** @brief Replaces the value at an index. */
+    void (*setValue)(List this, int index, void *val);
+    /** @brief Removes the first element and writes it to `out`. See `popInto`. */
+    bool (*popValue)(List this, void *out);
+    /** @brief Inserts an array of values. See `insertArray`. */
+    void (*insertArray)(List this, int index, const void *values, size_t n);
+    /** @} */
+};
+
+/**
+ * @struct Lista
+ * @brief Represents a generic list, by default a singly linked list.
+ *
+ * This structure encapsulates the state of the list and points at the table
+ * of methods for list manipulation. It's designed to be an opaque type to
+ * the user, who should interact with it via the `List` pointer. The state of
+ * the storage backend (the `LIST_SLAB` node pool, or the store of an
+ * unrolled, vector or queue list) follows it in the same allocation.
+ */
+struct Lista{
+    /* List state */
+    Node _head;      /**< Pointer to the first node in the list. */
+    Node _tail;      /**< Pointer to the last node in the list. */
+    Node _cursor;    /**< Last node reached by an indexed operation, or `NULL`. */
+
+    /** @brief The list's methods and backend primitives. See `struct ListMethods`. */
+    const struct ListMethods *methods;
+
+    struct ListExtra *_extra;       /**< State few lists need: lock, sharing, arena, index, allocator, counters. */
+    int _length;     /**< The number of elements in the list. */
+    int _cursorIndex;/**< Index of `_cursor`. */
+    unsigned short _nodeSize;   /**< The size in bytes of one node, including its inline value storage. */
+    unsigned short _flags;      /**< The `ListFlag` options the list was created with. */
+    unsigned char _size;        /**< The size in bytes of the data type stored (for value types). */
+    unsigned char _type;        /**< The `Type` of the elements stored in the list. */
+
+#ifdef TLIST_COMPAT_METHODS
+    /**
+     * @name Migration shim
+     * Copies of the `methods` entries under their former member names, so
+     * that `l->push(l, x)` still compiles. Built with `TLIST_COMPAT_METHODS`.
+     * @{
+     */
+    void (*push)(List this, ...);
+    void *(*pop)(List this);
+    void (*print)(List this);
+    int (*len)(List this);
+    void (*free)(List this);
+    void *(*get)(List this, int index);
+    void (*set)(List this, int index, ...);
+    void (*remove)(List this, int index);
+    void (*insert)(List this, int index, ...);
+    void *(*pick)(List this, int index);
+    void (*foreach)(List this, void(*function)(void* data));
+    /** @} */
+#endif
+};
+
+/**
+ * @struct Node
+ * @brief A node of a linked list.
+ *
+ * `INT`, `FLOAT` and `DOUBLE` values, as well as short `STRING` values, are
+ * stored in `_data` at the end of the node, and `_val` points at them. Long
+ * strings live on the heap and `T` values are stored in `_val` directly, in
+ * which case `_data` is empty. The size of a node therefore depends on the
+ * list's type and is recorded in the list's `_nodeSize`.
+ *
+ * The layout is public only so that `TLIST_FOREACH` can walk nodes inline;
+ * the fields are not part of the API.
+ */
+struct Node{
+    void *_val;      /**< Pointer to the data stored in the node. */
+    Node _nextNode;  /**< Pointer to the next node in the list. */
+    _Alignas(double) unsigned char _data[];  /**< Inline value storage. */
+};
+
+/**
+ * @struct TIterator
+ * @brief Iteration state over a `List`.
+ *
+ * Obtained from `newIterator` (heap) or `iteratorOf` (by value, for use on
+ * the stack). The fields other than the methods are not part of the API.
+ */
+struct TIterator{
+    Node _current;                          /**< Pointer to the current node in the iteration. */
+    struct Chunk *_chunk;                   /**< Current chunk, for `LIST_UNROLLED` lists. */
+    int _offset;                            /**< Slot within `_chunk`, for `LIST_UNROLLED` lists. */
+    List _list;                             /**< Pointer to the list being iterated. */
+    int _index;                             /**< The index of the current element. */
+    bool _reverse;                          /**< Whether the iterator runs from the last element to the first. */
+    void* (*next)(struct TIterator*);       /**< Method to get the next element. */
+    bool (*hasNext)(struct TIterator*);     /**< Method to check if there is a next element. */
+    void (*free)(struct TIterator*);        /**< Method to free the iterator structure. */
 };
 
 /**
@@ -83,6 +262,750 @@ struct Lista{
  */
 List newList(Type type);
 
+/**
+ * @brief Creates a new empty list with the given `ListFlag` options.
+ *
+ * Behaves like `newList`, but lets the caller opt into alternative storage
+ * strategies. For example, `newListWithFlags(INT, LIST_SLAB)` creates a list
+ * whose nodes are carved from large blocks and recycled after `pop`, `remove`
+ * and `pick`, so steady-state queue churn does not go through `malloc` for
+ * nodes. The blocks are only returned to the system by the list's `free` method.
+ *
+ * `LIST_UNROLLED` selects a different storage backend behind the same methods:
+ * elements are packed into chunks of about two cache lines, which split and
+ * merge as elements are inserted and removed. `LIST_VECTOR` stores elements in
+ * a single array that grows geometrically, giving O(1) `get`/`set` and amortized
+ * O(1) `push` and `pop`.
+ *
+ * `LIST_QUEUE` turns the list into a lock-free FIFO that any number of
+ * producer and consumer threads can use at once through `push`, `pop`,
+ * `popInto`, `pushArray` and `len`. Under concurrent use `len` is approximate.
+ * Indexed methods report an error. `print`, `foreach`, iterators and `free`
+ * may only be used while no other thread is using the list. Whole-list
+ * operations such as `listSort` or `listSum` see the queue as empty.
+ *
+ * `LIST_DOUBLY` gives each linked node a link to its predecessor, stored
+ * in front of the node. `popBack` and `removeNode` become O(1), reverse
+ * iterators are available, and indexed methods walk from whichever of the
+ * head, the tail and the cursor is nearest.
+ *
+ * `LIST_SLAB` and `LIST_DOUBLY` have no effect on the other backends, and at
+ * most one of `LIST_UNROLLED`, `LIST_VECTOR` and `LIST_QUEUE` may be given.
+ *
+ * `LIST_ARENA` copies the strings of a `STRING` list into large blocks owned
+ * by the list instead of one `malloc` each, and linked nodes no longer
+ * reserve room for short strings. A string that is removed or replaced keeps
+ * its bytes until the list's `free` method releases the blocks. `pop` and
+ * `pick` return a `malloc` copy, as for other lists. With `LIST_INTERN`,
+ * equal strings share a single stored copy found through a hash table, so
+ * `listIndexOf` and `listCountOf` compare pointers, and `internedString` maps a
+ * string to its stored copy. The stored strings must not be modified in
+ * place. Both flags are ignored for other types and for `LIST_QUEUE` lists.
+ *
+ * `LIST_SYNC` can be added to any backend except `LIST_QUEUE`. Each method
+ * then takes the list's reader-writer lock: `get`, `len`, `print`,
+ * `foreach` and the read-only free functions (`listSum`, `listIndexOf`, ...) in
+ * shared mode, and all others exclusively. Readers never block each other.
+ * Pointers returned by `get` are only stable while the caller holds the
+ * lock; see `listLock` and `snapshot`. Linked `LIST_SYNC` lists do not use
+ * the positional cursor, since readers must not modify the list. The `free`
+ * method also destroys the lock when the calling thread releases it, after
+ * which no thread may use the list.
+ *
+ * @param type The data type the list will hold. See the `Type` enum.
+ * @param flags A bitwise OR of `ListFlag` values.
+ * @return A pointer to the newly created list, or `NULL` if `flags` is invalid.
+ */
+List newListWithFlags(Type type, int flags);
+
+/**
+ * @brief Creates a new empty list whose memory comes from `allocator`.
+ *
+ * Nodes, heap strings, the iterators of `newIterator`, the sharing state of
+ * `duplicate`, the hash index of `indexList` and the scratch buffers of
+ * `listSort` and `spliceRange` all go through the allocator. So do the lists
+ * derived from this one: duplicates, snapshots, `splitAt` tails and
+ * `parallelMap` results. The `struct Lista` itself still comes from
+ * `malloc`, so it is released with `free(list)` as usual, and `pop` and
+ * `pick` keep returning `malloc` copies for the caller to `free`.
+ *
+ * `allocator` is not copied: it must outlive the list and every list
+ * derived from it.
+ *
+ * With `regionAllocator`, a list needs no cleanup beyond `free(list)`: its
+ * storage goes away with `freeRegion` or `resetRegion`, in time independent
+ * of the number of elements, and the list's `free` method may be skipped.
+ *
+ * @param type The data type the list will hold. See the `Type` enum.
+ * @param allocator The memory functions to use. `NULL` selects `malloc`.
+ * @return A pointer to the newly created list.
+ */
+List newListWithAllocator(Type type, const TAllocator *allocator);
+
+/**
+ * @brief Creates a new empty list with the given storage flags whose memory comes from `allocator`.
+ *
+ * Combines `newListWithFlags` and `newListWithAllocator`: slab blocks,
+ * unrolled chunks, vector buffers, string arenas and the `LIST_SYNC` lock
+ * state all go through the allocator as well. `LIST_QUEUE` cannot be used
+ * with an allocator, since its retired nodes are freed by whichever thread
+ * reclaims them, possibly after the list is gone; the call then prints an
+ * error and returns `NULL`.
+ *
+ * @param type The data type the list will hold. See the `Type` enum.
+ * @param flags A combination of the `ListFlag` values, as for `newListWithFlags`.
+ * @param allocator The memory functions to use. `NULL` selects `malloc`.
+ * @return A pointer to the newly created list, or `NULL` on invalid arguments.
+ */
+List newListWithFlagsAndAllocator(Type type, int flags, const TAllocator *allocator);
+
+/**
+ * @brief Creates a region that hands out memory by bumping a pointer through large blocks.
+ *
+ * Freeing a block only reclaims it if it was the last one handed out;
+ * everything else is released at once by `resetRegion` or `freeRegion`.
+ * A region is not thread-safe: the lists using it must not be modified by
+ * several threads at once.
+ *
+ * @param blockSize The size of each block, 0 for the default (64 KiB).
+ *        Larger requests get a block of their own.
+ * @return The new region.
+ */
+TRegion *newRegion(size_t blockSize);
+
+/**
+ * @brief Returns the `TAllocator` that allocates from `region`, for `newListWithAllocator`.
+ *
+ * The allocator lives inside the region and stays valid until `freeRegion`.
+ */
+const TAllocator *regionAllocator(TRegion *region);
+
+/**
+ * @brief Releases everything allocated from the region and keeps its first block for reuse.
+ *
+ * The lists using the region must not be used again, except to `free` their `struct Lista`.
+ */
+void resetRegion(TRegion *region);
+
+/**
+ * @brief Releases the region and everything allocated from it.
+ *
+ * The lists using the region must not be used again, except to `free` their `struct Lista`.
+ */
+void freeRegion(TRegion *region);
+
+/**
+ * @brief Appends `n` elements from a C array to the end of the list.
+ *
+ * `values` points to an array laid out according to the list's type: `int[]`
+ * for `INT`, `float[]` for `FLOAT`, `double[]` for `DOUBLE`, `char*[]` for
+ * `STRING` (each string is copied) and `void*[]` for `T`. The new elements are
+ * built in one pass and linked into the list at once. On `LIST_SLAB` lists,
+ * nodes for the whole batch are carved from at most one new block.
+ *
+ * @param list The list to append to.
+ * @param values The array of values.
+ * @param n The number of values in the array.
+ */
+void pushArray(List list, const void *values, size_t n);
+
+/**
+ * @brief Inserts `n` elements from a C array so that the first one ends up at `index`.
+ *
+ * See `pushArray` for the layout of `values`. The insertion point is located
+ * once, whatever the number of elements.
+ *
+ * @param list The list to insert into.
+ * @param index The zero-based index at which to insert the elements (0 to `len`).
+ * @param values The array of values.
+ * @param n The number of values in the array.
+ */
+void insertArray(List list, int index, const void *values, size_t n);
+
+/**
+ * @brief Reports how often indexed lookups reused the list's cursor.
+ *
+ * Linked lists remember the last node reached by `get`, `set`, `insert`,
+ * `remove` or `pick`. A lookup at or after that position resumes from it (a
+ * hit); any other lookup walks from the head (a miss). Ascending index loops
+ * should therefore show almost only hits. Other backends do not use the cursor.
+ *
+ * The counters are kept by the instrumentation build (`TLIST_STATS`), so that
+ * lookups in other builds never write outside the list; there both are 0.
+ *
+ * @param list The list to inspect.
+ * @param hits Receives the number of hits. May be `NULL`.
+ * @param misses Receives the number of misses. May be `NULL`.
+ */
+void cursorStats(List list, size_t *hits, size_t *misses);
+
+/**
+ * @enum ListOp
+ * @brief The operations counted by the instrumentation build (`TLIST_STATS`).
+ *
+ * Each method of `struct ListMethods` has its own entry; `pushArray` and
+ * `insertArray` share `LIST_OP_ARRAY`. Entry points that go through the
+ * backend primitives (`popInto`, the typed `push*`/`insert*`/`set*` functions)
+ * are counted with the method they stand for.
+ */
+typedef enum ListOp{
+    LIST_OP_PUSH,
+    LIST_OP_POP,
+    LIST_OP_PRINT,
+    LIST_OP_LEN,
+    LIST_OP_FREE,
+    LIST_OP_GET,
+    LIST_OP_SET,
+    LIST_OP_REMOVE,
+    LIST_OP_INSERT,
+    LIST_OP_PICK,
+    LIST_OP_FOREACH,
+    LIST_OP_ARRAY,
+    LIST_OP_COUNT   /**< Number of operations, not an operation. */
+} ListOp;
+
+/**
+ * @brief Number of latency buckets per operation.
+ *
+ * Bucket `i` counts calls that took from `2^i` to `2^(i+1) - 1` nanoseconds;
+ * the first bucket also counts calls under one nanosecond and the last one
+ * every call longer than its lower bound (about 4 ms).
+ */
+#define TLIST_LATENCY_BUCKETS 23
+
+/**
+ * @struct ListStats
+ * @brief Counters recorded by the instrumentation build, for one list or for all of them.
+ *
+ * Memory counters cover the storage of the elements: nodes, `LIST_SLAB`
+ * blocks, unrolled chunks and vector arrays count as node bytes; heap
+ * strings and `LIST_ARENA` blocks as value bytes. Copies handed to the caller
+ * by `pop` and `pick` count as mallocs, and their bytes leave the list. The
+ * byte counts of a list follow its storage when `duplicate` shares it; they
+ * are not moved by `listConcat`, `splitAt` and `spliceRange`.
+ */
+typedef struct ListStats{
+    size_t calls[LIST_OP_COUNT];                            /**< Calls per operation. */
+    size_t latency[LIST_OP_COUNT][TLIST_LATENCY_BUCKETS];   /**< Calls per latency bucket, recorded while `statsTiming` is on. */
+    size_t nodesTraversed;  /**< Nodes (or unrolled chunks) walked past to reach an index. */
+    size_t mallocs;         /**< Allocations made for nodes and values, reallocations included. */
+    size_t frees;           /**< Node and value allocations released, including the blocks replaced by a reallocation. */
+    long long nodeBytes;    /**< Bytes currently held by nodes and element arrays. */
+    long long valueBytes;   /**< Bytes currently held by out-of-node values. */
+} ListStats;
+
+/**
+ * @brief Reads the counters of one list.
+ *
+ * Only available when the library is built with `TLIST_STATS` (CMake option
+ * of the same name); otherwise `out` is zeroed and `false` is returned.
+ * @param list The list to inspect.
+ * @param out Receives the counters.
+ * @return `true` if counters were read.
+ */
+bool listStats(List list, ListStats *out);
+
+/**
+ * @brief Reads the counters summed over every list, including freed ones.
+ * @param out Receives the counters.
+ * @return `true` if counters were read, `false` without `TLIST_STATS`.
+ */
+bool globalStats(ListStats *out);
+
+/**
+ * @brief Zeroes the call, latency, traversal and allocation counters of a list, or the global ones if `list` is `NULL`.
+ *
+ * The byte counts describe memory currently held and are kept.
+ */
+void resetStats(List list);
+
+/**
+ * @brief Turns latency recording on or off for every list. Off by default.
+ *
+ * Timing reads the monotonic clock twice per call, which costs more than
+ * most operations; call counts are always recorded.
+ */
+void statsTiming(bool enabled);
+
+/**
+ * @brief Writes the global counters to `out` as readable text.
+ *
+ * Operations that were never called are omitted, and each latency
+ * histogram lists its non-empty buckets only.
+ */
+void dumpStats(FILE *out);
+
+/**
+ * @brief Ensures that a `LIST_VECTOR` list can hold `capacity` elements without reallocating.
+ *
+ * Has no effect on lists using other storage backends.
+ *
+ * @param list The list to grow.
+ * @param capacity The number of elements the list should be able to hold.
+ */
+void listReserve(List list, int capacity);
+
+/**
+ * @brief Removes the first element of the list and writes its value to `out`.
+ *
+ * Unlike `pop`, this does not return a heap pointer, so value types need no
+ * allocation. What is written to `out` depends on the list's type:
+ * - `INT`, `FLOAT`, `DOUBLE`: the value itself (`out` points to an `int`, `float` or `double`).
+ * - `STRING`: a `char*` the caller must `free` (`out` points to a `char*`).
+ * - `T`: the stored pointer (`out` points to a `void*`).
+ *
+ * @param list The list to pop from.
+ * @param out Where to store the removed value.
+ * @return `true` if an element was removed, `false` if the list was empty or invalid.
+ */
+bool popInto(List list, void *out);
+
+/**
+ * @brief Adds an element to the front of the list.
+ *
+ * Takes the same variadic argument as `push`. Not supported by `LIST_QUEUE` lists.
+ *
+ * @param list The list to add to.
+ */
+void pushFront(List list, ...);
+
+/**
+ * @brief Removes and returns the last element of the list.
+ *
+ * Ownership of the result is as for `pop`. This is O(1) for `LIST_DOUBLY`
+ * and `LIST_VECTOR` lists; singly linked lists walk to the second-to-last
+ * node. Not supported by `LIST_QUEUE` lists.
+ *
+ * @param list The list to pop from.
+ * @return The removed value, or `NULL` if the list is empty.
+ */
+void *popBack(List list);
+
+/**
+ * @brief Returns a handle to the node at `index` of a linked list.
+ *
+ * The handle stays valid until its element is removed, and can be passed to
+ * `nodeValue` and `removeNode`. Handles are invalidated when the list is
+ * modified after a `duplicate` or `snapshot`, which gives it new storage.
+ * Lists using other storage backends have no nodes.
+ *
+ * @param list A list without `LIST_UNROLLED`, `LIST_VECTOR` or `LIST_QUEUE`.
+ * @param index The zero-based index of the node.
+ * @return The node, or `NULL` if the index is out of bounds or the list has no nodes.
+ */
+Node nodeAt(List list, int index);
+
+/**
+ * @brief Returns the value of a node, in the form `get` returns it.
+ *
+ * @param node A handle from `nodeAt`.
+ * @return The node's value, or `NULL` if `node` is `NULL`.
+ */
+void *nodeValue(Node node);
+
+/**
+ * @brief Removes the element held by a node in O(1), without searching for it.
+ *
+ * Only `LIST_DOUBLY` lists know the predecessor of a node. The node must
+ * belong to `list`; the handle is invalid afterwards.
+ *
+ * @param list A `LIST_DOUBLY` list.
+ * @param node A handle from `nodeAt` on the same list.
+ */
+void removeNode(List list, Node node);
+
+/**
+ * @brief Returns the sum of the elements of an `INT`, `FLOAT` or `DOUBLE` list.
+ *
+ * `INT` elements are summed in 64-bit integers, so the result does not
+ * overflow for any list that fits in memory. An empty list sums to 0.
+ *
+ * @param list The list to reduce.
+ * @return The sum, or 0 after printing an error if the list is not numeric.
+ */
+double listSum(List list);
+
+/**
+ * @brief Returns the arithmetic mean of the elements of a numeric list.
+ * @return The mean, or 0 after printing an error if the list is empty or not numeric.
+ */
+double listMean(List list);
+
+/**
+ * @brief Returns the smallest element of a numeric list.
+ * @return The minimum, or 0 after printing an error if the list is empty or not numeric.
+ */
+double listMin(List list);
+
+/**
+ * @brief Returns the largest element of a numeric list.
+ * @return The maximum, or 0 after printing an error if the list is empty or not numeric.
+ */
+double listMax(List list);
+
+/**
+ * @brief Finds the first element equal to the given value.
+ *
+ * The value is passed like in `push`. Strings are compared with `strcmp`,
+ * except in `LIST_INTERN` lists, where the value is looked up once and
+ * elements are compared by pointer. Elements of a `T` list are compared by pointer.
+ * Lists indexed with `indexList` compare elements with the index's equality,
+ * and return -1 without scanning when the value is absent.
+ *
+ * @param list The list to search.
+ * @param ... The value to look for.
+ * @return The index of the first match, or -1 if there is none.
+ */
+int listIndexOf(List list, ...);
+
+/**
+ * @brief Counts the elements equal to the given value (compared as in `listIndexOf`).
+ *
+ * On lists indexed with `indexList`, the cost is proportional to the number
+ * of matches rather than to the length of the list.
+ * @return The number of matches.
+ */
+int listCountOf(List list, ...);
+
+/**
+ * @brief Tells whether the list holds an element equal to the given value (compared as in `listIndexOf`).
+ *
+ * O(1) on average on lists indexed with `indexList`, a scan otherwise.
+ */
+bool listContains(List list, ...);
+
+/**
+ * @brief Removes the first element equal to the given value (compared as in `listIndexOf`).
+ *
+ * Strings are freed as by `remove`. On an indexed `LIST_DOUBLY` list holding
+ * the value once, the element is unlinked without walking the list.
+ * Not supported by `LIST_QUEUE` lists.
+ * @return `true` if an element was removed.
+ */
+bool removeValue(List list, ...);
+
+/**
+ * @brief Removes every element equal to the given value (compared as in `listIndexOf`).
+ *
+ * Runs in a single pass over the list; on an indexed `LIST_DOUBLY` list the
+ * matches are unlinked directly, in time proportional to their number.
+ * Not supported by `LIST_QUEUE` lists.
+ * @return The number of elements removed.
+ */
+int removeAll(List list, ...);
+
+/**
+ * @brief Attaches a hash index to a linked list, for fast value lookups.
+ *
+ * The index maps each value to the nodes holding it and is kept up to date
+ * by every operation that modifies the list, at the cost of one hash table
+ * entry (two words) per element and a hash on each insertion and removal.
+ * `listContains` and `listCountOf` then take time proportional to the number of
+ * matches, `listIndexOf` and `removeValue` fail fast on absent values, and
+ * `removeValue` and `removeAll` unlink matches directly on `LIST_DOUBLY`
+ * lists. Duplicates, snapshots and spliced elements of the list are not
+ * indexed; `free` drops the index.
+ *
+ * By default values are compared as in `listIndexOf` (NaN matches nothing, and
+ * `0.0` equals `-0.0`). `T` lists need both a hash and an equality, which
+ * then also define equality for `listIndexOf`, `listCountOf` and `removeValue`.
+ * Calling `indexList` again rebuilds the index with the new functions.
+ *
+ * @param list A linked list: not `LIST_UNROLLED`, `LIST_VECTOR` or `LIST_QUEUE`.
+ * @param hash The hash of an element, or `NULL` for the natural one of the list's type.
+ * @param equals The matching equality, or `NULL` if `hash` is `NULL`.
+ * @return `true` on success, `false` after printing an error.
+ */
+bool indexList(List list, Hasher hash, Equality equals);
+
+/**
+ * @brief Removes the hash index built by `indexList`, if any.
+ */
+void dropIndex(List list);
+
+/**
+ * @brief Returns the stored copy of a string in a `LIST_INTERN` list.
+ *
+ * Every element equal to `string` is this same pointer, so the result can be
+ * compared with `==` against the values returned by `get` and iterators.
+ *
+ * @param list A `STRING` list created with `LIST_INTERN`.
+ * @param string The string to look up.
+ * @return The stored copy, or `NULL` if no element was ever equal to `string`.
+ */
+const char *internedString(List list, const char *string);
+
+/**
+ * @brief Names the kernels used by the reductions and searches on this CPU.
+ * @return `"avx2"`, `"sse2"` or `"scalar"`.
+ */
+const char *simdLevel(void);
+
+/**
+ * @brief Sorts the list in place, keeping equal elements in their original order.
+ *
+ * The comparator receives elements as returned by `get`: pointers to the
+ * value for `INT`, `FLOAT` and `DOUBLE`, the string for `STRING` and the
+ * stored pointer for `T`. Passing `NULL` selects the natural order of the
+ * list's type (`compareInt`, `compareFloat`, `compareDouble` or
+ * `compareString`); `T` lists need an explicit comparator.
+ *
+ * Linked lists are sorted by relinking their nodes, so no value is copied.
+ * Long `INT` and `FLOAT` lists sorted in their natural order use a radix
+ * sort that rewrites the values instead; there, -0.0 sorts before 0.0 and
+ * NaNs are placed at the ends.
+ *
+ * @param list The list to sort.
+ * @param cmp The comparator, or `NULL` for the natural order.
+ */
+void listSort(List list, Comparator cmp);
+
+/** @brief Natural order of `INT` elements. */
+int compareInt(const void *a, const void *b);
+
+/** @brief Natural order of `FLOAT` elements. */
+int compareFloat(const void *a, const void *b);
+
+/** @brief Natural order of `DOUBLE` elements. */
+int compareDouble(const void *a, const void *b);
+
+/** @brief Lexicographic order of `STRING` elements (`strcmp`). */
+int compareString(const void *a, const void *b);
+
+/**
+ * @brief Calls `function` on every element, spread over several threads.
+ *
+ * The list is split into runs of consecutive elements which are processed
+ * by a shared worker pool and the calling thread; idle threads take over
+ * work from busy ones. Elements are passed as returned by `get`. The order
+ * of the calls is unspecified, and the list must not be modified until the
+ * call returns.
+ *
+ * @param list The list to process.
+ * @param function The function to apply; it must be safe to call concurrently.
+ * @param nthreads The number of threads to use, counting the caller; 0 or less uses one per online CPU.
+ */
+void parallelForeach(List list, void (*function)(void *), int nthreads);
+
+/**
+ * @brief Builds a new list from the results of `function` on every element, computed in parallel.
+ *
+ * `function` receives each element as returned by `get` and writes its
+ * result to `out`, laid out like one `pushArray` element of `type`: the value
+ * for `INT`, `FLOAT` and `DOUBLE`, a pointer for `T`, and a `malloc`ed string
+ * for `STRING`, which is freed once copied into the new list. The results
+ * keep the order of the source elements. The new list uses the same flags as
+ * `list`.
+ *
+ * @param list The list to map.
+ * @param type The type of the new list.
+ * @param function The mapping function; it must be safe to call concurrently.
+ * @param nthreads As for `parallelForeach`.
+ * @return The new list, or `NULL` on invalid arguments.
+ */
+List parallelMap(List list, Type type, void (*function)(void *val, void *out), int nthreads);
+
+/**
+ * @brief Stops and joins the worker threads used by `parallelForeach` and `parallelMap`.
+ *
+ * The pool is created again on the next parallel call.
+ */
+void parallelShutdown(void);
+
+/**
+ * @brief Acquires the lock of a `LIST_SYNC` list for a batch of operations.
+ *
+ * While the lock is held, the list's methods called from the same thread run
+ * under this acquisition without locking again. With `exclusive` set, other
+ * threads are kept out entirely; otherwise only writers are, and the holder
+ * may only read. Iterating a shared list is safe while its lock is held.
+ * Calls nest and must be balanced by `listUnlock`. Lists without `LIST_SYNC`
+ * are not locked.
+ *
+ * @param list The list to lock.
+ * @param exclusive `true` for a write lock, `false` for a read lock.
+ * @return `false` if the lock could not be taken (for example, a write lock
+ *         requested while this thread holds a read lock).
+ */
+bool listLock(List list, bool exclusive);
+
+/**
+ * @brief Releases one acquisition made by `listLock`.
+ * @param list The list to unlock.
+ */
+void listUnlock(List list);
+
+/**
+ * @brief Copies the list in O(1), for use by another thread.
+ *
+ * The copy has the same type and flags, except `LIST_SYNC`, and belongs to
+ * the caller, so it can be iterated or indexed freely while other threads
+ * keep modifying the original. Like `duplicate`, it shares the original's
+ * storage until either list is modified; the write lock is held only while
+ * the sharing is set up. A caller that holds the read lock gets an element
+ * by element copy instead.
+ *
+ * @param list The list to copy.
+ * @return The copy, or `NULL` if `list` is `NULL` or cannot be locked.
+ */
+List snapshot(List list);
+
+/**
+ * @brief Returns a copy of the list with the same type and flags.
+ *
+ * The copy is made in O(1): both lists share the nodes, chunks or array
+ * until one of them is modified, at which point that list copies the
+ * elements for itself (copy-on-write). Until then, elements must not be
+ * modified through pointers obtained from `get`, `foreach` or iterators.
+ * `T` elements are copied by pointer. `LIST_QUEUE` lists are copied element
+ * by element.
+ *
+ * The caller frees the copy with `listDestroy(list)` and then `free(list)`.
+ *
+ * @param list The list to copy.
+ * @return The copy, or `NULL` if `list` is `NULL` or cannot be locked.
+ */
+List duplicate(List list);
+
+/**
+ * @brief Writes the list to a file descriptor as a binary image.
+ *
+ * The image holds the list's `Type` and length, then the values packed (for
+ * `INT`, `FLOAT` and `DOUBLE`) or a length-prefixed string table (for
+ * `STRING`). It is versioned and uses the writing machine's byte order.
+ * Lists of type `T` cannot be saved.
+ *
+ * @param list The list to write.
+ * @param fd A file descriptor open for writing, such as a file or a pipe.
+ * @return `true` if the whole image was written.
+ */
+bool writeList(List list, int fd);
+
+/**
+ * @brief Saves the list to a file as a binary image; see `writeList`.
+ *
+ * @param list The list to save.
+ * @param path The file to create or overwrite.
+ * @return `true` if the image was written and the file closed successfully.
+ */
+bool saveList(List list, const char *path);
+
+/**
+ * @brief Reads an image written by `writeList` and rebuilds the list.
+ *
+ * @param fd A file descriptor positioned at the start of the image.
+ * @param flags The `ListFlag` options of the new list.
+ * @return The new list, or `NULL` if the image is invalid or cannot be read.
+ */
+List readList(int fd, int flags);
+
+/**
+ * @brief Loads a list saved by `saveList`; see `readList`.
+ *
+ * @param path The image file.
+ * @param flags The `ListFlag` options of the new list.
+ * @return The new list, or `NULL` if the file is not a valid image.
+ */
+List loadList(const char *path, int flags);
+
+/**
+ * @brief Maps an image saved by `saveList` and returns a list that reads it in place.
+ *
+ * The result is a `LIST_VECTOR` list whose elements are the mapped values,
+ * so opening even a large image takes constant time for numeric types.
+ * `STRING` images need one pass to build an array of pointers into the
+ * mapping, but no string is copied. `get`, `foreach`, iterators and the
+ * reductions read the mapping directly. The first modification copies
+ * every element into memory, as for a `duplicate`. The file is unmapped when
+ * the list is freed or copied.
+ *
+ * @param path The image file.
+ * @return The list, or `NULL` if the file cannot be mapped or is not a valid image.
+ */
+List mmapList(const char *path);
+
+/**
+ * @brief Parses integers from a file descriptor and appends them to an `INT` list.
+ *
+ * Fields are separated by `delim` or by newlines, and blanks around them are
+ * ignored, as are empty fields. The input is read until end of file in large
+ * blocks, and values are appended in batches, so memory use does not grow
+ * with the input.
+ *
+ * A field that is not an integer, or does not fit in an `int`, is reported
+ * with its line and column. Reading stops there, and the values before it
+ * remain appended.
+ *
+ * @param list The list to append to.
+ * @param fd A file descriptor open for reading, such as a file or a pipe.
+ * @param delim The field separator, for example `','` or `'\n'`.
+ * @return `true` if the whole input was read and parsed.
+ */
+bool readInts(List list, int fd, char delim);
+
+/**
+ * @brief Parses decimal numbers from a file descriptor and appends them to a `DOUBLE` or `FLOAT` list.
+ *
+ * Accepts what `strtod` accepts; fields are split as for `readInts`.
+ * `FLOAT` values are rounded once, as by `strtof`, and a value too large
+ * for the list's type is reported like a malformed field.
+ *
+ * @param list The list to append to.
+ * @param fd A file descriptor open for reading.
+ * @param delim The field separator.
+ * @return `true` if the whole input was read and parsed.
+ */
+bool readDoubles(List list, int fd, char delim);
+
+/**
+ * @brief Appends each line read from a file descriptor to a `STRING` list.
+ *
+ * Lines are stored without their `'\n'` or `"\r\n"` terminator. Empty lines
+ * are kept, and a final line without a terminator is appended as well.
+ *
+ * @param list The list to append to.
+ * @param fd A file descriptor open for reading.
+ * @return `true` if the whole input was read.
+ */
+bool readLines(List list, int fd);
+
+/**
+ * @brief Moves every element of `src` to the end of `dst`, leaving `src` empty.
+ *
+ * For two linked lists this relinks `src`'s nodes onto `dst`'s tail in O(1)
+ * apart from locating the ends; see `spliceRange` for the other backends.
+ *
+ * @param dst The list to append to.
+ * @param src The list to empty. Must have the same `Type` and not be `dst`.
+ */
+void listConcat(List dst, List src);
+
+/**
+ * @brief Splits the list at `index`, moving elements `index..len-1` into a new list.
+ *
+ * @param list The list to split; keeps elements `0..index-1`.
+ * @param index The first index to move, from 0 to the list's length.
+ * @return A new list with the same type and flags, or `NULL` on error.
+ */
+List splitAt(List list, int index);
+
+/**
+ * @brief Moves elements `[from, to)` of `src` to index `pos` of `dst`.
+ *
+ * Lists with the same backend exchange their storage without allocating per
+ * element or copying values: linked nodes are relinked, unrolled chunks are
+ * split at the range ends and relinked, and vector slots move in one block.
+ * `LIST_SLAB` lists and lists with different storage flags (backend or
+ * `LIST_DOUBLY`) copy the range instead. `LIST_QUEUE` lists are not supported.
+ *
+ * @param dst The list to insert into.
+ * @param pos The index in `dst` before which the range is inserted.
+ * @param src The list to take the range from. Must have the same `Type` and not be `dst`.
+ * @param from The first index of the range.
+ * @param to One past the last index of the range.
+ */
+void spliceRange(List dst, int pos, List src, int from, int to);
+
 /**
  * @brief Runs a series of tests on the list implementation.
  *
@@ -105,4 +1028,280 @@ void test();
  */
 TIterator newIterator(List list);
 
+/**
+ * @brief Returns an iterator over the list by value, without allocating.
+ *
+ * Use it on the stack: `struct TIterator it = iteratorOf(list);` and pass
+ * `&it` wherever a `TIterator` is expected. Its `free` method does nothing.
+ *
+ * @param list The list to iterate over. Must not be NULL.
+ * @return An iterator positioned at the first element.
+ */
+struct TIterator iteratorOf(List list);
+
+/**
+ * @brief Advances the iterator by up to `max` elements, storing them in `out`.
+ *
+ * Elements are stored as `next` returns them. The whole batch is gathered in
+ * one call with no indirect call per element, and running out of elements is
+ * not an error.
+ *
+ * @param iterator The iterator to advance.
+ * @param out Receives up to `max` element pointers.
+ * @param max Capacity of `out`.
+ * @return The number of elements stored; 0 once the iteration is complete.
+ */
+size_t nextBatch(TIterator iterator, void **out, size_t max);
+
+/**
+ * @brief Creates an iterator that runs from the last element to the first.
+ *
+ * Supported by `LIST_DOUBLY` and `LIST_VECTOR` lists; for other lists an
+ * error is printed and the iterator is empty. Free it like `newIterator`'s.
+ *
+ * @param list The list to iterate over.
+ * @return A pointer to the newly created iterator.
+ */
+TIterator newReverseIterator(List list);
+
+/**
+ * @brief Returns a reverse iterator by value, without allocating. See `iteratorOf`.
+ *
+ * @param list The list to iterate over. Must not be NULL.
+ * @return An iterator positioned at the last element.
+ */
+struct TIterator reverseIteratorOf(List list);
+
+/**
+ * @brief Advances a `TLIST_FOREACH` iteration, or any other iterator, by one element.
+ *
+ * Forward walks of linked lists are inline; the other backends and reverse
+ * iterators go through `nextBatch`.
+ * @return `false` once the iteration is complete.
+ */
+static inline bool iteratorStep(TIterator iterator, void **val){
+    if (iterator->_current != NULL && !iterator->_reverse) {
+        *val = iterator->_current->_val;
+        iterator->_current = iterator->_current->_nextNode;
+        return true;
+    }
+    if (!iterator->_reverse && !(iterator->_list->_flags & (LIST_UNROLLED | LIST_VECTOR))) return false;
+    return nextBatch(iterator, val, 1) == 1;
+}
+
+/** @brief Helpers that give each `TLIST_FOREACH` its own iterator name. */
+#define TLIST_CONCAT_(a, b) a##b
+#define TLIST_CONCAT(a, b) TLIST_CONCAT_(a, b)
+
+/**
+ * @def TLIST_FOREACH
+ * @brief Loops over the elements of `list`, binding each to `void *var`.
+ *
+ * Elements are passed as `get` returns them. The iterator lives on the stack,
+ * and for linked lists each step is a plain pointer walk. `break` and
+ * `continue` behave as in an ordinary loop. The list must not be modified
+ * during the loop.
+ *
+ * ```c
+ * TLIST_FOREACH(list, val) {
+ *     total += *(int *)val;
+ * }
+ * ```
+ */
+#define TLIST_FOREACH(list, var) \
+    for (struct TIterator TLIST_CONCAT(tlistIterator, __LINE__) = iteratorOf(list); \
+         TLIST_CONCAT(tlistIterator, __LINE__)._list != NULL; \
+         TLIST_CONCAT(tlistIterator, __LINE__)._list = NULL) \
+        for (void *var; iteratorStep(&TLIST_CONCAT(tlistIterator, __LINE__), &var);)
+
+/**
+ * @brief Reports a typed entry point called on a list of another type (or a `NULL` list).
+ *
+ * Called by the typed entry points below when the list's type does not match.
+ * @return `true` if the list is usable with `expected`, `false` after printing an error.
+ */
+bool checkType(List list, Type expected, const char *function);
+
+/**
+ * @def TLIST_CHECK
+ * @brief Validates the list passed to a typed entry point.
+ *
+ * Release builds (`NDEBUG`) skip the `NULL` test but keep the `_type`
+ * compare, so `listPush(l, 1)` on a `DOUBLE` list is still refused rather
+ * than storing an `int` in a `double` slot. The compare reads a field next
+ * to the method table the call loads anyway.
+ */
+#ifdef NDEBUG
+#define TLIST_CHECK(list, type, function) \
+    ((list)->_type == (type) || checkType((list), (type), (function)))
+#else
+#define TLIST_CHECK(list, type, function) \
+    (((list) != NULL && (list)->_type == (type)) || checkType((list), (type), (function)))
+#endif
+
+/**
+ * @name Method wrappers
+ * Shorthands for the calls through `list->methods`: `listGet(l, 2)` is
+ * `l->methods->get(l, 2)`. `listDestroy` calls the `free` method, which
+ * empties the list but leaves the `struct Lista` to `free(list)`. The
+ * variadic `push`, `set` and `insert` are reached through `methods`, or
+ * with the typed entry points and `listPush`, `listInsert` and `listSet`.
+ * @{
+ */
+static inline void *listPop(List list){ return list->methods->pop(list); }
+static inline void listPrint(List list){ list->methods->print(list); }
+static inline int listLen(List list){ return list->methods->len(list); }
+static inline void listDestroy(List list){ list->methods->free(list); }
+static inline void *listGet(List list, int index){ return list->methods->get(list, index); }
+static inline void listRemove(List list, int index){ list->methods->remove(list, index); }
+static inline void *listPick(List list, int index){ return list->methods->pick(list, index); }
+static inline void listForeach(List list, void (*function)(void *data)){ list->methods->foreach(list, function); }
+/** @} */
+
+/**
+ * @name Typed entry points
+ * Non-variadic counterparts of `push`, `insert`, `set`, `get` and `pop` for
+ * each `Type`. They take and return values directly: `FLOAT` values are not
+ * promoted to `double`, the compiler checks argument types, and the calls can
+ * be inlined. Getters return 0 (or `NULL`) when the index is out of bounds,
+ * and pops return 0 (or `NULL`) when the list is empty.
+ * `getString` returns the list's own copy, valid until the element is
+ * modified or removed; `popString` returns a string the caller must `free`.
+ * @{
+ */
+static inline void pushInt(List list, int value){
+    if (!TLIST_CHECK(list, INT, "pushInt")) return;
+    list->methods->pushValue(list, &value);
+}
+static inline void pushFloat(List list, float value){
+    if (!TLIST_CHECK(list, FLOAT, "pushFloat")) return;
+    list->methods->pushValue(list, &value);
+}
+static inline void pushDouble(List list, double value){
+    if (!TLIST_CHECK(list, DOUBLE, "pushDouble")) return;
+    list->methods->pushValue(list, &value);
+}
+static inline void pushString(List list, const char *value){
+    if (!TLIST_CHECK(list, STRING, "pushString")) return;
+    list->methods->pushValue(list, (void *)value);
+}
+static inline void pushPtr(List list, void *value){
+    if (!TLIST_CHECK(list, T, "pushPtr")) return;
+    list->methods->pushValue(list, value);
+}
+
+static inline void insertInt(List list, int index, int value){
+    if (!TLIST_CHECK(list, INT, "insertInt")) return;
+    list->methods->insertValue(list, index, &value);
+}
+static inline void insertFloat(List list, int index, float value){
+    if (!TLIST_CHECK(list, FLOAT, "insertFloat")) return;
+    list->methods->insertValue(list, index, &value);
+}
+static inline void insertDouble(List list, int index, double value){
+    if (!TLIST_CHECK(list, DOUBLE, "insertDouble")) return;
+    list->methods->insertValue(list, index, &value);
+}
+static inline void insertString(List list, int index, const char *value){
+    if (!TLIST_CHECK(list, STRING, "insertString")) return;
+    list->methods->insertValue(list, index, (void *)value);
+}
+static inline void insertPtr(List list, int index, void *value){
+    if (!TLIST_CHECK(list, T, "insertPtr")) return;
+    list->methods->insertValue(list, index, value);
+}
+
+static inline void setInt(List list, int index, int value){
+    if (!TLIST_CHECK(list, INT, "setInt")) return;
+    list->methods->setValue(list, index, &value);
+}
+static inline void setFloat(List list, int index, float value){
+    if (!TLIST_CHECK(list, FLOAT, "setFloat")) return;
+    list->methods->setValue(list, index, &value);
+}
+static inline void setDouble(List list, int index, double value){
+    if (!TLIST_CHECK(list, DOUBLE, "setDouble")) return;
+    list->methods->setValue(list, index, &value);
+}
+static inline void setString(List list, int index, const char *value){
+    if (!TLIST_CHECK(list, STRING, "setString")) return;
+    list->methods->setValue(list, index, (void *)value);
+}
+static inline void setPtr(List list, int index, void *value){
+    if (!TLIST_CHECK(list, T, "setPtr")) return;
+    list->methods->setValue(list, index, value);
+}
+
+static inline int getInt(List list, int index){
+    if (!TLIST_CHECK(list, INT, "getInt")) return 0;
+    int *value = (int *)list->methods->get(list, index);
+    return value != NULL ? *value : 0;
+}
+static inline float getFloat(List list, int index){
+    if (!TLIST_CHECK(list, FLOAT, "getFloat")) return 0;
+    float *value = (float *)list->methods->get(list, index);
+    return value != NULL ? *value : 0;
+}
+static inline double getDouble(List list, int index){
+    if (!TLIST_CHECK(list, DOUBLE, "getDouble")) return 0;
+    double *value = (double *)list->methods->get(list, index);
+    return value != NULL ? *value : 0;
+}
+static inline const char *getString(List list, int index){
+    if (!TLIST_CHECK(list, STRING, "getString")) return NULL;
+    return (const char *)list->methods->get(list, index);
+}
+static inline void *getPtr(List list, int index){
+    if (!TLIST_CHECK(list, T, "getPtr")) return NULL;
+    return list->methods->get(list, index);
+}
+
+static inline int popInt(List list){
+    int value = 0;
+    if (TLIST_CHECK(list, INT, "popInt")) list->methods->popValue(list, &value);
+    return value;
+}
+static inline float popFloat(List list){
+    float value = 0;
+    if (TLIST_CHECK(list, FLOAT, "popFloat")) list->methods->popValue(list, &value);
+    return value;
+}
+static inline double popDouble(List list){
+    double value = 0;
+    if (TLIST_CHECK(list, DOUBLE, "popDouble")) list->methods->popValue(list, &value);
+    return value;
+}
+static inline char *popString(List list){
+    char *value = NULL;
+    if (TLIST_CHECK(list, STRING, "popString")) list->methods->popValue(list, &value);
+    return value;
+}
+static inline void *popPtr(List list){
+    void *value = NULL;
+    if (TLIST_CHECK(list, T, "popPtr")) list->methods->popValue(list, &value);
+    return value;
+}
+/** @} */
+
+/**
+ * @name Type-generic front end
+ * Dispatch to the typed entry point matching the static type of `value`:
+ * `int` to `*Int`, `float` to `*Float`, `double` to `*Double`, `char*` to
+ * `*String` and any other pointer to `*Ptr`. For example,
+ * `listPush(l, 2.5f)` calls `pushFloat(l, 2.5f)`.
+ * @{
+ */
+#define TLIST_SELECT(value, name) _Generic((value), \
+    int: name##Int, \
+    float: name##Float, \
+    double: name##Double, \
+    char *: name##String, \
+    const char *: name##String, \
+    default: name##Ptr)
+
+#define listPush(list, value) TLIST_SELECT((value), push)((list), (value))
+#define listInsert(list, index, value) TLIST_SELECT((value), insert)((list), (index), (value))
+#define listSet(list, index, value) TLIST_SELECT((value), set)((list), (index), (value))
+/** @} */
+
 #endif
@@ -8,58 +8,544 @@
 #include <string.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <stdint.h>
 
 /**
- * @struct Node
- * @brief Represents a node in the singly linked list.
+ * @brief Size of the in-node buffer used for `STRING` values.
+ *
+ * Strings whose length (including the terminator) fits in this many bytes are
+ * stored inside the node; longer strings are allocated on the heap.
  * @private
  */
-struct Node{
-    void *_val;      /**< Pointer to the data stored in the node. */
-    Node _nextNode;  /**< Pointer to the next node in the list. */
+#define TLIST_INLINE_STRING 16
+
+/**
+ * @brief Checks whether a node's value is stored inside the node itself.
+ * @private
+ */
+#define NODE_INLINE(node) ((node)->_val == (void *)(node)->_data)
+
+/**
+ * @brief The link to the previous node of a `LIST_DOUBLY` list.
+ *
+ * It is stored in the word just before the node, so singly linked nodes keep
+ * their layout and size.
+ * @private
+ */
+#define PREV_NODE(node) (((Node *)(void *)(node))[-1])
+
+/**
+ * @brief Bytes reserved in front of each node of the list for its `PREV_NODE` link.
+ * @private
+ */
+#define NODE_PREFIX(list) ((list)->_flags & LIST_DOUBLY ? sizeof(Node) : 0)
+
+/**
+ * @brief Sets the `PREV_NODE` link of `node`, if any, when the list is doubly linked.
+ * @private
+ */
+#define LINK_PREV(list, node, prev) \
+    do { if (((list)->_flags & LIST_DOUBLY) && (node) != NULL) PREV_NODE(node) = (prev); } while (0)
+
+/**
+ * @brief Number of nodes in the first block allocated by a `LIST_SLAB` list.
+ * @private
+ */
+#define TLIST_SLAB_MIN_BLOCK 64
+
+/**
+ * @brief Upper bound on the number of nodes in a single slab block.
+ *
+ * Block capacities double from `TLIST_SLAB_MIN_BLOCK` until they reach this size.
+ * @private
+ */
+#define TLIST_SLAB_MAX_BLOCK 4096
+
+/**
+ * @struct NodeBlock
+ * @brief A contiguous block of nodes owned by a `LIST_SLAB` list.
+ * @private
+ */
+struct NodeBlock{
+    struct NodeBlock *_nextBlock;   /**< Next block in the pool's block chain. */
+    size_t _capacity;               /**< Number of nodes the block can hold. */
+    size_t _used;                   /**< Number of nodes already carved from the block. */
+    _Alignas(struct Node) unsigned char _storage[];  /**< Node storage, `_nodeSize` bytes per node. */
 };
 
 /**
- * @struct TIterator
- * @brief Represents an iterator for a `List`.
+ * @struct NodePool
+ * @brief Per-list node allocator used by `LIST_SLAB` lists.
+ *
+ * Nodes are carved sequentially from the most recent block. Released nodes are
+ * pushed on `_freeNodes` (linked through `_nextNode`) and reused before any
+ * new block is allocated.
  * @private
  */
-struct TIterator{
-    Node _current;                          /**< Pointer to the current node in the iteration. */
-    List _list;                             /**< Pointer to the list being iterated. */
-    int _index;                             /**< The index of the current element. */
-    void* (*next)(struct TIterator*);       /**< Method to get the next element. */
-    bool (*hasNext)(struct TIterator*);     /**< Method to check if there is a next element. */
-    void (*free)(struct TIterator*);        /**< Method to free the iterator structure. */
+struct NodePool{
+    struct NodeBlock *_blocks;      /**< Chain of allocated blocks, most recent first. */
+    Node _freeNodes;                /**< Recycled nodes ready for reuse. */
+    size_t _nextCapacity;           /**< Capacity of the next block to allocate. */
 };
 
+/**
+ * @brief Size in bytes of the first string block of a `LIST_ARENA` list.
+ * @private
+ */
+#define TLIST_ARENA_MIN_BLOCK 4096
+
+/**
+ * @brief Upper bound on the size of a string block.
+ *
+ * Block sizes double from `TLIST_ARENA_MIN_BLOCK` until they reach this size.
+ * A string longer than a quarter of it gets a block of its own.
+ * @private
+ */
+#define TLIST_ARENA_MAX_BLOCK (1 << 20)
+
+/**
+ * @brief Number of slots in the first hash table of a `LIST_INTERN` list.
+ * @private
+ */
+#define TLIST_INTERN_MIN_TABLE 64
+
+/**
+ * @brief Minimum number of slots in the hash index built by `indexList`.
+ * @private
+ */
+#define TLIST_INDEX_MIN_TABLE 64
+
+/**
+ * @brief Target size in bytes of one chunk of a `LIST_UNROLLED` list, header included.
+ * @private
+ */
+#define TLIST_CHUNK_BYTES 128
+
+/**
+ * @struct Chunk
+ * @brief A node of an unrolled list, holding several consecutive elements.
+ *
+ * Each slot is `_size` bytes wide: `INT`, `FLOAT` and `DOUBLE` values are
+ * stored directly, `STRING` slots hold an owned heap copy and `T` slots hold
+ * the user's pointer.
+ * @private
+ */
+struct Chunk{
+    struct Chunk *_nextChunk;                   /**< Next chunk in the list. */
+    int _count;                                 /**< Number of elements in use. */
+    _Alignas(double) unsigned char _slots[];    /**< Element storage. */
+};
+
+/**
+ * @struct UnrolledStore
+ * @brief Storage state of a `LIST_UNROLLED` list, returned by `listStore`.
+ * @private
+ */
+struct UnrolledStore{
+    struct Chunk *_first;   /**< First chunk, or `NULL` when the list is empty. */
+    struct Chunk *_last;    /**< Last chunk, or `NULL` when the list is empty. */
+    int _capacity;          /**< Number of slots per chunk. */
+};
+
+/**
+ * @brief Capacity of the array allocated by the first `push` into a `LIST_VECTOR` list.
+ * @private
+ */
+#define TLIST_VECTOR_MIN_CAPACITY 8
+
+/**
+ * @struct VectorStore
+ * @brief Storage state of a `LIST_VECTOR` list, returned by `listStore`.
+ *
+ * Elements occupy slots `_start` to `_start + _length - 1` of `_data`, each
+ * `_size` bytes wide and laid out like the slots of a `Chunk`. Popping from
+ * the front only advances `_start`; the free space is reclaimed when the
+ * array would otherwise have to grow.
+ * @private
+ */
+struct VectorStore{
+    unsigned char *_data;   /**< Slot array, or `NULL` before the first allocation. */
+    int _start;             /**< Slot index of the first element. */
+    int _capacity;          /**< Number of slots in `_data`. */
+};
+
+/**
+ * @struct QueueStore
+ * @brief State of a `LIST_QUEUE` list (a Michael-Scott queue).
+ *
+ * `_head` always points to a dummy node whose value has already been
+ * consumed; the elements are the nodes after it. The first dummy is
+ * `_sentinel`, which lives in the list's allocation so that an emptied queue
+ * owns no heap memory. The list's own `_head`,
+ * `_tail` and `_length` stay unused. `_head` and `_tail` are kept on separate
+ * cache lines so that producers and consumers do not contend on one line.
+ * @private
+ */
+struct QueueStore{
+    _Atomic(Node) _head;                        /**< Dummy node; consumers advance it. */
+    char _headPad[64 - sizeof(Node)];
+    _Atomic(Node) _tail;                        /**< Last node, or one behind it; producers advance it. */
+    char _tailPad[64 - sizeof(Node)];
+    atomic_int _length;                         /**< Number of elements, updated after each operation. */
+    _Alignas(struct Node) unsigned char _sentinel[sizeof(struct Node)];  /**< Initial dummy node, never freed. */
+};
+
+/**
+ * @brief Number of retired nodes a thread accumulates before reclaiming them.
+ * @private
+ */
+#define TLIST_HAZARD_SCAN 128
+
+/**
+ * @brief Maximum number of distinct `LIST_SYNC` lists one thread can hold locked at once.
+ * @private
+ */
+#define TLIST_SYNC_NESTING 16
+
+/**
+ * @brief Size of the stack buffer used to gather linked-list values into contiguous segments.
+ * @private
+ */
+#define TLIST_STAGING_BYTES 4096
+
+/**
+ * @brief Size of the buffers used to read and write file descriptors.
+ * @private
+ */
+#define TLIST_IO_BYTES (1 << 16)
+
+/**
+ * @brief Minimum length from which `INT` and `FLOAT` lists are radix-sorted.
+ * @private
+ */
+#define TLIST_RADIX_MIN 256
+
+/**
+ * @brief Upper bound on the threads used by `parallelForeach` and `parallelMap`.
+ * @private
+ */
+#define TLIST_MAX_THREADS 256
+
+/**
+ * @brief Number of tasks a parallel call creates per participating thread.
+ *
+ * More tasks balance uneven callbacks better; fewer keep the split cheap.
+ * @private
+ */
+#define TLIST_TASKS_PER_THREAD 8
+
+/**
+ * @union Scalar
+ * @brief Temporary storage for a value read from a variadic argument list.
+ * @private
+ */
+typedef union Scalar{
+    int _int;
+    float _float;
+    double _double;
+    void *_ptr;
+} Scalar;
+
+/**
+ * @struct ListExtra
+ * @brief State that most lists never use, kept out of `struct Lista` behind its `_extra` pointer.
+ *
+ * Lists created with a `TAllocator` or `LIST_SYNC`, and every list of the
+ * instrumentation build, carry one inside their own allocation. Other lists
+ * point at the read-only `noExtra` until `listExtra` first has to write a
+ * field; the block it then allocates is released by the list's `free` method.
+ * @private
+ */
+struct ListExtra{
+    struct SyncStore *_sync;        /**< Lock and wrapped methods of `LIST_SYNC` lists, `NULL` otherwise. */
+    struct Share *_share;           /**< Copy-on-write state while the storage is shared with a duplicate, `NULL` otherwise. */
+    struct StringArena *_arena;     /**< String storage of `LIST_ARENA` lists, created with the first string; `NULL` otherwise. */
+    struct ValueIndex *_index;      /**< Hash index built by `indexList`, `NULL` otherwise. */
+#ifdef TLIST_STATS
+    struct StatsStore *_stats;      /**< Counters and wrapped methods of the instrumentation layer. */
+#endif
+    const TAllocator *_allocator;   /**< Memory functions given to `newListWithAllocator`, `NULL` for `malloc`. */
+    bool _allocated;                /**< Allocated by `listExtra` rather than part of the list's allocation. */
+};
+
+/**
+ * @brief The all-`NULL` state shared by the lists that have none of their own. Never written.
+ * @private
+ */
+extern const struct ListExtra noExtra;
+
+/**
+ * @brief Gives `this` a `struct ListExtra` of its own. Exits if memory runs out.
+ * @private
+ */
+struct ListExtra *ownExtra(List this);
+
+/**
+ * @brief Returns the writable `struct ListExtra` of `this`, allocating it on first use.
+ * @private
+ */
+static inline struct ListExtra *listExtra(List this){
+    return this->_extra != &noExtra ? this->_extra : ownExtra(this);
+}
+
+/**
+ * @brief Frees the `struct ListExtra` that `listExtra` allocated, if any.
+ *
+ * The fields must already be released or handed to another list.
+ * @private
+ */
+void releaseExtra(List this);
+
+/**
+ * @brief The node pool of a `LIST_SLAB` list, stored right after its `struct Lista`; `NULL` for other lists.
+ * @private
+ */
+static inline NodePool listPool(List this){
+    return this->_flags & LIST_SLAB ? (NodePool)(this + 1) : NULL;
+}
+
+/**
+ * @brief The `UnrolledStore`, `VectorStore` or `QueueStore` of a list with one of those backends.
+ *
+ * It is stored right after the `struct Lista`, like the `NodePool` of `LIST_SLAB` lists.
+ * @private
+ */
+static inline void *listStore(List this){
+    return this + 1;
+}
+
+/**
+ * @brief Points the list at a method table, updating the `TLIST_COMPAT_METHODS` copies.
+ * @private
+ */
+static inline void setMethods(List this, const struct ListMethods *methods){
+    this->methods = methods;
+#ifdef TLIST_COMPAT_METHODS
+    this->push = methods->push;
+    this->pop = methods->pop;
+    this->print = methods->print;
+    this->len = methods->len;
+    this->free = methods->free;
+    this->get = methods->get;
+    this->set = methods->set;
+    this->remove = methods->remove;
+    this->insert = methods->insert;
+    this->pick = methods->pick;
+    this->foreach = methods->foreach;
+#endif
+}
+
+/**
+ * @brief Allocates memory for the list, through its `TAllocator` if it has one.
+ * @private
+ * @return The memory, or `NULL` on failure like `malloc`.
+ */
+static inline void *listAlloc(List this, size_t size){
+    const TAllocator *allocator = this->_extra->_allocator;
+    return allocator == NULL ? malloc(size) : allocator->alloc(allocator->context, size);
+}
+
+/**
+ * @brief Allocates zeroed memory for the list, as `calloc` does.
+ * @private
+ */
+static inline void *listCalloc(List this, size_t n, size_t size){
+    const TAllocator *allocator = this->_extra->_allocator;
+    if (allocator == NULL) return calloc(n, size);
+    if (size != 0 && n > SIZE_MAX / size) return NULL;
+    void *memory = allocator->alloc(allocator->context, n * size);
+    return memory == NULL ? NULL : memset(memory, 0, n * size);
+}
+
+/**
+ * @brief Resizes memory obtained from `listAlloc`, as `realloc` does.
+ * @private
+ * @param oldSize The current size of `ptr`, 0 if it is `NULL`.
+ */
+static inline void *listRealloc(List this, void *ptr, size_t oldSize, size_t size){
+    const TAllocator *allocator = this->_extra->_allocator;
+    if (allocator == NULL) return realloc(ptr, size);
+    if (ptr == NULL) return allocator->alloc(allocator->context, size);
+    return allocator->realloc(allocator->context, ptr, oldSize, size);
+}
+
+/**
+ * @brief Frees memory obtained from `listAlloc`. `ptr` may be `NULL`.
+ * @private
+ */
+static inline void listFree(List this, void *ptr){
+    const TAllocator *allocator = this->_extra->_allocator;
+    if (allocator == NULL) free(ptr);
+    else if (ptr != NULL) allocator->free(allocator->context, ptr);
+}
+
+/**
+ * @brief Creates an empty list that allocates like `this`: duplicates, snapshots and other derived lists use this.
+ * @private
+ */
+List deriveList(List this, Type type, int flags);
+
+/**
+ * @brief Creates an empty list for internal use, which allocates like `this`, header included.
+ * @private
+ */
+List hiddenList(List this, int flags);
+
+/**
+ * @brief Releases the `struct Lista` of a list made by `hiddenList` (after its `free` method).
+ * @private
+ */
+void freeHiddenList(List this);
+
 /**
  * @brief Creates a new list node.
  * @private
+ * @param this The list that will own the node.
  * @param val Pointer to the value to be stored.
- * @param size Size of the value type.
- * @param type The type of data being stored.
  * @return The newly created node.
  */
-Node newNode(void *val, size_t size, Type type);
+Node newNode(List this, void *val);
 
 /**
- * @brief Implementation for the `print` method. Prints the list to stdout.
+ * @brief Obtains storage for one node, from the list's pool or from `malloc`.
+ * @private
+ */
+Node allocNode(List this);
+
+/**
+ * @brief Returns a node's storage to the list's pool or to `free`. The value is not touched.
+ * @private
+ */
+void releaseNode(List this, Node node);
+
+/**
+ * @brief Frees a node's value if it lives on the heap and is owned by the list.
+ * @private
+ */
+void releaseValue(List this, Node node);
+
+/**
+ * @brief Detaches a node's value so that it can be handed to the caller.
+ *
+ * Inline and arena values, and strings from a `TAllocator`, are copied to a
+ * new `malloc` allocation; other heap values are returned as is.
+ * @private
+ */
+void *detachValue(List this, Node node);
+
+/**
+ * @brief Stores `val` in `node`, inline when it fits, replacing any previous value.
+ * @private
+ */
+void storeValue(List this, Node node, void *val);
+
+/**
+ * @brief Finds the node at `index`, resuming from the list's cursor when possible.
+ * @private
+ * @return The node, or `NULL` if the index is out of bounds.
+ */
+Node seekNode(List this, int index);
+
+/**
+ * @brief Unlinks the node after `prev` (the head if `prev` is `NULL`), fixing up `_tail`, `_length` and the cursor.
+ * @private
+ * @return The unlinked node, whose value and storage are left untouched.
+ */
+Node unlinkAfter(List this, Node prev, int index);
+
+/**
+ * @brief Unlinks `node` from a `LIST_DOUBLY` list through its `PREV_NODE` link, fixing up `_tail` and `_length`.
+ *
+ * The node's index is unknown, so the cursor is reset.
+ * @private
+ * @return The unlinked node, whose value and storage are left untouched.
+ */
+Node unlinkNode(List this, Node node);
+
+/**
+ * @brief Reads the next variadic argument according to the list's type.
+ * @private
+ * @param this The list whose `Type` determines the argument type.
+ * @param args The argument list to read from.
+ * @param tmp Storage for the value.
+ * @return A pointer in the form expected by `newNode`: the address of the value
+ *         for `INT`, `FLOAT` and `DOUBLE`, the pointer itself for `STRING` and `T`.
+ */
+void *readArg(List this, va_list *args, Scalar *tmp);
+
+/**
+ * @brief Returns the value stored in a slot of an array-based backend, as `get` does.
+ * @private
+ */
+void *slotValue(List this, unsigned char *slot);
+
+/**
+ * @brief Stores a value (in `readArg` form) into an unused slot, copying strings.
+ * @private
+ */
+void writeSlot(List this, unsigned char *slot, void *val);
+
+/**
+ * @brief Returns a slot's value as a caller-owned pointer, copying value types and arena strings.
+ * @private
+ */
+void *detachSlot(List this, unsigned char *slot);
+
+/**
+ * @brief Frees a string owned by a `STRING` list, unless it lives in the list's arena.
+ * @private
+ */
+void releaseString(List this, char *string);
+
+/**
+ * @brief Returns element `i` of a `pushArray` array in `readArg` form.
+ * @private
+ */
+void *arrayValue(List this, const void *values, size_t i);
+
+/**
+ * @brief Visits the list's elements as contiguous arrays of slots.
+ *
+ * Each segment holds `n` consecutive elements laid out like `pushArray` input
+ * (`_size` bytes each). Vector lists are visited as one segment and unrolled
+ * lists chunk by chunk; linked-list values are gathered into a staging buffer
+ * of `TLIST_STAGING_BYTES` bytes first.
+ * @private
+ * @param visit Called for each segment; returning `false` stops the walk.
+ * @return `false` if `visit` stopped the walk, `true` otherwise.
+ */
+bool forEachSegment(List this, bool (*visit)(const void *data, size_t n, void *context), void *context);
+
+/**
+ * @brief Makes the reductions and searches use the named kernels instead of the best supported ones.
+ *
+ * Lets the tests compare every kernel set against the scalar one. Not
+ * thread-safe: call it while no reduction is running.
+ * @private
+ * @param level `"avx2"`, `"sse2"` or `"scalar"`, or `NULL` to go back to the automatic choice.
+ * @return `false`, leaving the choice unchanged, if the kernels are not built in or the CPU lacks them.
+ */
+bool forceSimdLevel(const char *level);
+
+/**
+ * @brief Prints a single value of the list's type to stdout.
  * @private
  */
-void print(List this);
+void printValue(List this, void *val);
 
 /**
- * @brief Implementation for the `push` method. Adds an element to the end of the list.
+ * @brief Implementation for the `print` method. Prints the list to stdout.
  * @private
  */
-void push(List this, ...);
+void linkedPrint(List this);
 
 /**
  * @brief Implementation for the `len` method. Returns the number of elements.
  * @private
  */
-int len(List this);
+int listLength(List this);
 
 /**
  * @brief Implementation for the `free` method. Frees all nodes and their data.
@@ -71,32 +557,385 @@ void destroyList(List this);
  * @brief Implementation for the `pop` method. Removes and returns the first element.
  * @private
  */
-void *pop(List this);
+void *linkedPop(List this);
+
+/** @private */
+void pushValue(List this, void *val);
+/** @private */
+void insertValue(List this, int index, void *val);
+/** @private */
+void setValue(List this, int index, void *val);
+/** @private */
+bool popValue(List this, void *out);
+/** @private */
+void insertValues(List this, int index, const void *values, size_t n);
+
+/**
+ * @name Variadic methods
+ * The `push`, `set` and `insert` of every method table, one set per way of
+ * reading the argument. They hand the value to the table's backend
+ * primitives, so they serve every storage backend and wrapper layer.
+ * @private
+ * @{
+ */
+void pushIntArg(List this, ...);
+void pushFloatArg(List this, ...);
+void pushDoubleArg(List this, ...);
+void pushPtrArg(List this, ...);
+void setIntArg(List this, int index, ...);
+void setFloatArg(List this, int index, ...);
+void setDoubleArg(List this, int index, ...);
+void setPtrArg(List this, int index, ...);
+void insertIntArg(List this, int index, ...);
+void insertFloatArg(List this, int index, ...);
+void insertDoubleArg(List this, int index, ...);
+void insertPtrArg(List this, int index, ...);
+/** @} */
+
+/**
+ * @brief Number of `Type` values, the length of a method table array.
+ * @private
+ */
+#define TLIST_TYPES (DOUBLE + 1)
 
 /** @private */
-void *get(List this, int index);
+#define VARIADIC_METHODS(suffix) .push = push##suffix##Arg, .set = set##suffix##Arg, .insert = insert##suffix##Arg
+
+/**
+ * @brief Initializer of a `struct ListMethods` array indexed by `Type`.
+ *
+ * The arguments are the designated non-variadic methods shared by every
+ * type; each entry adds the variadic methods that read its type.
+ * @private
+ */
+#define LIST_METHODS(...) { \
+    [T] = { VARIADIC_METHODS(Ptr), __VA_ARGS__ }, \
+    [INT] = { VARIADIC_METHODS(Int), __VA_ARGS__ }, \
+    [STRING] = { VARIADIC_METHODS(Ptr), __VA_ARGS__ }, \
+    [FLOAT] = { VARIADIC_METHODS(Float), __VA_ARGS__ }, \
+    [DOUBLE] = { VARIADIC_METHODS(Double), __VA_ARGS__ }, \
+}
+
 /** @private */
-void set(List this, int index, ...);
+void *linkedGet(List this, int index);
 /** @private */
-void delete(List this, int index);
+void linkedDelete(List this, int index);
 /** @private */
-void insert(List this, int index, ...);
+void *linkedPick(List this, int index);
 /** @private */
-void *pick(List this, int index);
+void linkedForeach(List this, void(*function)(void*));
+
+/**
+ * @brief Sets up the `LIST_UNROLLED` storage and methods of a new list.
+ * @private
+ * @param this The list being created.
+ * @param store Memory reserved for the `UnrolledStore`.
+ */
+void initUnrolled(List this, struct UnrolledStore *store);
+
 /** @private */
-void foreach(List this, void(*function)(void*));
+void *unrolledPop(List this);
+/** @private */
+bool unrolledPopValue(List this, void *out);
+/** @private */
+void unrolledPushValue(List this, void *val);
+/** @private */
+void unrolledInsertValue(List this, int index, void *val);
+/** @private */
+void unrolledSetValue(List this, int index, void *val);
+/** @private */
+void unrolledPrint(List this);
+/** @private */
+void unrolledDestroy(List this);
+/** @private */
+void *unrolledGet(List this, int index);
+/** @private */
+void unrolledDelete(List this, int index);
+/** @private */
+void *unrolledPick(List this, int index);
+/** @private */
+void unrolledForeach(List this, void(*function)(void*));
+/** @private */
+void unrolledInsertArray(List this, int index, const void *values, size_t n);
+/** @private */
+void* unrolledNext(TIterator iterator);
+/** @private */
+bool unrolledHasNext(TIterator iterator);
+/** @private */
+size_t unrolledNextBatch(TIterator iterator, void **out, size_t max);
+/** @private */
+void unrolledSplice(List dst, int pos, List src, int from, int to);
+
+/**
+ * @brief Sets up the `LIST_VECTOR` storage and methods of a new list.
+ * @private
+ * @param this The list being created.
+ * @param store Memory reserved for the `VectorStore`.
+ */
+void initVector(List this, struct VectorStore *store);
+
+/** @private */
+void *vectorPop(List this);
+/** @private */
+bool vectorPopValue(List this, void *out);
+/** @private */
+void vectorPushValue(List this, void *val);
+/** @private */
+void vectorInsertValue(List this, int index, void *val);
+/** @private */
+void vectorSetValue(List this, int index, void *val);
+/** @private */
+void vectorPrint(List this);
+/** @private */
+void vectorDestroy(List this);
+/** @private */
+void *vectorGet(List this, int index);
+/** @private */
+void vectorDelete(List this, int index);
+/** @private */
+void *vectorPick(List this, int index);
+/** @private */
+void vectorForeach(List this, void(*function)(void*));
+/** @private */
+void vectorReserve(List this, int capacity);
+/** @private */
+void vectorInsertArray(List this, int index, const void *values, size_t n);
+/** @private */
+void* vectorNext(TIterator iterator);
+/** @private */
+bool vectorHasNext(TIterator iterator);
+/** @private */
+size_t vectorNextBatch(TIterator iterator, void **out, size_t max);
+/** @private */
+void *vectorPrev(TIterator iterator);
+/** @private */
+bool vectorHasPrev(TIterator iterator);
+/** @private */
+void vectorSplice(List dst, int pos, List src, int from, int to);
+
+/**
+ * @brief Sets up the `LIST_QUEUE` storage and methods of a new list.
+ * @private
+ * @param this The list being created.
+ * @param store Memory reserved for the `QueueStore`.
+ */
+void initQueue(List this, struct QueueStore *store);
+
+/**
+ * @brief Returns the first element node of a `LIST_QUEUE` list (the node after the dummy).
+ * @private
+ */
+Node queueFirst(List this);
+
+/**
+ * @brief Size of the backend state (`NodePool`, `UnrolledStore`, ...) stored right after the `struct Lista`.
+ *
+ * `flags` must already be normalized by `newListWithFlags`.
+ * @private
+ */
+size_t storeSize(int flags);
+
+/**
+ * @brief Size of the lock state appended to `LIST_SYNC` lists.
+ * @private
+ */
+size_t syncStoreSize(void);
+
+/**
+ * @brief Wraps the methods of a new list with its reader-writer lock.
+ *
+ * Called after the storage backend is set up.
+ * @private
+ * @param this The list being created.
+ * @param memory Memory reserved for the lock state (`syncStoreSize` bytes).
+ */
+void initSync(List this, void *memory);
+
+/**
+ * @brief The method table a `LIST_SYNC` list runs once its lock is held.
+ *
+ * Copy-on-write sharing swaps this table, rather than the list's own, for
+ * wrappers that unshare first.
+ * @private
+ */
+const struct ListMethods **syncInner(List this);
+
+#ifdef TLIST_STATS
+/**
+ * @brief Size of the counters and wrapped methods appended to every list of an instrumentation build.
+ * @private
+ */
+size_t statsStoreSize(void);
+
+/**
+ * @brief Wraps the methods of a new list with call counters and timers.
+ *
+ * Called last, after `initSync`, so that lock waits count towards latency.
+ * @private
+ * @param this The list being created.
+ * @param memory Memory reserved for the counters (`statsStoreSize` bytes).
+ */
+void initStats(List this, void *memory);
+
+/** @private */
+void statTraversed(List this, size_t nodes);
+/** @private */
+void statMemory(List this, long long nodeBytes, long long valueBytes, int mallocs, int frees);
+/** @private */
+void adoptStats(List dst, List src);
+/** @private */
+void statCursor(List this, bool hit);
+
+/**
+ * @brief Counts `nodes` nodes walked past by an indexed lookup.
+ * @private
+ */
+#define STAT_TRAVERSED(list, nodes) statTraversed((list), (nodes))
+
+/**
+ * @brief Records allocations and frees made for the list's storage.
+ *
+ * The byte arguments are added to the bytes held by nodes and values (and
+ * are negative for frees). Arguments are not evaluated without `TLIST_STATS`.
+ * @private
+ */
+#define STAT_MEMORY(list, nodeBytes, valueBytes, mallocs, frees) \
+    statMemory((list), (long long)(nodeBytes), (long long)(valueBytes), (mallocs), (frees))
+
+/**
+ * @brief Moves the byte counts of `src` to `dst` along with its storage.
+ * @private
+ */
+#define STAT_ADOPT(dst, src) adoptStats((dst), (src))
+
+/**
+ * @brief Counts an indexed lookup that resumed from the cursor (`hit`) or restarted from an end.
+ * @private
+ */
+#define STAT_CURSOR(list, hit) statCursor((list), (hit))
+#else
+#define STAT_TRAVERSED(list, nodes) ((void)0)
+#define STAT_MEMORY(list, nodeBytes, valueBytes, mallocs, frees) ((void)0)
+#define STAT_ADOPT(dst, src) ((void)0)
+#define STAT_CURSOR(list, hit) ((void)0)
+#endif
+
+/**
+ * @brief Returns a new list with `flags` that shares the storage of `this` copy-on-write.
+ *
+ * The caller holds the write lock of `this`. `LIST_QUEUE` lists cannot be shared.
+ * @private
+ */
+List shareList(List this, int flags);
+
+/**
+ * @brief Returns a copy-on-write view of `owner`, a `LIST_VECTOR` list whose array lies in a file mapping.
+ *
+ * `owner` is hidden behind the view and released with `releaseImage` once
+ * the last view is freed or modified.
+ * @private
+ */
+List shareImage(List owner, void *image, size_t imageSize);
+
+/**
+ * @brief Unmaps an image mapped by `mmapList` and empties its owner list, which can then be freed.
+ * @private
+ */
+void releaseImage(List owner, void *image, size_t size);
+
+/**
+ * @brief Copies a string into the arena of a `LIST_ARENA` list, creating the arena if needed.
+ *
+ * In a `LIST_INTERN` list, a string already stored is not copied again and
+ * its stored copy is returned.
+ * @private
+ */
+char *arenaString(List this, const char *string);
+
+/**
+ * @brief Returns the stored copy of `string` in a `LIST_INTERN` list without adding it, or `NULL`.
+ * @private
+ */
+const char *findInterned(List this, const char *string);
+
+/**
+ * @brief Frees the string blocks and hash table of the list's arena, if any.
+ * @private
+ */
+void releaseArena(List this);
+
+/**
+ * @brief FNV-1a hash of a string, which also measures it.
+ * @private
+ * @param bytes Set to the size of the string, terminator included.
+ */
+uint64_t hashString(const char *string, size_t *bytes);
+
+/**
+ * @brief Adds a node to the hash index of the list. Called once the node holds its value.
+ * @private
+ */
+void indexNode(List this, Node node);
+
+/**
+ * @brief Removes a node from the hash index of the list. Called while the node still holds its value.
+ * @private
+ */
+void unindexNode(List this, Node node);
+
+/**
+ * @brief Rebuilds the hash index of the list from its nodes, after they were replaced or their values rewritten.
+ * @private
+ */
+void rebuildIndex(List this);
+
+/**
+ * @brief Frees the hash index of the list, if any.
+ * @private
+ */
+void releaseIndex(List this);
+
+/**
+ * @brief Counts, through the hash index, up to `limit` elements equal to `val` (in `readArg` form).
+ * @private
+ * @param first If not `NULL`, set to the index of the first match in list order, found by walking the list.
+ * @return The number of matches, at most `limit`.
+ */
+size_t indexMatches(List this, const void *val, size_t limit, size_t *first);
+
+/**
+ * @brief Counts up to `limit` elements equal to `val` (in `readArg` form), as `listCountOf` does.
+ * @private
+ */
+size_t countValue(List this, void *val, size_t limit);
+
+/**
+ * @brief Gives a list that shares its storage a private copy, restoring its own methods.
+ *
+ * Does nothing for lists that do not share storage. Called with the list's
+ * write lock held by every operation that modifies the storage directly.
+ * @private
+ * @return `true` if the list kept its storage, `false` if it moved to a copy.
+ */
+bool unshare(List this);
+
+/**
+ * @brief Whether the calling thread holds the read lock, and not the write lock, of a `LIST_SYNC` list.
+ * @private
+ */
+bool readLockHeld(List this);
 
 /**
  * @brief Implementation for the iterator's `next` method. Returns the next element.
  * @private
  */
-void* next(TIterator iterator);
+void* linkedNext(TIterator iterator);
 
 /**
  * @brief Implementation for the iterator's `hasNext` method. Checks for more elements.
  * @private
  */
-bool hasNext(TIterator iterator);
+bool linkedHasNext(TIterator iterator);
 
 /**
  * @brief Implementation for the iterator's `free` method. Frees the iterator.
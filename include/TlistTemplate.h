@@ -0,0 +1,217 @@
+#ifndef T_LIST_TEMPLATE
+#define T_LIST_TEMPLATE
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @file TlistTemplate.h
+ * @brief Macro-generated singly linked lists specialized for one element type.
+ *
+ * `TLIST_DECLARE(name, type)` declares a list type `name` whose nodes embed
+ * `type` by value, and `TLIST_DEFINE(name, type)` provides its operations as
+ * `static inline` functions. Unlike `List`, there is no `void*` indirection,
+ * no per-element value allocation and no dispatch through function pointers,
+ * so the compiler can inline every call. Any complete type can be used,
+ * including structs.
+ *
+ * The generated operations mirror the `struct Lista` methods:
+ *
+ * | `List` method        | Generated function                         |
+ * |----------------------|--------------------------------------------|
+ * | `newList(type)`      | `name new##name(void)`                     |
+ * | `push`               | `void name##Push(name, type)`              |
+ * | `pop`                | `bool name##Pop(name, type *out)`          |
+ * | `get`                | `type *name##Get(name, int)`               |
+ * | `set`                | `void name##Set(name, int, type)`          |
+ * | `insert`             | `void name##Insert(name, int, type)`       |
+ * | `remove`             | `void name##Remove(name, int)`             |
+ * | `pick`               | `bool name##Pick(name, int, type *out)`    |
+ * | `len`                | `int name##Len(name)`                      |
+ * | `foreach`            | `void name##Foreach(name, void (*)(type *))` |
+ * | `free`               | `void name##Free(name)`                    |
+ *
+ * `pop` and `pick` copy the removed value to `out` (which may be `NULL`) and
+ * return `false` when there is nothing to remove. `get` returns a pointer to
+ * the value inside the node, valid until the element is removed. Iteration
+ * uses a stack-allocated `name##Iterator` with `name##Begin`, `name##HasNext`
+ * and `name##Next`. As with `List`, `name##Free` releases the nodes and the
+ * list itself is released with `free()`.
+ *
+ * ```c
+ * struct Point { int x, y; };
+ * TLIST_DECLARE(PointList, struct Point)
+ * TLIST_DEFINE(PointList, struct Point)
+ *
+ * PointList points = newPointList();
+ * PointListPush(points, (struct Point){1, 2});
+ * for (PointListIterator it = PointListBegin(points); PointListHasNext(&it);) {
+ *     struct Point *p = PointListNext(&it);
+ * }
+ * PointListFree(points);
+ * free(points);
+ * ```
+ */
+
+/**
+ * @brief Declares the list type `name` holding values of `type` and its operations.
+ */
+#define TLIST_DECLARE(name, type) \
+    typedef struct name##Node *name##Node; \
+    struct name##Node { \
+        type _val; \
+        name##Node _nextNode; \
+    }; \
+    typedef struct name *name; \
+    struct name { \
+        name##Node _head; \
+        name##Node _tail; \
+        int _length; \
+    }; \
+    typedef struct name##Iterator { \
+        name##Node _current; \
+    } name##Iterator; \
+    static inline name new##name(void); \
+    static inline void name##Push(name this, type value); \
+    static inline bool name##Pop(name this, type *out); \
+    static inline type *name##Get(name this, int index); \
+    static inline void name##Set(name this, int index, type value); \
+    static inline void name##Insert(name this, int index, type value); \
+    static inline void name##Remove(name this, int index); \
+    static inline bool name##Pick(name this, int index, type *out); \
+    static inline int name##Len(name this); \
+    static inline void name##Foreach(name this, void (*function)(type *)); \
+    static inline void name##Free(name this); \
+    static inline name##Iterator name##Begin(name this); \
+    static inline bool name##HasNext(const name##Iterator *iterator); \
+    static inline type *name##Next(name##Iterator *iterator);
+
+/**
+ * @brief Defines the operations declared by `TLIST_DECLARE(name, type)`.
+ */
+#define TLIST_DEFINE(name, type) \
+    static inline name new##name(void){ \
+        name this = (name)malloc(sizeof(struct name)); \
+        if (this == NULL) { \
+            fprintf(stderr, "Error in new" #name "(): Failed to allocate memory for the new list.\n"); \
+            exit(EXIT_FAILURE); \
+        } \
+        this->_head = NULL; \
+        this->_tail = NULL; \
+        this->_length = 0; \
+        return this; \
+    } \
+    static inline name##Node name##NewNode(type value){ \
+        name##Node node = (name##Node)malloc(sizeof(struct name##Node)); \
+        if (node == NULL) { \
+            fprintf(stderr, "Error in " #name "Push(): Failed to allocate memory for a new node.\n"); \
+            exit(EXIT_FAILURE); \
+        } \
+        node->_val = value; \
+        node->_nextNode = NULL; \
+        return node; \
+    } \
+    /* Returns the node at `index`, or NULL if it is out of bounds. */ \
+    static inline name##Node name##NodeAt(name this, int index){ \
+        if (index < 0 || index >= this->_length) return NULL; \
+        if (index == this->_length - 1) return this->_tail; \
+        name##Node current = this->_head; \
+        while (index-- > 0) current = current->_nextNode; \
+        return current; \
+    } \
+    static inline void name##Push(name this, type value){ \
+        name##Node node = name##NewNode(value); \
+        if (this->_head == NULL) this->_head = node; \
+        else this->_tail->_nextNode = node; \
+        this->_tail = node; \
+        this->_length++; \
+    } \
+    static inline bool name##Pop(name this, type *out){ \
+        return name##Pick(this, 0, out); \
+    } \
+    static inline type *name##Get(name this, int index){ \
+        name##Node node = name##NodeAt(this, index); \
+        if (node == NULL) { \
+            fprintf(stderr, "Error in " #name "Get(): Index %d is out of bounds for list of size %d.\n", index, this->_length); \
+            return NULL; \
+        } \
+        return &node->_val; \
+    } \
+    static inline void name##Set(name this, int index, type value){ \
+        type *slot = name##Get(this, index); \
+        if (slot != NULL) *slot = value; \
+    } \
+    static inline void name##Insert(name this, int index, type value){ \
+        if (index < 0 || index > this->_length) { \
+            fprintf(stderr, "Error in " #name "Insert(): Index %d is out of bounds. Valid range is 0 to %d.\n", index, this->_length); \
+            return; \
+        } \
+        if (index == this->_length) { \
+            name##Push(this, value); \
+            return; \
+        } \
+        name##Node node = name##NewNode(value); \
+        if (index == 0) { \
+            node->_nextNode = this->_head; \
+            this->_head = node; \
+        } else { \
+            name##Node prev = name##NodeAt(this, index - 1); \
+            node->_nextNode = prev->_nextNode; \
+            prev->_nextNode = node; \
+        } \
+        this->_length++; \
+    } \
+    static inline bool name##Pick(name this, int index, type *out){ \
+        if (index < 0 || index >= this->_length) { \
+            if (index != 0) { \
+                fprintf(stderr, "Error in " #name "Pick(): Index %d is out of bounds for list of size %d.\n", index, this->_length); \
+            } \
+            return false; \
+        } \
+        name##Node prev = index == 0 ? NULL : name##NodeAt(this, index - 1); \
+        name##Node node = prev == NULL ? this->_head : prev->_nextNode; \
+        if (prev == NULL) this->_head = node->_nextNode; \
+        else prev->_nextNode = node->_nextNode; \
+        if (node == this->_tail) this->_tail = prev; \
+        this->_length--; \
+        if (out != NULL) *out = node->_val; \
+        free(node); \
+        return true; \
+    } \
+    static inline void name##Remove(name this, int index){ \
+        name##Pick(this, index, NULL); \
+    } \
+    static inline int name##Len(name this){ \
+        return this->_length; \
+    } \
+    static inline void name##Foreach(name this, void (*function)(type *)){ \
+        for (name##Node current = this->_head; current != NULL; current = current->_nextNode){ \
+            function(&current->_val); \
+        } \
+    } \
+    static inline void name##Free(name this){ \
+        name##Node current = this->_head; \
+        while (current != NULL){ \
+            name##Node temp = current; \
+            current = temp->_nextNode; \
+            free(temp); \
+        } \
+        this->_head = NULL; \
+        this->_tail = NULL; \
+        this->_length = 0; \
+    } \
+    static inline name##Iterator name##Begin(name this){ \
+        name##Iterator iterator = { this->_head }; \
+        return iterator; \
+    } \
+    static inline bool name##HasNext(const name##Iterator *iterator){ \
+        return iterator->_current != NULL; \
+    } \
+    static inline type *name##Next(name##Iterator *iterator){ \
+        type *val = &iterator->_current->_val; \
+        iterator->_current = iterator->_current->_nextNode; \
+        return val; \
+    }
+
+#endif
@@ -0,0 +1,210 @@
+/**
+ * @file Tarena.c
+ * @brief String storage of `LIST_ARENA` and `LIST_INTERN` lists.
+ *
+ * Strings are copied into blocks owned by the list, back to back, by bumping
+ * an offset. Block sizes double from `TLIST_ARENA_MIN_BLOCK` up to
+ * `TLIST_ARENA_MAX_BLOCK`. Strings are never freed one at a time: a removed
+ * or replaced string keeps its bytes until `releaseArena` frees every block.
+ *
+ * `LIST_INTERN` lists also keep an open-addressing hash table of the strings
+ * stored, and store each distinct string once. Equal elements are then the
+ * same pointer, which lets searches compare pointers instead of bytes.
+ */
+
+#include "Tlist.h"
+#include "TlistPrivate.h"
+#include <stdint.h>
+
+/**
+ * @struct ArenaBlock
+ * @brief A block of string storage.
+ * @private
+ */
+struct ArenaBlock{
+    struct ArenaBlock *_nextBlock;  /**< Next block in the arena's chain. */
+    size_t _capacity;               /**< Bytes the block can hold. */
+    size_t _used;                   /**< Bytes already handed out. */
+    char _bytes[];
+};
+
+/**
+ * @struct InternSlot
+ * @brief An entry of the `LIST_INTERN` hash table.
+ * @private
+ */
+typedef struct InternSlot{
+    const char *_string;    /**< Stored copy, or `NULL` for an empty slot. */
+    uint64_t _hash;
+} InternSlot;
+
+/**
+ * @struct StringArena
+ * @brief String storage of one list, referenced by the list's `_extra->_arena`.
+ * @private
+ */
+struct StringArena{
+    struct ArenaBlock *_blocks;     /**< Chain of blocks; the first is the one being filled. */
+    size_t _nextCapacity;           /**< Capacity of the next block to allocate. */
+    InternSlot *_table;             /**< Hash table of `LIST_INTERN` lists, `NULL` otherwise. */
+    size_t _tableSize;              /**< Number of slots, a power of two. */
+    size_t _count;                  /**< Number of strings in the table. */
+};
+
+/** @copydoc hashString */
+uint64_t hashString(const char *string, size_t *bytes){
+    uint64_t hash = UINT64_C(14695981039346656037);
+    const unsigned char *p = (const unsigned char *)string;
+    for (; *p != '\0'; p++){
+        hash = (hash ^ *p) * UINT64_C(1099511628211);
+    }
+    *bytes = (size_t)(p - (const unsigned char *)string) + 1;
+    return hash;
+}
+
+/**
+ * @brief Returns the slot holding `string`, or the empty slot where it belongs.
+ * @private
+ */
+static InternSlot *probe(const struct StringArena *arena, const char *string, uint64_t hash){
+    size_t mask = arena->_tableSize - 1;
+    for (size_t i = (size_t)hash & mask;; i = (i + 1) & mask){
+        InternSlot *slot = &arena->_table[i];
+        if (slot->_string == NULL) return slot;
+        if (slot->_hash == hash && strcmp(slot->_string, string) == 0) return slot;
+    }
+}
+
+/**
+ * @brief Doubles the hash table (or creates it) and reinserts its strings.
+ * @private
+ */
+static void growTable(List this){
+    struct StringArena *arena = this->_extra->_arena;
+    size_t oldSize = arena->_tableSize;
+    InternSlot *old = arena->_table;
+    arena->_tableSize = oldSize == 0 ? TLIST_INTERN_MIN_TABLE : oldSize * 2;
+    arena->_table = listCalloc(this, arena->_tableSize, sizeof(InternSlot));
+    if (arena->_table == NULL) {
+        fprintf(stderr, "Error in newNode(): Failed to allocate memory for the string table.\n");
+        exit(EXIT_FAILURE);
+    }
+    size_t mask = arena->_tableSize - 1;
+    for (size_t i = 0; i < oldSize; i++){
+        if (old[i]._string == NULL) continue;
+        size_t j = (size_t)old[i]._hash & mask;
+        while (arena->_table[j]._string != NULL) j = (j + 1) & mask;
+        arena->_table[j] = old[i];
+    }
+    listFree(this, old);
+}
+
+/**
+ * @brief Hands out `bytes` bytes of string storage.
+ *
+ * Strings longer than a quarter of `TLIST_ARENA_MAX_BLOCK` get a block of
+ * their own, linked behind the current block so that it keeps filling up.
+ * @private
+ */
+static char *arenaAlloc(List this, size_t bytes){
+    struct StringArena *arena = this->_extra->_arena;
+    struct ArenaBlock *current = arena->_blocks;
+    if (current != NULL && current->_capacity - current->_used >= bytes) {
+        char *memory = current->_bytes + current->_used;
+        current->_used += bytes;
+        return memory;
+    }
+    bool dedicated = bytes > TLIST_ARENA_MAX_BLOCK / 4;
+    // A string may still outgrow the next block; it stays within the largest block size.
+    while (!dedicated && arena->_nextCapacity < bytes) arena->_nextCapacity *= 2;
+    size_t capacity = dedicated ? bytes : arena->_nextCapacity;
+    struct ArenaBlock *block = listAlloc(this, sizeof(struct ArenaBlock) + capacity);
+    if (block == NULL) {
+        fprintf(stderr, "Error in newNode(): Failed to allocate memory for a string block.\n");
+        exit(EXIT_FAILURE);
+    }
+    STAT_MEMORY(this, 0, sizeof(struct ArenaBlock) + capacity, 1, 0);
+    block->_capacity = capacity;
+    block->_used = bytes;
+    if (dedicated && current != NULL) {
+        block->_nextBlock = current->_nextBlock;
+        current->_nextBlock = block;
+    } else {
+        block->_nextBlock = current;
+        arena->_blocks = block;
+        if (!dedicated && arena->_nextCapacity < TLIST_ARENA_MAX_BLOCK) {
+            arena->_nextCapacity *= 2;
+        }
+    }
+    return block->_bytes;
+}
+
+/** @copydoc arenaString */
+char *arenaString(List this, const char *string){
+    struct StringArena *arena = this->_extra->_arena;
+    if (arena == NULL) {
+        arena = listCalloc(this, 1, sizeof(struct StringArena));
+        if (arena == NULL) {
+            fprintf(stderr, "Error in newNode(): Failed to allocate memory for the string arena.\n");
+            exit(EXIT_FAILURE);
+        }
+        arena->_nextCapacity = TLIST_ARENA_MIN_BLOCK;
+        listExtra(this)->_arena = arena;
+    }
+    size_t bytes;
+    if (!(this->_flags & LIST_INTERN)) {
+        bytes = strlen(string) + 1;
+        return memcpy(arenaAlloc(this, bytes), string, bytes);
+    }
+    uint64_t hash = hashString(string, &bytes);
+    // Keep the table at most half full so that probe sequences stay short.
+    if (2 * (arena->_count + 1) > arena->_tableSize) growTable(this);
+    InternSlot *slot = probe(arena, string, hash);
+    if (slot->_string == NULL) {
+        slot->_string = memcpy(arenaAlloc(this, bytes), string, bytes);
+        slot->_hash = hash;
+        arena->_count++;
+    }
+    return (char *)slot->_string;
+}
+
+/** @copydoc findInterned */
+const char *findInterned(List this, const char *string){
+    struct StringArena *arena = this->_extra->_arena;
+    if (arena == NULL || arena->_table == NULL) return NULL;
+    size_t bytes;
+    return probe(arena, string, hashString(string, &bytes))->_string;
+}
+
+/** @copydoc releaseArena */
+void releaseArena(List this){
+    struct StringArena *arena = this->_extra->_arena;
+    if (arena == NULL) return;
+    struct ArenaBlock *block = arena->_blocks;
+    while (block != NULL){
+        struct ArenaBlock *temp = block;
+        block = temp->_nextBlock;
+        STAT_MEMORY(this, 0, -(long long)(sizeof(struct ArenaBlock) + temp->_capacity), 0, 1);
+        listFree(this, temp);
+    }
+    listFree(this, arena->_table);
+    listFree(this, arena);
+    this->_extra->_arena = NULL;
+}
+
+/** @copydoc internedString */
+const char *internedString(List this, const char *string){
+    if (this == NULL) {
+        fprintf(stderr, "Error in internedString(): The provided list instance is NULL.\n");
+        return NULL;
+    }
+    if (!(this->_flags & LIST_INTERN)) {
+        fprintf(stderr, "Error in internedString(): The list was not created with LIST_INTERN.\n");
+        return NULL;
+    }
+    if (string == NULL) return NULL;
+    if (!listLock(this, false)) return NULL;
+    const char *stored = findInterned(this, string);
+    listUnlock(this);
+    return stored;
+}
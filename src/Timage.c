@@ -0,0 +1,532 @@
+/**
+ * @file Timage.c
+ * @brief Binary list images: `saveList`/`writeList`, `loadList`/`readList` and `mmapList`.
+ *
+ * An image is an `ImageHeader` followed by `_dataBytes` bytes of data, all in
+ * the byte order of the machine that wrote it:
+ * - `INT`, `FLOAT` and `DOUBLE`: the values, packed, `_valueSize` bytes each.
+ * - `STRING`: a table of `_length` 64-bit offsets, then one record per
+ *   string: a 32-bit length, the bytes and a terminating NUL, padded to a
+ *   multiple of 4 bytes. Each offset locates the bytes of its string,
+ *   counted from the start of the data, so a mapped image can be indexed
+ *   without being parsed.
+ *
+ * `mmapList` maps an image and returns a `LIST_VECTOR` list whose array is
+ * the mapped data itself (for `STRING`, an array of pointers into it). The
+ * list is a copy-on-write view, like a `duplicate`: reading needs no
+ * deserialization, and the first modification copies the elements into
+ * memory of the list's own.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "Tlist.h"
+#include "TlistPrivate.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/** Format version written to and accepted in `ImageHeader._version`. @private */
+#define TLIST_IMAGE_VERSION 1
+
+/** Value of `ImageHeader._byteOrder` as written; it reads differently on a machine with the other byte order. @private */
+#define TLIST_IMAGE_BYTE_ORDER 0x0102
+
+/**
+ * @struct ImageHeader
+ * @brief The first 32 bytes of a list image.
+ * @private
+ */
+struct ImageHeader{
+    char _magic[4];         /**< "TLST". */
+    uint16_t _version;      /**< `TLIST_IMAGE_VERSION`. */
+    uint16_t _byteOrder;    /**< `TLIST_IMAGE_BYTE_ORDER`. */
+    uint32_t _type;         /**< The list's `Type`. */
+    uint32_t _valueSize;    /**< Bytes per value for numeric types, 0 for `STRING`. */
+    uint64_t _length;       /**< Number of elements. */
+    uint64_t _dataBytes;    /**< Number of bytes following the header. */
+};
+
+static const char imageMagic[4] = {'T', 'L', 'S', 'T'};
+
+/** Size of a `STRING` record holding `bytes` bytes before its NUL. @private */
+static uint64_t recordSize(size_t bytes){
+    return (sizeof(uint32_t) + bytes + 1 + 3) / 4 * 4;
+}
+
+/* Writing ----------------------------------------------------------------- */
+
+/**
+ * @struct Writer
+ * @brief Buffered output to a file descriptor.
+ * @private
+ */
+typedef struct Writer{
+    int _fd;
+    bool _failed;           /**< A write failed; later output is dropped. */
+    size_t _valueSize;      /**< Bytes per value of a numeric list. */
+    uint64_t _offset;       /**< Running record offset while writing the `STRING` offset table. */
+    size_t _used;
+    unsigned char _buffer[TLIST_IO_BYTES];
+} Writer;
+
+/** @private */
+static void writeAll(Writer *writer, const void *data, size_t n){
+    const unsigned char *bytes = data;
+    while (n > 0 && !writer->_failed){
+        ssize_t written = write(writer->_fd, bytes, n);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) {
+            fprintf(stderr, "Error in writeList(): Write failed: %s.\n", strerror(errno));
+            writer->_failed = true;
+            return;
+        }
+        bytes += written;
+        n -= (size_t)written;
+    }
+}
+
+/** @private */
+static void flush(Writer *writer){
+    writeAll(writer, writer->_buffer, writer->_used);
+    writer->_used = 0;
+}
+
+/** @private */
+static void put(Writer *writer, const void *data, size_t n){
+    if (writer->_used + n > TLIST_IO_BYTES) {
+        flush(writer);
+        if (n > TLIST_IO_BYTES) {
+            writeAll(writer, data, n);
+            return;
+        }
+    }
+    memcpy(writer->_buffer + writer->_used, data, n);
+    writer->_used += n;
+}
+
+/** `forEachSegment` visitor writing packed numeric values. @private */
+static bool putValues(const void *data, size_t n, void *context){
+    Writer *writer = context;
+    put(writer, data, n * writer->_valueSize);
+    return !writer->_failed;
+}
+
+/** `forEachSegment` visitor adding up the record sizes of a `STRING` list. @private */
+static bool sumRecords(const void *data, size_t n, void *context){
+    char *const *strings = data;
+    for (size_t i = 0; i < n; i++) *(uint64_t *)context += recordSize(strlen(strings[i]));
+    return true;
+}
+
+/** `forEachSegment` visitor writing the offset table of a `STRING` list. @private */
+static bool putOffsets(const void *data, size_t n, void *context){
+    Writer *writer = context;
+    char *const *strings = data;
+    for (size_t i = 0; i < n; i++){
+        uint64_t offset = writer->_offset + sizeof(uint32_t);
+        put(writer, &offset, sizeof offset);
+        writer->_offset += recordSize(strlen(strings[i]));
+    }
+    return !writer->_failed;
+}
+
+/** `forEachSegment` visitor writing the string records of a `STRING` list. @private */
+static bool putRecords(const void *data, size_t n, void *context){
+    static const unsigned char padding[4] = {0};
+    Writer *writer = context;
+    char *const *strings = data;
+    for (size_t i = 0; i < n; i++){
+        size_t bytes = strlen(strings[i]);
+        uint32_t length = (uint32_t)bytes;
+        put(writer, &length, sizeof length);
+        put(writer, strings[i], bytes + 1);
+        put(writer, padding, recordSize(bytes) - sizeof(uint32_t) - bytes - 1);
+    }
+    return !writer->_failed;
+}
+
+/** @copydoc writeList */
+bool writeList(List this, int fd){
+    if (this == NULL) {
+        fprintf(stderr, "Error in writeList(): The provided list instance is NULL.\n");
+        return false;
+    }
+    if (this->_type == T) {
+        fprintf(stderr, "Error in writeList(): Lists of type T hold pointers and cannot be saved.\n");
+        return false;
+    }
+    if (!listLock(this, false)) return false;
+    Writer *writer = malloc(sizeof(Writer));
+    if (writer == NULL) {
+        fprintf(stderr, "Error in writeList(): Failed to allocate the output buffer.\n");
+        exit(EXIT_FAILURE);
+    }
+    writer->_fd = fd;
+    writer->_failed = false;
+    writer->_used = 0;
+
+    struct ImageHeader header = {
+        ._version = TLIST_IMAGE_VERSION,
+        ._byteOrder = TLIST_IMAGE_BYTE_ORDER,
+        ._type = (uint32_t)this->_type,
+        ._valueSize = this->_type == STRING ? 0 : (uint32_t)this->_size,
+        ._length = (uint64_t)this->_length,
+    };
+    memcpy(header._magic, imageMagic, sizeof header._magic);
+    if (this->_type == STRING) {
+        uint64_t records = 0;
+        forEachSegment(this, sumRecords, &records);
+        header._dataBytes = header._length * sizeof(uint64_t) + records;
+        put(writer, &header, sizeof header);
+        writer->_offset = header._length * sizeof(uint64_t);
+        forEachSegment(this, putOffsets, writer);
+        forEachSegment(this, putRecords, writer);
+    } else {
+        header._dataBytes = header._length * header._valueSize;
+        put(writer, &header, sizeof header);
+        writer->_valueSize = header._valueSize;
+        forEachSegment(this, putValues, writer);
+    }
+    flush(writer);
+    bool saved = !writer->_failed;
+    free(writer);
+    listUnlock(this);
+    return saved;
+}
+
+/** @copydoc saveList */
+bool saveList(List this, const char *path){
+    if (this == NULL || path == NULL) {
+        fprintf(stderr, "Error in saveList(): The provided list instance or path is NULL.\n");
+        return false;
+    }
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (fd < 0) {
+        fprintf(stderr, "Error in saveList(): Cannot open %s: %s.\n", path, strerror(errno));
+        return false;
+    }
+    bool saved = writeList(this, fd);
+    if (close(fd) != 0) {
+        fprintf(stderr, "Error in saveList(): Cannot close %s: %s.\n", path, strerror(errno));
+        saved = false;
+    }
+    return saved;
+}
+
+/* Reading ----------------------------------------------------------------- */
+
+/**
+ * @brief Checks a header read from an image.
+ * @param function Name of the public function, for error messages.
+ * @private
+ */
+static bool checkHeader(const struct ImageHeader *header, const char *function){
+    if (memcmp(header->_magic, imageMagic, sizeof header->_magic) != 0) {
+        fprintf(stderr, "Error in %s(): Not a list image.\n", function);
+        return false;
+    }
+    if (header->_byteOrder != TLIST_IMAGE_BYTE_ORDER) {
+        fprintf(stderr, "Error in %s(): The image was written on a machine with a different byte order.\n", function);
+        return false;
+    }
+    if (header->_version != TLIST_IMAGE_VERSION) {
+        fprintf(stderr, "Error in %s(): Unsupported image version %u.\n", function, (unsigned)header->_version);
+        return false;
+    }
+    size_t size = 0;
+    switch (header->_type){
+        case INT: size = sizeof(int); break;
+        case FLOAT: size = sizeof(float); break;
+        case DOUBLE: size = sizeof(double); break;
+        case STRING: size = 0; break;
+        default:
+            fprintf(stderr, "Error in %s(): The image has an invalid type %u.\n", function, (unsigned)header->_type);
+            return false;
+    }
+    bool valid = header->_valueSize == size && header->_length <= INT_MAX;
+    if (valid && header->_type == STRING) valid = header->_dataBytes / sizeof(uint64_t) >= header->_length;
+    if (valid && header->_type != STRING) valid = header->_dataBytes == header->_length * size;
+    if (!valid) {
+        fprintf(stderr, "Error in %s(): The image header is corrupt.\n", function);
+    }
+    return valid;
+}
+
+/**
+ * @brief Reads exactly `n` bytes, retrying on short reads.
+ * @return `false` on end of input or a read error.
+ * @private
+ */
+static bool readAll(int fd, void *data, size_t n){
+    unsigned char *bytes = data;
+    while (n > 0){
+        ssize_t got = read(fd, bytes, n);
+        if (got < 0 && errno == EINTR) continue;
+        if (got < 0) {
+            fprintf(stderr, "Error in readList(): Read failed: %s.\n", strerror(errno));
+            return false;
+        }
+        if (got == 0) {
+            fprintf(stderr, "Error in readList(): The image is truncated.\n");
+            return false;
+        }
+        bytes += got;
+        n -= (size_t)got;
+    }
+    return true;
+}
+
+/**
+ * @struct ImageReader
+ * @brief Buffered reading of the data of an image, which never reads past its end.
+ * @private
+ */
+typedef struct ImageReader{
+    int _fd;
+    unsigned char *_buffer;     /**< `TLIST_IO_BYTES` bytes. */
+    size_t _pos;                /**< First byte not consumed yet. */
+    size_t _end;                /**< End of the bytes read into `_buffer`. */
+    uint64_t _unread;           /**< Data bytes not read from `_fd` yet. */
+} ImageReader;
+
+/**
+ * @brief Makes at least `n` bytes, at most `TLIST_IO_BYTES`, available at `_pos`.
+ * @private
+ */
+static bool ensure(ImageReader *reader, size_t n){
+    size_t buffered = reader->_end - reader->_pos;
+    if (buffered >= n) return true;
+    if (buffered + reader->_unread < n) {
+        fprintf(stderr, "Error in readList(): The image is corrupt.\n");
+        return false;
+    }
+    memmove(reader->_buffer, reader->_buffer + reader->_pos, buffered);
+    reader->_pos = 0;
+    reader->_end = buffered;
+    size_t want = TLIST_IO_BYTES - buffered;
+    if (want > reader->_unread) want = (size_t)reader->_unread;
+    if (!readAll(reader->_fd, reader->_buffer + buffered, want)) return false;
+    reader->_end += want;
+    reader->_unread -= want;
+    return true;
+}
+
+/**
+ * @brief Reads the string records of an image into `list`.
+ *
+ * Records are read a buffer at a time and pushed straight out of the
+ * buffer; only a record longer than the buffer gets an allocation.
+ * @private
+ */
+static bool readStrings(List list, int fd, const struct ImageHeader *header){
+    unsigned char *buffer = malloc(TLIST_IO_BYTES);
+    if (buffer == NULL) {
+        fprintf(stderr, "Error in readList(): Failed to allocate the input buffer.\n");
+        exit(EXIT_FAILURE);
+    }
+    ImageReader reader = { ._fd = fd, ._buffer = buffer, ._unread = header->_dataBytes };
+    // The offset table only serves `mmapList`.
+    uint64_t skip = header->_length * sizeof(uint64_t);
+    bool ok = true;
+    while (ok && skip > 0){
+        size_t n = skip < TLIST_IO_BYTES ? (size_t)skip : TLIST_IO_BYTES;
+        ok = ensure(&reader, n);
+        reader._pos += n;
+        skip -= n;
+    }
+    for (uint64_t i = 0; ok && i < header->_length; i++){
+        uint32_t length;
+        ok = ensure(&reader, sizeof length);
+        if (!ok) break;
+        memcpy(&length, buffer + reader._pos, sizeof length);
+        reader._pos += sizeof length;
+        uint64_t rest = recordSize(length) - sizeof length;
+        char *string;
+        if (rest <= TLIST_IO_BYTES) {
+            ok = ensure(&reader, (size_t)rest);
+            string = (char *)buffer + reader._pos;
+            reader._pos += ok ? (size_t)rest : 0;
+        } else {
+            size_t buffered = reader._end - reader._pos;
+            if (rest > buffered + reader._unread) {
+                fprintf(stderr, "Error in readList(): The image is corrupt.\n");
+                ok = false;
+                break;
+            }
+            string = malloc(rest);
+            if (string == NULL) {
+                fprintf(stderr, "Error in readList(): Failed to allocate memory for a string.\n");
+                exit(EXIT_FAILURE);
+            }
+            memcpy(string, buffer + reader._pos, buffered);
+            reader._pos = reader._end;
+            ok = readAll(fd, string + buffered, rest - buffered);
+            reader._unread -= rest - buffered;
+        }
+        if (ok && string[length] != '\0') {
+            fprintf(stderr, "Error in readList(): The image is corrupt.\n");
+            ok = false;
+        }
+        if (ok) list->methods->pushValue(list, string);
+        if (rest > TLIST_IO_BYTES) free(string);
+    }
+    free(buffer);
+    return ok;
+}
+
+/**
+ * @brief Reads packed numeric values of an image into `list`, one buffer at a time.
+ * @private
+ */
+static bool readValues(List list, int fd, const struct ImageHeader *header){
+    unsigned char *buffer = malloc(TLIST_IO_BYTES);
+    if (buffer == NULL) {
+        fprintf(stderr, "Error in readList(): Failed to allocate the input buffer.\n");
+        exit(EXIT_FAILURE);
+    }
+    size_t capacity = TLIST_IO_BYTES / header->_valueSize;
+    uint64_t remaining = header->_length;
+    bool ok = true;
+    while (ok && remaining > 0){
+        size_t n = remaining < capacity ? (size_t)remaining : capacity;
+        ok = readAll(fd, buffer, n * header->_valueSize);
+        if (ok) pushArray(list, buffer, n);
+        remaining -= n;
+    }
+    free(buffer);
+    return ok;
+}
+
+/** @copydoc readList */
+List readList(int fd, int flags){
+    struct ImageHeader header;
+    if (!readAll(fd, &header, sizeof header) || !checkHeader(&header, "readList")) return NULL;
+    List list = newListWithFlags((Type)header._type, flags);
+    if (list == NULL) return NULL;
+    bool ok = header._type == STRING ? readStrings(list, fd, &header) : readValues(list, fd, &header);
+    if (!ok) {
+        list->methods->free(list);
+        free(list);
+        return NULL;
+    }
+    return list;
+}
+
+/** @copydoc loadList */
+List loadList(const char *path, int flags){
+    if (path == NULL) {
+        fprintf(stderr, "Error in loadList(): The provided path is NULL.\n");
+        return NULL;
+    }
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error in loadList(): Cannot open %s: %s.\n", path, strerror(errno));
+        return NULL;
+    }
+    List list = readList(fd, flags);
+    close(fd);
+    return list;
+}
+
+/* Mapping ----------------------------------------------------------------- */
+
+/** @copydoc releaseImage */
+void releaseImage(List owner, void *image, size_t size){
+    struct VectorStore *store = listStore(owner);
+    // Only the pointer array of a `STRING` image is heap memory; the values are in the mapping.
+    if (owner->_type == STRING) free(store->_data);
+    store->_data = NULL;
+    owner->_length = 0;
+    munmap(image, size);
+}
+
+/**
+ * @brief Builds the pointer array of a mapped `STRING` image, checking every record.
+ * @return The array, or `NULL` if the image is corrupt.
+ * @private
+ */
+static char **indexStrings(const unsigned char *data, const struct ImageHeader *header){
+    char **strings = malloc((header->_length > 0 ? header->_length : 1) * sizeof(char *));
+    if (strings == NULL) {
+        fprintf(stderr, "Error in mmapList(): Failed to allocate memory for the string index.\n");
+        exit(EXIT_FAILURE);
+    }
+    const uint64_t *offsets = (const uint64_t *)data;
+    for (uint64_t i = 0; i < header->_length; i++){
+        uint64_t offset = offsets[i];
+        uint32_t length;
+        bool valid = offset >= header->_length * sizeof(uint64_t) + sizeof length && offset < header->_dataBytes;
+        if (valid) {
+            memcpy(&length, data + offset - sizeof length, sizeof length);
+            valid = length < header->_dataBytes - offset && data[offset + length] == '\0';
+        }
+        if (!valid) {
+            fprintf(stderr, "Error in mmapList(): The image is corrupt.\n");
+            free(strings);
+            return NULL;
+        }
+        strings[i] = (char *)(data + offset);
+    }
+    return strings;
+}
+
+/** @copydoc mmapList */
+List mmapList(const char *path){
+    if (path == NULL) {
+        fprintf(stderr, "Error in mmapList(): The provided path is NULL.\n");
+        return NULL;
+    }
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error in mmapList(): Cannot open %s: %s.\n", path, strerror(errno));
+        return NULL;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(struct ImageHeader)) {
+        fprintf(stderr, "Error in mmapList(): %s is not a list image.\n", path);
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)info.st_size;
+    unsigned char *image = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (image == MAP_FAILED) {
+        fprintf(stderr, "Error in mmapList(): Cannot map %s: %s.\n", path, strerror(errno));
+        return NULL;
+    }
+    struct ImageHeader header;
+    memcpy(&header, image, sizeof header);
+    if (!checkHeader(&header, "mmapList")) {
+        munmap(image, size);
+        return NULL;
+    }
+    if (header._dataBytes != size - sizeof header) {
+        fprintf(stderr, "Error in mmapList(): %s is truncated or has trailing data.\n", path);
+        munmap(image, size);
+        return NULL;
+    }
+    unsigned char *data = image + sizeof header;
+    if (header._type == STRING) {
+        data = (unsigned char *)indexStrings(data, &header);
+        if (data == NULL) {
+            munmap(image, size);
+            return NULL;
+        }
+    }
+    List owner = newListWithFlags((Type)header._type, LIST_VECTOR);
+    if (owner == NULL) {
+        if (header._type == STRING) free(data);
+        munmap(image, size);
+        return NULL;
+    }
+    struct VectorStore *store = listStore(owner);
+    store->_data = data;
+    store->_start = 0;
+    store->_capacity = (int)header._length;
+    owner->_length = (int)header._length;
+    return shareImage(owner, image, size);
+}
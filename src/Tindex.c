@@ -0,0 +1,439 @@
+/**
+ * @file Tindex.c
+ * @brief Value lookup: the optional hash index, `listContains`, `removeValue` and `removeAll`.
+ *
+ * `indexList` attaches to a linked list an open-addressing hash table with
+ * one entry per node, keyed by the node's value. The linked backend keeps it
+ * up to date where nodes are created (`newNode`), unlinked (`unlinkAfter`,
+ * `unlinkNode`) or given a new value (`setValue`), so every method, the
+ * `LIST_SYNC` and copy-on-write wrappers and the free functions built on
+ * them maintain it without knowing about it. Operations that replace the
+ * nodes wholesale (copy-on-write detach, radix sort) call `rebuildIndex`.
+ *
+ * Lookups hash the value and compare it with the entries of the same hash
+ * only, so `listContains`, `listCountOf` and, on `LIST_DOUBLY` lists, `removeAll`
+ * take time proportional to the number of equal elements rather than to the
+ * length of the list. Entries are removed by shifting the following entries
+ * of the probe sequence back, so the table has no tombstones.
+ */
+
+#include "Tlist.h"
+#include "TlistPrivate.h"
+#include <stdint.h>
+
+/**
+ * @struct IndexEntry
+ * @brief A slot of the hash index.
+ * @private
+ */
+typedef struct IndexEntry{
+    Node _node;         /**< Node holding the value, or `NULL` for an empty slot. */
+    size_t _hash;       /**< Hash of the node's value. */
+} IndexEntry;
+
+/**
+ * @struct ValueIndex
+ * @brief Hash index of a linked list, referenced by the list's `_extra->_index`.
+ * @private
+ */
+struct ValueIndex{
+    IndexEntry *_table;
+    size_t _size;           /**< Number of slots, a power of two. */
+    size_t _count;          /**< Number of entries. */
+    Hasher _hash;           /**< Custom hash, or `NULL` for the natural one of the list's type. */
+    Equality _equals;       /**< Custom equality, or `NULL` for the natural one. */
+};
+
+/** Final mixing step of SplitMix64, which spreads every input bit over the hash. @private */
+static size_t mix(uint64_t x){
+    x = (x ^ (x >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+    x = (x ^ (x >> 27)) * UINT64_C(0x94d049bb133111eb);
+    return (size_t)(x ^ (x >> 31));
+}
+
+/**
+ * @brief Hashes a value given in `get` form.
+ *
+ * `0.0` and `-0.0` compare equal, so they hash alike.
+ * @private
+ */
+static size_t hashValue(List this, const void *val){
+    const struct ValueIndex *index = this->_extra->_index;
+    if (index != NULL && index->_hash != NULL) return index->_hash(val);
+    switch (this->_type){
+        case INT:
+            return mix((uint64_t)(unsigned)*(const int *)val);
+        case FLOAT:{
+            float value = *(const float *)val;
+            if (value == 0) value = 0;
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof bits);
+            return mix(bits);
+        }
+        case DOUBLE:{
+            double value = *(const double *)val;
+            if (value == 0) value = 0;
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof bits);
+            return mix(bits);
+        }
+        case STRING:{
+            size_t bytes;
+            return (size_t)hashString(val, &bytes);
+        }
+        default:
+            return mix((uint64_t)(uintptr_t)val);
+    }
+}
+
+/**
+ * @brief Compares two values in `get` form: `==` for numbers, `strcmp` for
+ *        strings and pointer identity for `T`, unless the index has a custom equality.
+ * @private
+ */
+static bool sameValue(List this, const void *a, const void *b){
+    const struct ValueIndex *index = this->_extra->_index;
+    if (index != NULL && index->_equals != NULL) return index->_equals(a, b);
+    switch (this->_type){
+        case INT: return *(const int *)a == *(const int *)b;
+        case FLOAT: return *(const float *)a == *(const float *)b;
+        case DOUBLE: return *(const double *)a == *(const double *)b;
+        case STRING: return a == b || strcmp(a, b) == 0;
+        default: return a == b;
+    }
+}
+
+/** @private */
+static void insertEntry(struct ValueIndex *index, Node node, size_t hash){
+    size_t mask = index->_size - 1;
+    size_t i = hash & mask;
+    while (index->_table[i]._node != NULL) i = (i + 1) & mask;
+    index->_table[i] = (IndexEntry){ node, hash };
+    index->_count++;
+}
+
+/**
+ * @brief Allocates an empty table of `size` slots.
+ * @private
+ */
+static void resetTable(List this, size_t size){
+    struct ValueIndex *index = this->_extra->_index;
+    listFree(this, index->_table);
+    index->_table = listCalloc(this, size, sizeof(IndexEntry));
+    if (index->_table == NULL) {
+        fprintf(stderr, "Error in indexList(): Failed to allocate memory for the index.\n");
+        exit(EXIT_FAILURE);
+    }
+    index->_size = size;
+    index->_count = 0;
+}
+
+/** @private */
+static void growIndex(List this){
+    struct ValueIndex *index = this->_extra->_index;
+    IndexEntry *old = index->_table;
+    size_t oldSize = index->_size;
+    index->_table = NULL;
+    resetTable(this, oldSize * 2);
+    for (size_t i = 0; i < oldSize; i++){
+        if (old[i]._node != NULL) insertEntry(index, old[i]._node, old[i]._hash);
+    }
+    listFree(this, old);
+}
+
+/** @copydoc indexNode */
+void indexNode(List this, Node node){
+    struct ValueIndex *index = this->_extra->_index;
+    // Keep the table at most half full so that probe sequences stay short.
+    if (2 * (index->_count + 1) > index->_size) growIndex(this);
+    insertEntry(index, node, hashValue(this, node->_val));
+}
+
+/** @copydoc unindexNode */
+void unindexNode(List this, Node node){
+    struct ValueIndex *index = this->_extra->_index;
+    size_t mask = index->_size - 1;
+    size_t i = hashValue(this, node->_val) & mask;
+    while (index->_table[i]._node != node){
+        if (index->_table[i]._node == NULL) return;
+        i = (i + 1) & mask;
+    }
+    // Shift back each following entry whose home slot is not between the hole and itself.
+    for (size_t j = (i + 1) & mask; index->_table[j]._node != NULL; j = (j + 1) & mask){
+        size_t home = index->_table[j]._hash & mask;
+        bool stays = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+        if (!stays) {
+            index->_table[i] = index->_table[j];
+            i = j;
+        }
+    }
+    index->_table[i]._node = NULL;
+    index->_count--;
+}
+
+/** @copydoc rebuildIndex */
+void rebuildIndex(List this){
+    struct ValueIndex *index = this->_extra->_index;
+    size_t size = TLIST_INDEX_MIN_TABLE;
+    while (size < 2 * (size_t)this->_length) size *= 2;
+    resetTable(this, size);
+    for (Node node = this->_head; node != NULL; node = node->_nextNode){
+        insertEntry(index, node, hashValue(this, node->_val));
+    }
+}
+
+/** @copydoc releaseIndex */
+void releaseIndex(List this){
+    struct ValueIndex *index = this->_extra->_index;
+    if (index == NULL) return;
+    listFree(this, index->_table);
+    listFree(this, index);
+    this->_extra->_index = NULL;
+}
+
+/**
+ * @brief Counts up to `limit` entries equal to `val` and returns one of them in `match`.
+ *
+ * Entries are visited in probe order, so `match` is not necessarily the first in list order.
+ * @private
+ */
+static size_t findEntries(List this, const void *val, size_t limit, Node *match){
+    struct ValueIndex *index = this->_extra->_index;
+    size_t hash = hashValue(this, val);
+    size_t mask = index->_size - 1;
+    size_t count = 0;
+    *match = NULL;
+    for (size_t i = hash & mask; index->_table[i]._node != NULL && count < limit; i = (i + 1) & mask){
+        IndexEntry *entry = &index->_table[i];
+        if (entry->_hash == hash && sameValue(this, entry->_node->_val, val)) {
+            if (count++ == 0) *match = entry->_node;
+        }
+    }
+    return count;
+}
+
+/** @copydoc indexMatches */
+size_t indexMatches(List this, const void *val, size_t limit, size_t *first){
+    Node match;
+    size_t count = findEntries(this, val, limit, &match);
+    if (count > 0 && first != NULL) {
+        size_t position = 0;
+        for (Node node = this->_head; !sameValue(this, node->_val, val); node = node->_nextNode){
+            position++;
+        }
+        *first = position;
+    }
+    return count;
+}
+
+/* Public functions -------------------------------------------------------- */
+
+/** @copydoc indexList */
+bool indexList(List this, Hasher hash, Equality equals){
+    if (this == NULL) {
+        fprintf(stderr, "Error in indexList(): The provided list instance is NULL.\n");
+        return false;
+    }
+    if (this->_flags & (LIST_UNROLLED | LIST_VECTOR | LIST_QUEUE)) {
+        fprintf(stderr, "Error in indexList(): Only linked lists can be indexed.\n");
+        return false;
+    }
+    if ((hash == NULL) != (equals == NULL)) {
+        fprintf(stderr, "Error in indexList(): A custom hash needs a matching equality, and vice versa.\n");
+        return false;
+    }
+    if (this->_type == T && hash == NULL) {
+        fprintf(stderr, "Error in indexList(): Lists of type T need a hash and an equality function.\n");
+        return false;
+    }
+    if (!listLock(this, true)) return false;
+    if (this->_extra->_index == NULL) {
+        struct ValueIndex *index = listCalloc(this, 1, sizeof(struct ValueIndex));
+        if (index == NULL) {
+            fprintf(stderr, "Error in indexList(): Failed to allocate memory for the index.\n");
+            exit(EXIT_FAILURE);
+        }
+        listExtra(this)->_index = index;
+    }
+    this->_extra->_index->_hash = hash;
+    this->_extra->_index->_equals = equals;
+    rebuildIndex(this);
+    listUnlock(this);
+    return true;
+}
+
+/** @copydoc dropIndex */
+void dropIndex(List this){
+    if (this == NULL) {
+        fprintf(stderr, "Error in dropIndex(): The provided list instance is NULL.\n");
+        return;
+    }
+    if (!listLock(this, true)) return;
+    releaseIndex(this);
+    listUnlock(this);
+}
+
+/** @copydoc listContains */
+bool listContains(List this, ...){
+    if (this == NULL) {
+        fprintf(stderr, "Error in listContains(): The provided list instance is NULL.\n");
+        return false;
+    }
+    va_list args;
+    va_start(args, this);
+    Scalar tmp;
+    void *val = readArg(this, &args, &tmp);
+    va_end(args);
+    return countValue(this, val, 1) > 0;
+}
+
+/**
+ * @struct Matches
+ * @brief Positions of the elements equal to a value, collected by `collectMatches`.
+ * @private
+ */
+typedef struct Matches{
+    List _list;
+    const void *_value;
+    int *_positions;
+    int _count;
+    int _capacity;
+    int _limit;
+    int _offset;        /**< Index of the segment's first element. */
+} Matches;
+
+/** @private */
+static bool collectMatches(const void *data, size_t n, void *context){
+    Matches *m = context;
+    List list = m->_list;
+    for (size_t i = 0; i < n && m->_count < m->_limit; i++){
+        unsigned char *slot = (unsigned char *)data + i * list->_size;
+        if (!sameValue(list, slotValue(list, slot), m->_value)) continue;
+        if (m->_count == m->_capacity) {
+            int capacity = m->_capacity == 0 ? 16 : m->_capacity * 2;
+            m->_positions = listRealloc(list, m->_positions, (size_t)m->_capacity * sizeof(int), (size_t)capacity * sizeof(int));
+            if (m->_positions == NULL) {
+                fprintf(stderr, "Error in removeAll(): Memory allocation failed.\n");
+                exit(EXIT_FAILURE);
+            }
+            m->_capacity = capacity;
+        }
+        m->_positions[m->_count++] = m->_offset + (int)i;
+    }
+    m->_offset += (int)n;
+    return m->_count < m->_limit;
+}
+
+/**
+ * @brief Removes up to `limit` elements equal to `val` from a `LIST_VECTOR` list in one pass.
+ * @private
+ */
+static int compactVector(List this, const void *val, int limit){
+    struct VectorStore *store = listStore(this);
+    unsigned char *base = store->_data + (size_t)store->_start * this->_size;
+    int kept = 0;
+    int removed = 0;
+    for (int i = 0; i < this->_length; i++){
+        unsigned char *slot = base + (size_t)i * this->_size;
+        if (removed < limit && sameValue(this, slotValue(this, slot), val)) {
+            if (this->_type == STRING) releaseString(this, *(char **)slot);
+            removed++;
+        } else {
+            if (kept != i) memcpy(base + (size_t)kept * this->_size, slot, this->_size);
+            kept++;
+        }
+    }
+    this->_length = kept;
+    return removed;
+}
+
+/**
+ * @brief Removes up to `limit` elements equal to `val` (in `readArg` form), first ones first.
+ * @return The number of elements removed.
+ * @private
+ */
+static int removeMatches(List this, void *val, int limit, const char *function){
+    if (this == NULL) {
+        fprintf(stderr, "Error in %s(): The provided list instance is NULL.\n", function);
+        return 0;
+    }
+    if (this->_flags & LIST_QUEUE) {
+        fprintf(stderr, "Error in %s(): Not supported by LIST_QUEUE lists.\n", function);
+        return 0;
+    }
+    if (this->_type == STRING && val == NULL) return 0;
+    if (!listLock(this, true)) return 0;
+    unshare(this);
+    int removed = 0;
+    Node match = NULL;
+    // Looking for two matches tells whether a single removal takes the only one.
+    size_t matches = this->_extra->_index == NULL ? 0 : findEntries(this, val, limit == 1 ? 2 : (size_t)limit, &match);
+    if (this->_extra->_index != NULL && matches == 0) {
+        // Not in the list.
+    } else if (this->_flags & LIST_VECTOR) {
+        removed = compactVector(this, val, limit);
+    } else if (this->_flags & LIST_UNROLLED) {
+        Matches m = { ._list = this, ._value = val, ._limit = limit };
+        forEachSegment(this, collectMatches, &m);
+        // Last first, so that the earlier positions stay valid.
+        for (int i = m._count - 1; i >= 0; i--){
+            this->methods->remove(this, m._positions[i]);
+        }
+        removed = m._count;
+        listFree(this, m._positions);
+    } else if (this->_extra->_index != NULL && (this->_flags & LIST_DOUBLY) && (size_t)limit >= matches) {
+        // Every match goes, so their order does not matter and the index finds them all.
+        while (removed < limit && findEntries(this, val, 1, &match) == 1){
+            unlinkNode(this, match);
+            releaseValue(this, match);
+            releaseNode(this, match);
+            removed++;
+        }
+    } else {
+        Node prev = NULL;
+        int index = 0;
+        for (Node node = this->_head; node != NULL && removed < limit;){
+            Node next = node->_nextNode;
+            if (sameValue(this, node->_val, val)) {
+                unlinkAfter(this, prev, index);
+                releaseValue(this, node);
+                releaseNode(this, node);
+                removed++;
+            } else {
+                prev = node;
+                index++;
+            }
+            node = next;
+        }
+    }
+    listUnlock(this);
+    return removed;
+}
+
+/** @copydoc removeValue */
+bool removeValue(List this, ...){
+    if (this == NULL) {
+        fprintf(stderr, "Error in removeValue(): The provided list instance is NULL.\n");
+        return false;
+    }
+    va_list args;
+    va_start(args, this);
+    Scalar tmp;
+    void *val = readArg(this, &args, &tmp);
+    va_end(args);
+    return removeMatches(this, val, 1, "removeValue") == 1;
+}
+
+/** @copydoc removeAll */
+int removeAll(List this, ...){
+    if (this == NULL) {
+        fprintf(stderr, "Error in removeAll(): The provided list instance is NULL.\n");
+        return 0;
+    }
+    va_list args;
+    va_start(args, this);
+    Scalar tmp;
+    void *val = readArg(this, &args, &tmp);
+    va_end(args);
+    return removeMatches(this, val, INT_MAX, "removeAll");
+}
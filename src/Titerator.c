@@ -1,6 +1,17 @@
 #include "Tlist.h"
 #include "TlistPrivate.h"
 
+/**
+ * @brief `free` method of iterators allocated through their list's `TAllocator`.
+ *
+ * Other iterators use `freeIterator`, which does not read the list, so that
+ * they may still be freed after it.
+ * @private
+ */
+static void releaseAllocated(TIterator iterator){
+    listFree(iterator->_list, iterator);
+}
+
 /**
  * @brief Creates a new iterator for the given list.
  *
@@ -14,24 +25,131 @@
  *          the program will exit with `EXIT_FAILURE`.
  */
 TIterator newIterator(List list){
-    TIterator iterator = malloc(sizeof(struct TIterator));
+    struct TIterator state = iteratorOf(list);
+    TIterator iterator = listAlloc(list, sizeof(struct TIterator));
     if(iterator == NULL) {
         fprintf(stderr, "Error in newIterator(): Failed to allocate memory for the new iterator.\n");
         exit(EXIT_FAILURE);
     }
+    *iterator = state;
+    iterator->free = list->_extra->_allocator == NULL ? freeIterator : releaseAllocated;
+    return iterator;
+}
+
+/**
+ * @brief `free` method of iterators returned by `iteratorOf`, which own no memory.
+ * @private
+ */
+static void releaseIterator(TIterator iterator){
+    (void)iterator;
+}
+
+/** @copydoc iteratorOf */
+struct TIterator iteratorOf(List list){
     if (list == NULL) {
         fprintf(stderr, "Error in newIterator(): The provided list instance is NULL.\n");
         exit(EXIT_FAILURE);
     }
-    iterator->_list = list;
-    iterator->_current = list->_head;
-    iterator->_index = 0;
-    iterator->next = next;
-    iterator->hasNext = hasNext;
-    iterator->free = freeIterator;
+    struct TIterator iterator = {
+        ._current = list->_head,
+        ._chunk = NULL,
+        ._offset = 0,
+        ._list = list,
+        ._index = 0,
+        ._reverse = false,
+        .next = linkedNext,
+        .hasNext = linkedHasNext,
+        .free = releaseIterator,
+    };
+    if (list->_flags & LIST_UNROLLED) {
+        iterator._chunk = ((struct UnrolledStore *)listStore(list))->_first;
+        iterator.next = unrolledNext;
+        iterator.hasNext = unrolledHasNext;
+    }
+    if (list->_flags & LIST_VECTOR) {
+        iterator.next = vectorNext;
+        iterator.hasNext = vectorHasNext;
+    }
+    if (list->_flags & LIST_QUEUE) {
+        iterator._current = queueFirst(list);
+    }
     return iterator;
 }
 
+/**
+ * @brief `next` of reverse iterators over `LIST_DOUBLY` lists.
+ * @private
+ */
+static void *reverseNext(TIterator iterator){
+    if (iterator == NULL || iterator->_current == NULL) {
+        fprintf(stderr, "Error in next(): No more elements to iterate or invalid iterator.\n");
+        return NULL;
+    }
+    void *val = iterator->_current->_val;
+    iterator->_index--;
+    iterator->_current = PREV_NODE(iterator->_current);
+    return val;
+}
+
+/** @copydoc reverseIteratorOf */
+struct TIterator reverseIteratorOf(List list){
+    struct TIterator iterator = iteratorOf(list);
+    iterator._reverse = true;
+    iterator._current = NULL;
+    iterator._chunk = NULL;
+    iterator._index = list->_length - 1;
+    if (list->_flags & LIST_DOUBLY) {
+        iterator._current = list->_tail;
+        iterator.next = reverseNext;
+    } else if (list->_flags & LIST_VECTOR) {
+        iterator.next = vectorPrev;
+        iterator.hasNext = vectorHasPrev;
+    } else {
+        fprintf(stderr, "Error in newReverseIterator(): Only LIST_DOUBLY and LIST_VECTOR lists can be iterated in reverse.\n");
+        iterator._index = -1;
+        iterator.next = linkedNext;
+        iterator.hasNext = linkedHasNext;
+    }
+    return iterator;
+}
+
+/** @copydoc newReverseIterator */
+TIterator newReverseIterator(List list){
+    struct TIterator state = reverseIteratorOf(list);
+    TIterator iterator = listAlloc(list, sizeof(struct TIterator));
+    if(iterator == NULL) {
+        fprintf(stderr, "Error in newReverseIterator(): Failed to allocate memory for the new iterator.\n");
+        exit(EXIT_FAILURE);
+    }
+    *iterator = state;
+    iterator->free = list->_extra->_allocator == NULL ? freeIterator : releaseAllocated;
+    return iterator;
+}
+
+/** @copydoc nextBatch */
+size_t nextBatch(TIterator iterator, void **out, size_t max){
+    if (iterator == NULL || out == NULL) {
+        fprintf(stderr, "Error in nextBatch(): The iterator and the output array must not be NULL.\n");
+        return 0;
+    }
+    if (iterator->_reverse) {
+        size_t n = 0;
+        while (n < max && iterator->hasNext(iterator)) out[n++] = iterator->next(iterator);
+        return n;
+    }
+    if (iterator->_list->_flags & LIST_UNROLLED) return unrolledNextBatch(iterator, out, max);
+    if (iterator->_list->_flags & LIST_VECTOR) return vectorNextBatch(iterator, out, max);
+    size_t n = 0;
+    Node current = iterator->_current;
+    while (n < max && current != NULL){
+        out[n++] = current->_val;
+        current = current->_nextNode;
+    }
+    iterator->_current = current;
+    iterator->_index += (int)n;
+    return n;
+}
+
 /**
  * @brief Returns the next element in the iteration.
  *
@@ -40,7 +158,7 @@ TIterator newIterator(List list){
  * @param iterator A pointer to the iterator.
  * @return A pointer to the next element's value, or `NULL` if the end is reached or the iterator is invalid.
  */
-void* next(TIterator iterator){
+void* linkedNext(TIterator iterator){
     if (iterator == NULL || iterator->_current == NULL) {
         fprintf(stderr, "Error in next(): No more elements to iterate or invalid iterator.\n");
         return NULL;
@@ -57,7 +175,7 @@ void* next(TIterator iterator){
  * @param iterator A pointer to the iterator.
  * @return `true` if there is at least one more element to iterate over, `false` otherwise.
  */
-bool hasNext(TIterator iterator){
+bool linkedHasNext(TIterator iterator){
     if (iterator == NULL) {
         return false;
     }
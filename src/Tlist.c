@@ -5,7 +5,7 @@
  *
  * Tlist is a simple singly linked list implementation in C, designed to be
  * type-flexible and type-safe. It uses an object-oriented approach in C,
- * where the list structure contains pointers to its own functions (methods).
+ * where each list points at a shared table of its functions (methods).
  *
  * The list can be configured at creation time to store different data types,
  * managing memory appropriately for each type.
@@ -17,7 +17,7 @@
  *   - `DOUBLE`: Stores copies of double-precision floating-point values.
  *   - `STRING`: Stores copies of C strings (char*).
  *   - `T`: Stores generic pointers (`void*`), leaving memory management of the data to the user.
- * - **Object-Oriented Interface:** Interact with the list through its methods, such as `list->push(list, data)`.
+ * - **Object-Oriented Interface:** Interact with the list through its methods, such as `list->methods->push(list, data)`.
  * - **Memory Management:** The library manages memory allocation and deallocation for primitive types and strings.
  *
  * @section usage_sec Usage Example
@@ -32,14 +32,14 @@
  *     List l = newList(INT);
  *
  *     // Adds elements
- *     l->push(l, 10);
- *     l->push(l, 20);
+ *     l->methods->push(l, 10);
+ *     l->methods->push(l, 20);
  *
  *     // Prints the list
- *     l->print(l); // Output: [10, 20]
+ *     listPrint(l); // Output: [10, 20]
  *
  *     // Frees the list nodes
- *     l->free(l);
+ *     listDestroy(l);
  *     // Frees the list structure
  *     free(l);
  *
@@ -59,10 +59,81 @@
 #include "Tlist.h"
 #include "TlistPrivate.h"
 
+/**
+ * @brief Methods of linked lists, one table per `Type`.
+ * @private
+ */
+static const struct ListMethods linkedMethods[TLIST_TYPES] = LIST_METHODS(
+    .pop = linkedPop,
+    .print = linkedPrint,
+    .len = listLength,
+    .free = destroyList,
+    .get = linkedGet,
+    .remove = linkedDelete,
+    .pick = linkedPick,
+    .foreach = linkedForeach,
+    .pushValue = pushValue,
+    .insertValue = insertValue,
+    .setValue = setValue,
+    .popValue = popValue,
+    .insertArray = insertValues,
+);
 
 /** @copydoc newList */
 List newList(Type type){
-    List this = (List)malloc(sizeof(struct Lista));
+    return newListWithFlags(type, LIST_DEFAULT);
+}
+
+/** @copydoc storeSize */
+size_t storeSize(int flags){
+    if (flags & LIST_UNROLLED) return sizeof(struct UnrolledStore);
+    if (flags & LIST_VECTOR) return sizeof(struct VectorStore);
+    if (flags & LIST_QUEUE) return sizeof(struct QueueStore);
+    if (flags & LIST_SLAB) return sizeof(struct NodePool);
+    return 0;
+}
+
+/**
+ * @brief Creates a list, as `newListWithFlags` does, that allocates through `allocator`.
+ *
+ * @param hidden Whether the list is internal to the library (the owner of
+ *        shared storage), in which case the `struct Lista` itself also comes
+ *        from the allocator and is released with `freeHiddenList`.
+ * @private
+ */
+static List createList(Type type, int flags, const TAllocator *allocator, bool hidden){
+    if (type != INT && type != FLOAT && type != DOUBLE && type != STRING && type != T) {
+        fprintf(stderr, "Error in newList(): Unknown list type %d.\n", (int)type);
+        return NULL;
+    }
+    int backends = flags & (LIST_UNROLLED | LIST_VECTOR | LIST_QUEUE);
+    if (backends & (backends - 1)) {
+        fprintf(stderr, "Error in newList(): LIST_UNROLLED, LIST_VECTOR and LIST_QUEUE cannot be combined.\n");
+        return NULL;
+    }
+    if ((flags & LIST_SYNC) && (flags & LIST_QUEUE)) {
+        fprintf(stderr, "Error in newList(): LIST_QUEUE lists are already thread-safe and cannot use LIST_SYNC.\n");
+        return NULL;
+    }
+    // Backend state shares the list's allocation so that `free(list)` releases everything.
+    if (backends) flags &= ~(LIST_SLAB | LIST_DOUBLY);
+    if (flags & LIST_INTERN) flags |= LIST_ARENA;
+    if (type != STRING || (flags & LIST_QUEUE)) flags &= ~(LIST_ARENA | LIST_INTERN);
+    size_t bytes = sizeof(struct Lista) + storeSize(flags);
+    // Lists that need a `struct ListExtra` from the start carry it in their own allocation.
+    bool extra = allocator != NULL || (flags & LIST_SYNC);
+#ifdef TLIST_STATS
+    extra = true;
+#endif
+    size_t extraOffset = (bytes + _Alignof(struct ListExtra) - 1) / _Alignof(struct ListExtra) * _Alignof(struct ListExtra);
+    if (extra) bytes = extraOffset + sizeof(struct ListExtra);
+    size_t syncOffset = (bytes + _Alignof(max_align_t) - 1) / _Alignof(max_align_t) * _Alignof(max_align_t);
+    if (flags & LIST_SYNC) bytes = syncOffset + syncStoreSize();
+#ifdef TLIST_STATS
+    size_t statsOffset = (bytes + _Alignof(max_align_t) - 1) / _Alignof(max_align_t) * _Alignof(max_align_t);
+    bytes = statsOffset + statsStoreSize();
+#endif
+    List this = (List)(hidden && allocator != NULL ? allocator->alloc(allocator->context, bytes) : malloc(bytes));
     if(this == NULL) {
         fprintf(stderr, "Error in newList(): Failed to allocate memory for the new list.\n");
         exit(EXIT_FAILURE);
@@ -71,19 +142,24 @@ List newList(Type type){
     this->_tail = NULL;
     this->_type = type;
     this->_length = 0;
+    this->_flags = flags;
+    this->_extra = (struct ListExtra *)&noExtra;
+    if (extra) {
+        this->_extra = (struct ListExtra *)((unsigned char *)this + extraOffset);
+        *this->_extra = noExtra;
+        this->_extra->_allocator = allocator;
+    }
+    this->_cursor = NULL;
+    this->_cursorIndex = 0;
 
-    // list methods
-    this->print = print;
-    this->free = destroyList;
-    this->push = push;
-    this->pop = pop;
-    this->len = len;
-    this->get = get;
-    this->set = set;
-    this->remove = delete;
-    this->insert = insert;
-    this->pick = pick;
-    this->foreach = foreach;
+    if (flags & LIST_SLAB) {
+        NodePool pool = listPool(this);
+        pool->_blocks = NULL;
+        pool->_freeNodes = NULL;
+        pool->_nextCapacity = TLIST_SLAB_MIN_BLOCK;
+    }
+
+    setMethods(this, &linkedMethods[type]);
 
     switch(type){
         case INT:
@@ -98,58 +174,523 @@ List newList(Type type){
         case FLOAT:
             this->_size = sizeof(float);
             break;
-        case T:
+        default:
             this->_size = sizeof(void *);
             break;
     }
 
+    // Value types are stored inside the node; T values and arena strings need no extra space.
+    size_t inlineSize = 0;
+    if (type == STRING) inlineSize = flags & LIST_ARENA ? 0 : TLIST_INLINE_STRING;
+    else if (type != T) inlineSize = this->_size;
+    size_t align = _Alignof(struct Node);
+    this->_nodeSize = (unsigned short)((NODE_PREFIX(this) + sizeof(struct Node) + inlineSize + align - 1) / align * align);
+
+    if (flags & LIST_UNROLLED) {
+        initUnrolled(this, (struct UnrolledStore *)(this + 1));
+    }
+    if (flags & LIST_VECTOR) {
+        initVector(this, (struct VectorStore *)(this + 1));
+    }
+    if (flags & LIST_QUEUE) {
+        initQueue(this, (struct QueueStore *)(this + 1));
+    }
+    if (flags & LIST_SYNC) {
+        initSync(this, (unsigned char *)this + syncOffset);
+    }
+#ifdef TLIST_STATS
+    initStats(this, (unsigned char *)this + statsOffset);
+#endif
+
     return this;
 }
 
+/** @copydoc newListWithFlags */
+List newListWithFlags(Type type, int flags){
+    return createList(type, flags, NULL, false);
+}
+
+/** @copydoc newListWithAllocator */
+List newListWithAllocator(Type type, const TAllocator *allocator){
+    return newListWithFlagsAndAllocator(type, LIST_DEFAULT, allocator);
+}
+
+/** @copydoc newListWithFlagsAndAllocator */
+List newListWithFlagsAndAllocator(Type type, int flags, const TAllocator *allocator){
+    if (allocator != NULL && (allocator->alloc == NULL || allocator->realloc == NULL || allocator->free == NULL)) {
+        fprintf(stderr, "Error in newListWithAllocator(): The allocator must provide alloc, realloc and free.\n");
+        return NULL;
+    }
+    if (allocator != NULL && (flags & LIST_QUEUE)) {
+        fprintf(stderr, "Error in newListWithAllocator(): LIST_QUEUE lists free their nodes with free() and cannot use an allocator.\n");
+        return NULL;
+    }
+    return createList(type, flags, allocator, false);
+}
+
+/** @copydoc deriveList */
+List deriveList(List this, Type type, int flags){
+    return createList(type, flags, this->_extra->_allocator, false);
+}
+
+/** @copydoc hiddenList */
+List hiddenList(List this, int flags){
+    return createList(this->_type, flags, this->_extra->_allocator, true);
+}
+
+/** @copydoc freeHiddenList */
+void freeHiddenList(List this){
+    releaseExtra(this);
+    listFree(this, this);
+}
+
+const struct ListExtra noExtra = { ._allocated = false };
+
+/** @copydoc ownExtra */
+struct ListExtra *ownExtra(List this){
+    struct ListExtra *extra = listAlloc(this, sizeof(struct ListExtra));
+    if (extra == NULL) {
+        fprintf(stderr, "Error in ownExtra(): Failed to allocate memory for the list state.\n");
+        exit(EXIT_FAILURE);
+    }
+    *extra = noExtra;
+    extra->_allocated = true;
+    this->_extra = extra;
+    return extra;
+}
+
+/** @copydoc releaseExtra */
+void releaseExtra(List this){
+    if (!this->_extra->_allocated) return;
+    listFree(this, this->_extra);
+    this->_extra = (struct ListExtra *)&noExtra;
+}
+
 /**
- * @brief Creates a new list node and allocates memory for its value.
+ * @brief Obtains storage for a single node.
  *
- * For `INT`, `FLOAT`, and `DOUBLE`, it allocates `size` bytes and copies the value.
- * For `STRING`, it allocates memory for a new string and copies the content.
- * For `T`, it does not allocate memory for the value but stores the pointer `val` directly.
+ * For `LIST_SLAB` lists, a recycled node is reused when available; otherwise
+ * the next node is carved from the current block, allocating a new block
+ * (twice the size of the previous one, up to `TLIST_SLAB_MAX_BLOCK`) when the
+ * current one is exhausted. Other lists allocate each node on its own. Memory
+ * comes from the list's allocator, `malloc` by default.
  *
+ * @param this The list that will own the node.
+ * @return Uninitialized storage for one node.
+ * @private
+ */
+Node allocNode(List this){
+    NodePool pool = listPool(this);
+    if (pool == NULL) {
+        unsigned char *memory = listAlloc(this, this->_nodeSize);
+        if(memory == NULL) {
+            fprintf(stderr, "Error in newNode(): Failed to allocate memory for a new node.\n");
+            exit(EXIT_FAILURE);
+        }
+        STAT_MEMORY(this, this->_nodeSize, 0, 1, 0);
+        return (Node)(memory + NODE_PREFIX(this));
+    }
+    if (pool->_freeNodes != NULL) {
+        Node node = pool->_freeNodes;
+        pool->_freeNodes = node->_nextNode;
+        return node;
+    }
+    struct NodeBlock *block = pool->_blocks;
+    if (block == NULL || block->_used == block->_capacity) {
+        block = (struct NodeBlock *)listAlloc(this, sizeof(struct NodeBlock) + pool->_nextCapacity * this->_nodeSize);
+        if (block == NULL) {
+            fprintf(stderr, "Error in newNode(): Failed to allocate memory for a new node block.\n");
+            exit(EXIT_FAILURE);
+        }
+        STAT_MEMORY(this, sizeof(struct NodeBlock) + pool->_nextCapacity * this->_nodeSize, 0, 1, 0);
+        block->_capacity = pool->_nextCapacity;
+        block->_used = 0;
+        block->_nextBlock = pool->_blocks;
+        pool->_blocks = block;
+        if (pool->_nextCapacity < TLIST_SLAB_MAX_BLOCK) {
+            pool->_nextCapacity *= 2;
+        }
+    }
+    return (Node)(block->_storage + this->_nodeSize * block->_used++ + NODE_PREFIX(this));
+}
+
+/**
+ * @brief Releases the storage of a node that has been unlinked from the list.
+ *
+ * For `LIST_SLAB` lists the node is pushed on the pool's free list for reuse;
+ * otherwise it is passed to `free`. The node's value is not released.
+ *
+ * @param this The list that owns the node.
+ * @param node The node to release.
+ * @private
+ */
+void releaseNode(List this, Node node){
+    NodePool pool = listPool(this);
+    if (pool == NULL) {
+        listFree(this, (unsigned char *)node - NODE_PREFIX(this));
+        STAT_MEMORY(this, -(long long)this->_nodeSize, 0, 0, 1);
+        return;
+    }
+    node->_nextNode = pool->_freeNodes;
+    pool->_freeNodes = node;
+}
+
+/**
+ * @brief Creates a new list node holding a copy of a value.
+ *
+ * The node itself is obtained through `allocNode` and the value is stored with
+ * `storeValue`: `INT`, `FLOAT`, `DOUBLE` and short `STRING` values are copied
+ * into the node, longer strings are copied to the heap, and `T` pointers are
+ * stored directly.
+ *
+ * @param this The list that will own the node.
  * @param val A pointer to the value to be stored in the node.
- * @param size The size of the data type (for value types).
- * @param type The `Type` of the data.
  * @return A pointer to the newly created `Node`.
  * @private
  */
-Node newNode(void *val, size_t size, Type type){
-    Node node = (Node)malloc(sizeof(struct Node));    
-    if(node == NULL) {
-        fprintf(stderr, "Error in newNode(): Failed to allocate memory for a new node.\n");
+Node newNode(List this, void *val){
+    Node node = allocNode(this);
+    node->_val = NULL;
+    storeValue(this, node, val);
+    node->_nextNode = NULL;
+    if (this->_extra->_index != NULL) indexNode(this, node);
+    return node;
+}
+
+/**
+ * @brief Stores a value in a node, replacing the node's previous value.
+ *
+ * For `STRING`, strings that fit in `TLIST_INLINE_STRING` bytes are copied into
+ * the node and longer ones into a new heap allocation; a previous heap string
+ * is freed after the copy, so `val` may alias the current value. `LIST_ARENA`
+ * lists store every string in their arena instead.
+ * For `T`, the pointer `val` is stored directly.
+ *
+ * @param this The list that owns the node.
+ * @param node The node to update. Its `_val` must be `NULL` or a valid value.
+ * @param val A pointer to the value to store.
+ * @private
+ */
+void storeValue(List this, Node node, void *val){
+    switch (this->_type){
+        case T:
+            node->_val = val;
+            break;
+        case STRING:{
+            if (val == NULL) {
+                fprintf(stderr, "Error in newNode(): Cannot create a STRING node from a NULL pointer.\n");
+                exit(EXIT_FAILURE);
+            }
+            if (this->_flags & LIST_ARENA) {
+                node->_val = arenaString(this, val);
+                break;
+            }
+            void *old = (node->_val != NULL && !NODE_INLINE(node)) ? node->_val : NULL;
+            size_t bytes = strlen((char *)val) + 1;
+            if (bytes <= TLIST_INLINE_STRING) {
+                memmove(node->_data, val, bytes);
+                node->_val = node->_data;
+            } else {
+                node->_val = listAlloc(this, bytes);
+                if (node->_val == NULL) {
+                    fprintf(stderr, "Error in newNode(): Failed to allocate memory for the node's string value.\n");
+                    exit(EXIT_FAILURE);
+                }
+                STAT_MEMORY(this, 0, bytes, 1, 0);
+                memcpy(node->_val, val, bytes);
+            }
+            if (old != NULL) releaseString(this, old);
+            break;
+        }
+        default:
+            memcpy(node->_data, val, this->_size);
+            node->_val = node->_data;
+            break;
+    }
+}
+
+/**
+ * @brief Makes sure a `LIST_SLAB` pool can hand out `n` nodes with at most one new block.
+ *
+ * Counts the recycled nodes and the room left in the current block, and
+ * allocates a single block for the shortfall.
+ * @param this The list that will own the nodes.
+ * @param n The number of nodes about to be allocated.
+ * @private
+ */
+static void reserveNodes(List this, size_t n){
+    NodePool pool = listPool(this);
+    size_t available = 0;
+    for (Node node = pool->_freeNodes; node != NULL && available < n; node = node->_nextNode){
+        available++;
+    }
+    if (pool->_blocks != NULL) {
+        available += pool->_blocks->_capacity - pool->_blocks->_used;
+    }
+    if (available >= n) {
+        return;
+    }
+    size_t capacity = n - available;
+    if (capacity < pool->_nextCapacity) capacity = pool->_nextCapacity;
+    struct NodeBlock *block = (struct NodeBlock *)listAlloc(this, sizeof(struct NodeBlock) + capacity * this->_nodeSize);
+    if (block == NULL) {
+        fprintf(stderr, "Error in newNode(): Failed to allocate memory for a new node block.\n");
         exit(EXIT_FAILURE);
     }
-    if (type == STRING) {
-        if (val == NULL) {
-            fprintf(stderr, "Error in newNode(): Cannot create a STRING node from a NULL pointer.\n");
-            exit(EXIT_FAILURE);
+    STAT_MEMORY(this, sizeof(struct NodeBlock) + capacity * this->_nodeSize, 0, 1, 0);
+    block->_capacity = capacity;
+    block->_used = 0;
+    // Leftover room in the current block is handed back through the free list.
+    if (pool->_blocks != NULL) {
+        struct NodeBlock *old = pool->_blocks;
+        while (old->_used < old->_capacity){
+            releaseNode(this, (Node)(old->_storage + this->_nodeSize * old->_used++ + NODE_PREFIX(this)));
         }
-        node->_val = malloc(strlen((char *)val) + 1);
-        if (node->_val == NULL) {
-            fprintf(stderr, "Error in newNode(): Failed to allocate memory for the node's string value.\n");
-            exit(EXIT_FAILURE);
+    }
+    block->_nextBlock = pool->_blocks;
+    pool->_blocks = block;
+}
+
+/**
+ * @brief Frees a node's value when it is a heap allocation owned by the list.
+ *
+ * Only long `STRING` values live outside the node; `T` pointers belong to the caller,
+ * and arena strings to the arena.
+ * @param this The list that owns the node.
+ * @param node The node whose value is released.
+ * @private
+ */
+void releaseValue(List this, Node node){
+    if (this->_type != T && !NODE_INLINE(node)) {
+        releaseString(this, node->_val);
+    }
+}
+
+/**
+ * @brief Returns a node's value as a pointer the caller owns.
+ *
+ * Values stored inline or in an arena are copied to a new heap allocation,
+ * since the node is about to be released. Heap strings and `T` pointers are
+ * returned as is, except that strings from a `TAllocator` are copied with
+ * `malloc` and released, since the caller frees the result with `free`.
+ * @param this The list that owns the node.
+ * @param node The node being removed.
+ * @return A caller-owned pointer to the value.
+ * @private
+ */
+void *detachValue(List this, Node node){
+    if (this->_type == T) {
+        return node->_val;
+    }
+    bool heap = !NODE_INLINE(node) && !(this->_flags & LIST_ARENA);
+    if (heap && this->_extra->_allocator == NULL) {
+        STAT_MEMORY(this, 0, -(long long)(strlen(node->_val) + 1), 0, 0);
+        return node->_val;
+    }
+    size_t bytes = this->_type == STRING ? strlen((char *)node->_val) + 1 : this->_size;
+    void *copy = malloc(bytes);
+    if (copy == NULL) {
+        fprintf(stderr, "Error in pop(): Failed to allocate memory for the returned value.\n");
+        exit(EXIT_FAILURE);
+    }
+    STAT_MEMORY(this, 0, 0, 1, 0);
+    memcpy(copy, node->_val, bytes);
+    // The caller frees the value with `free`, so an allocator's copy cannot be handed out.
+    if (heap) releaseString(this, node->_val);
+    return copy;
+}
+
+/**
+ * @brief Reads the next variadic argument according to the list's type.
+ *
+ * `FLOAT` arguments are read as `double` (default argument promotion) and narrowed.
+ * @param this A pointer to the list.
+ * @param args The argument list, positioned on the value.
+ * @param tmp Storage for value types.
+ * @return The address of the value for value types, the pointer itself for `STRING` and `T`.
+ * @private
+ */
+void *readArg(List this, va_list *args, Scalar *tmp){
+    switch (this->_type){
+        case INT:
+            tmp->_int = va_arg(*args, int);
+            return &tmp->_int;
+        case FLOAT:
+            tmp->_float = (float)va_arg(*args, double);
+            return &tmp->_float;
+        case DOUBLE:
+            tmp->_double = va_arg(*args, double);
+            return &tmp->_double;
+        default:
+            tmp->_ptr = va_arg(*args, void *);
+            return tmp->_ptr;
+    }
+}
+
+/**
+ * @brief Converts a slot of an array-based backend into the value returned by `get`.
+ *
+ * `INT`, `FLOAT` and `DOUBLE` slots hold the value itself, `STRING` slots an owned
+ * heap copy and `T` slots the user's pointer.
+ * @private
+ */
+void *slotValue(List this, unsigned char *slot){
+    if (this->_type == STRING || this->_type == T) {
+        return *(void **)slot;
+    }
+    return slot;
+}
+
+/**
+ * @brief Stores a value (in `readArg` form) into an unused slot.
+ * @private
+ */
+void writeSlot(List this, unsigned char *slot, void *val){
+    switch (this->_type){
+        case STRING:{
+            if (val == NULL) {
+                fprintf(stderr, "Error in writeSlot(): Cannot store a NULL STRING value.\n");
+                exit(EXIT_FAILURE);
+            }
+            if (this->_flags & LIST_ARENA) {
+                *(char **)slot = arenaString(this, val);
+                break;
+            }
+            char *copy = listAlloc(this, strlen((char *)val) + 1);
+            if (copy == NULL) {
+                fprintf(stderr, "Error in writeSlot(): Failed to allocate memory for a string value.\n");
+                exit(EXIT_FAILURE);
+            }
+            STAT_MEMORY(this, 0, strlen((char *)val) + 1, 1, 0);
+            strcpy(copy, (char *)val);
+            *(char **)slot = copy;
+            break;
         }
-        strcpy((char *)node->_val, (char *)val);
+        case T:
+            *(void **)slot = val;
+            break;
+        default:
+            memcpy(slot, val, this->_size);
+            break;
+    }
+}
+
+/**
+ * @brief Returns a slot's value as a caller-owned pointer, as `pop` does.
+ * @private
+ */
+void *detachSlot(List this, unsigned char *slot){
+    if (this->_type == T) {
+        return *(void **)slot;
     }
-    else if (type == T) {
-        node->_val = val;
+    bool heap = this->_type == STRING && !(this->_flags & LIST_ARENA);
+    if (heap && this->_extra->_allocator == NULL) {
+        STAT_MEMORY(this, 0, -(long long)(strlen(*(char **)slot) + 1), 0, 0);
+        return *(void **)slot;
     }
-    else {
-        node->_val = malloc(size);
-        if (node->_val == NULL) {
-            fprintf(stderr, "Error in newNode(): Failed to allocate memory for the node's value.\n");
-            exit(EXIT_FAILURE);
+    const void *value = this->_type == STRING ? *(void **)slot : slot;
+    size_t bytes = this->_type == STRING ? strlen(value) + 1 : this->_size;
+    void *copy = malloc(bytes);
+    if (copy == NULL) {
+        fprintf(stderr, "Error in pop(): Failed to allocate memory for the returned value.\n");
+        exit(EXIT_FAILURE);
+    }
+    STAT_MEMORY(this, 0, 0, 1, 0);
+    memcpy(copy, value, bytes);
+    if (heap) releaseString(this, *(char **)slot);
+    return copy;
+}
+
+/** @copydoc releaseString */
+void releaseString(List this, char *string){
+    if (!(this->_flags & LIST_ARENA)) {
+        STAT_MEMORY(this, 0, string == NULL ? 0 : -(long long)(strlen(string) + 1), 0, string != NULL);
+        listFree(this, string);
+    }
+}
+
+/**
+ * @brief Returns element `i` of a `pushArray` array in `readArg` form.
+ *
+ * The array holds `_size`-byte elements: values for `INT`, `FLOAT` and `DOUBLE`,
+ * pointers for `STRING` and `T`.
+ * @private
+ */
+void *arrayValue(List this, const void *values, size_t i){
+    const unsigned char *element = (const unsigned char *)values + i * this->_size;
+    if (this->_type == STRING || this->_type == T) {
+        return *(void *const *)element;
+    }
+    return (void *)element;
+}
+
+/**
+ * @brief Visits the list's elements as contiguous arrays of slots.
+ *
+ * `LIST_VECTOR` lists expose their array directly and `LIST_UNROLLED` lists
+ * their chunks. Linked-list values are copied into a stack buffer of
+ * `TLIST_STAGING_BYTES` bytes, which is handed to `visit` each time it fills up.
+ * For `STRING` and `T` lists the segments hold pointers.
+ *
+ * @param this A pointer to the list.
+ * @param visit Function called with each segment and `context`; returns `false` to stop.
+ * @param context Passed through to `visit`.
+ * @return `false` if `visit` stopped the walk early, `true` otherwise.
+ * @private
+ */
+bool forEachSegment(List this, bool (*visit)(const void *data, size_t n, void *context), void *context){
+    if (this->_flags & LIST_VECTOR) {
+        struct VectorStore *store = listStore(this);
+        if (this->_length == 0) return true;
+        return visit(store->_data + (size_t)store->_start * this->_size, (size_t)this->_length, context);
+    }
+    if (this->_flags & LIST_UNROLLED) {
+        for (struct Chunk *chunk = ((struct UnrolledStore *)listStore(this))->_first; chunk != NULL; chunk = chunk->_nextChunk){
+            if (!visit(chunk->_slots, (size_t)chunk->_count, context)) return false;
         }
-        memcpy(node->_val, val, size);
-    }   
-    node->_nextNode = NULL;
-    return node;
+        return true;
+    }
+    _Alignas(32) unsigned char buffer[TLIST_STAGING_BYTES];
+    size_t capacity = TLIST_STAGING_BYTES / this->_size;
+    size_t n = 0;
+    for (Node current = this->_head; current != NULL; current = current->_nextNode){
+        if (this->_type == STRING || this->_type == T) {
+            ((void **)buffer)[n] = current->_val;
+        } else {
+            memcpy(buffer + n * this->_size, current->_val, this->_size);
+        }
+        if (++n == capacity) {
+            if (!visit(buffer, n, context)) return false;
+            n = 0;
+        }
+    }
+    return n == 0 || visit(buffer, n, context);
+}
+
+/**
+ * @brief Prints one element, formatted according to the list's type.
+ * @param this A pointer to the list.
+ * @param val The element, as returned by `get`.
+ * @private
+ */
+void printValue(List this, void *val){
+    switch (this->_type){
+        case INT:
+            printf("%d", *(int *)val);
+            break;
+        case STRING:
+            printf("\"%s\"", (char *)val);
+            break;
+        case DOUBLE:
+            printf("%.2f", *(double *)val);
+            break;
+        case FLOAT:
+            printf("%.2f", *(float *)val);
+            break;
+        case T:
+            printf("%p", val);
+            break;
+    }
 }
 
 /**
@@ -157,30 +698,14 @@ Node newNode(void *val, size_t size, Type type){
  * @param this A pointer to the list.
  * @private
  */
-void print(List this){
+void linkedPrint(List this){
     if (this == NULL) {
         fprintf(stderr, "Error in print(): The provided list instance is NULL.\n");
         return;
     }
     printf("[");
     for (Node current = this->_head; current != NULL; current = current->_nextNode){
-        switch (this->_type){
-            case INT:
-                printf("%d", *(int *)current->_val);
-                break;
-            case STRING:
-                printf("\"%s\"", (char *)current->_val);
-                break;
-            case DOUBLE:
-                printf("%.2f", *(double *)current->_val);
-                break;
-            case FLOAT:
-                printf("%.2f", *(float *)current->_val);
-                break;
-            case T:
-                printf("%p", current->_val);
-                break;
-        }
+        printValue(this, current->_val);
         if (current->_nextNode != NULL){
             printf(", ");
         }
@@ -204,16 +729,145 @@ void destroyList(List this){
         fprintf(stderr, "Error in destroyList(): The provided list instance is NULL.\n");
         return;
     }
+    NodePool pool = listPool(this);
     Node current = this->_head;
     while (current != NULL){
         Node temp = current;
         current = temp->_nextNode;
-        if(this->_type != T) free(temp->_val);
-        free(temp);
+        releaseValue(this, temp);
+        if (pool == NULL) releaseNode(this, temp);
+    }
+    if (pool != NULL) {
+        struct NodeBlock *block = pool->_blocks;
+        while (block != NULL) {
+            struct NodeBlock *temp = block;
+            block = temp->_nextBlock;
+            STAT_MEMORY(this, -(long long)(sizeof(struct NodeBlock) + temp->_capacity * this->_nodeSize), 0, 0, 1);
+            listFree(this, temp);
+        }
+        pool->_blocks = NULL;
+        pool->_freeNodes = NULL;
+        pool->_nextCapacity = TLIST_SLAB_MIN_BLOCK;
     }
+    releaseArena(this);
+    releaseIndex(this);
+    releaseExtra(this);
     this->_head = NULL;
     this->_tail = NULL;
     this->_length = 0;
+    this->_cursor = NULL;
+}
+
+/**
+ * @brief Finds the node at a given index, starting from the nearest known node.
+ *
+ * The list caches the last node reached by an indexed operation together with
+ * its index. A lookup at or after that position continues from the cached node
+ * (a hit) instead of restarting from `_head` (a miss), which makes ascending
+ * loops over `get`, `set`, `insert`, `remove` and `pick` linear overall.
+ * `LIST_DOUBLY` lists can also walk backwards, from the cursor or from
+ * `_tail`, so a lookup never walks more than half the list.
+ * `LIST_SYNC` lists never use the cursor, because concurrent readers must
+ * not update it.
+ *
+ * @param this A pointer to the list.
+ * @param index The zero-based index of the node.
+ * @return The node, or `NULL` if `index` is out of bounds.
+ * @private
+ */
+Node seekNode(List this, int index){
+    if (index < 0 || index >= this->_length) {
+        return NULL;
+    }
+    bool doubly = (this->_flags & LIST_DOUBLY) != 0;
+    Node current = this->_head;
+    int x = 0;
+    if (index == this->_length - 1 || (doubly && index >= this->_length / 2)) {
+        current = this->_tail;
+        x = this->_length - 1;
+    }
+    if (this->_flags & LIST_SYNC) {
+        STAT_TRAVERSED(this, (size_t)(x > index ? x - index : index - x));
+        while (x < index){
+            current = current->_nextNode;
+            x++;
+        }
+        while (x > index){
+            current = PREV_NODE(current);
+            x--;
+        }
+        return current;
+    }
+    int distance = x > index ? x - index : index - x;
+    int fromCursor = index - this->_cursorIndex;
+    if (doubly && fromCursor < 0) fromCursor = -fromCursor;
+    if (this->_cursor != NULL && fromCursor >= 0 && fromCursor <= distance) {
+        current = this->_cursor;
+        x = this->_cursorIndex;
+        STAT_CURSOR(this, true);
+    } else {
+        STAT_CURSOR(this, false);
+    }
+    STAT_TRAVERSED(this, (size_t)(x > index ? x - index : index - x));
+    while (x < index){
+        current = current->_nextNode;
+        x++;
+    }
+    while (x > index){
+        current = PREV_NODE(current);
+        x--;
+    }
+    this->_cursor = current;
+    this->_cursorIndex = index;
+    return current;
+}
+
+/**
+ * @brief Unlinks the node that follows `prev` (or the head, if `prev` is `NULL`).
+ *
+ * Updates `_head`, `_tail`, `_length` and the cursor. The node is returned
+ * without releasing its value or storage.
+ *
+ * @param this A pointer to the list.
+ * @param prev The node before the one to unlink, or `NULL` to unlink the head.
+ * @param index The index of the node being unlinked.
+ * @return The unlinked node.
+ * @private
+ */
+Node unlinkAfter(List this, Node prev, int index){
+    Node node = prev == NULL ? this->_head : prev->_nextNode;
+    if (this->_extra->_index != NULL) unindexNode(this, node);
+    if (prev == NULL) {
+        this->_head = node->_nextNode;
+    } else {
+        prev->_nextNode = node->_nextNode;
+    }
+    if (node == this->_tail) {
+        this->_tail = prev;
+    }
+    LINK_PREV(this, node->_nextNode, prev);
+    this->_length--;
+    if (this->_cursor == node) {
+        this->_cursor = prev;
+        this->_cursorIndex = index - 1;
+    } else if (this->_cursor != NULL && this->_cursorIndex > index) {
+        this->_cursorIndex--;
+    }
+    return node;
+}
+
+/** @copydoc unlinkNode */
+Node unlinkNode(List this, Node node){
+    if (this->_extra->_index != NULL) unindexNode(this, node);
+    Node prev = PREV_NODE(node);
+    if (prev == NULL) this->_head = node->_nextNode;
+    else prev->_nextNode = node->_nextNode;
+    if (node == this->_tail) this->_tail = prev;
+    LINK_PREV(this, node->_nextNode, prev);
+    this->_length--;
+    // The node's index is unknown, so the cursor cannot be adjusted.
+    this->_cursor = NULL;
+    return node;
 }
 
 /**
@@ -223,6 +877,7 @@ void destroyList(List this){
  * @private
  */
 void underPush(List this, Node node){
+    LINK_PREV(this, node, this->_tail);
     if (this->_head == NULL) {
         this->_head = node;
         this->_tail = node;
@@ -230,55 +885,70 @@ void underPush(List this, Node node){
         this->_tail->_nextNode = node;
         this->_tail = node;
     }
-    this->_length++; 
+    this->_length++;
 }
 
 /**
- * @brief Adds a new element to the end of the list.
+ * @brief Defines the variadic `push`, `set` and `insert` methods for arguments of type `argType`.
  *
- * This is a variadic function. The type of the argument after `this` must
- * match the list's `Type`.
+ * The argument after `this` (or `index`) must match the list's `Type`:
  * - For `INT`: `int`
  * - For `FLOAT`, `DOUBLE`: `double` (due to default argument promotion)
  * - For `STRING`: `char*`
  * - For `T`: `void*`
+ *
+ * It is converted to `valueType` and handed to the backend in `readArg`
+ * form, `address` being `&` for value types and empty for pointers.
+ * @private
+ */
+#define DEFINE_VARIADIC_METHODS(suffix, argType, valueType, address) \
+void push##suffix##Arg(List this, ...){ \
+    if (this == NULL) { \
+        fprintf(stderr, "Error in push(): The provided list instance is NULL.\n"); \
+        return; \
+    } \
+    va_list args; \
+    va_start(args, this); \
+    valueType value = (valueType)va_arg(args, argType); \
+    va_end(args); \
+    this->methods->pushValue(this, address value); \
+} \
+void set##suffix##Arg(List this, int index, ...){ \
+    if (this == NULL) { \
+        fprintf(stderr, "Error in set(): The provided list instance is NULL.\n"); \
+        return; \
+    } \
+    va_list args; \
+    va_start(args, index); \
+    valueType value = (valueType)va_arg(args, argType); \
+    va_end(args); \
+    this->methods->setValue(this, index, address value); \
+} \
+void insert##suffix##Arg(List this, int index, ...){ \
+    if (this == NULL) { \
+        fprintf(stderr, "Error in insert(): The provided list instance is NULL.\n"); \
+        return; \
+    } \
+    va_list args; \
+    va_start(args, index); \
+    valueType value = (valueType)va_arg(args, argType); \
+    va_end(args); \
+    this->methods->insertValue(this, index, address value); \
+}
+
+DEFINE_VARIADIC_METHODS(Int, int, int, &)
+DEFINE_VARIADIC_METHODS(Float, double, float, &)
+DEFINE_VARIADIC_METHODS(Double, double, double, &)
+DEFINE_VARIADIC_METHODS(Ptr, void *, void *, )
+
+/**
+ * @brief Non-variadic core of `push`.
  * @param this A pointer to the list.
+ * @param val The value, in `readArg` form.
+ * @private
  */
-void push(List this, ...){
-    if (this == NULL) {
-        fprintf(stderr, "Error in push(): The provided list instance is NULL.\n");
-        return;
-    }
-    va_list args;
-    va_start(args, this);
-    switch (this->_type){
-        case INT:{
-            int val = va_arg(args, int);
-            underPush(this, newNode(&val, this->_size, this->_type));
-            break;
-        }
-        case STRING:{
-            char *str = va_arg(args, char *);
-            underPush(this, newNode(str, this->_size, this->_type));
-            break;
-        }
-        case DOUBLE:{
-            double dbl = va_arg(args, double);
-            underPush(this, newNode(&dbl, this->_size, this->_type));
-            break;
-        }
-        case FLOAT:{
-            float flt = (float)va_arg(args, double);
-            underPush(this, newNode(&flt, this->_size, this->_type));
-            break;
-        }
-        default:{
-            void *unkown = va_arg(args, void *);
-            underPush(this, newNode(unkown, this->_size, this->_type));
-            break;
-        }
-    }
-    va_end(args);
+void pushValue(List this, void *val){
+    underPush(this, newNode(this, val));
 }
 
 /**
@@ -286,24 +956,38 @@ void push(List this, ...){
  * @param this A pointer to the list.
  * @return The number of elements.
  */
-int len(List this){
+int listLength(List this){
     if (this == NULL) {
         fprintf(stderr, "Error in len(): The provided list instance is NULL.\n");
     }
     return this->_length;
 }
 
+/** @copydoc checkType */
+bool checkType(List this, Type expected, const char *function){
+    if (this == NULL) {
+        fprintf(stderr, "Error in %s(): The provided list instance is NULL.\n", function);
+        return false;
+    }
+    if (this->_type != expected) {
+        fprintf(stderr, "Error in %s(): The list does not hold elements of the expected type.\n", function);
+        return false;
+    }
+    return true;
+}
+
 /**
  * @brief Removes the first element (head) of the list and returns its value.
  *
  * The caller takes ownership of the returned pointer and is responsible for
  * freeing it. For type `T`, the returned pointer is the one that was originally
- * inserted. For other types, it's a pointer to a heap-allocated copy.
+ * inserted. For other types, it's a pointer to a heap-allocated copy; values that
+ * were stored inside the node are copied out, so use `popInto` to avoid the allocation.
  *
  * @param this A pointer to the list.
  * @return A pointer to the value of the removed element, or `NULL` if the list is empty.
  */
-void *pop(List this){
+void *linkedPop(List this){
     if (this == NULL) {
         fprintf(stderr, "Error in pop(): The provided list instance is NULL.\n");
         return NULL;
@@ -311,33 +995,64 @@ void *pop(List this){
     if (this->_head == NULL){
         return NULL;
     }else {
-        Node current = this->_head;
-        this->_head = current->_nextNode;
-        void *val = current->_val;
-        free(current);
-        this->_length--;
-        if (this->_head == NULL) {
-            this->_tail = NULL;
-        }
+        Node current = unlinkAfter(this, NULL, 0);
+        void *val = detachValue(this, current);
+        releaseNode(this, current);
         return val;
     }
 }
 
+/** @copydoc popInto */
+bool popInto(List this, void *out){
+    if (this == NULL) {
+        fprintf(stderr, "Error in popInto(): The provided list instance is NULL.\n");
+        return false;
+    }
+    return this->methods->popValue(this, out);
+}
+
+/**
+ * @brief Linked-list implementation of `popInto`.
+ * @param this A pointer to the list.
+ * @param out Where to store the removed value.
+ * @return `true` if an element was removed, `false` if the list was empty.
+ * @private
+ */
+bool popValue(List this, void *out){
+    if (this->_head == NULL){
+        return false;
+    }
+    Node current = unlinkAfter(this, NULL, 0);
+    switch (this->_type){
+        case STRING:
+            *(char **)out = detachValue(this, current);
+            break;
+        case T:
+            *(void **)out = current->_val;
+            break;
+        default:
+            memcpy(out, current->_val, this->_size);
+            break;
+    }
+    releaseNode(this, current);
+    return true;
+}
+
 /**
  * @brief Retrieves a pointer to the element at a specific index.
  *
  * This function provides direct but read-only access to the internal data.
  * The returned pointer is owned by the list and should not be freed by the caller.
  * Its validity is only guaranteed until the next list-modifying operation.
- * For `INT`, `FLOAT`, `DOUBLE`, this will be a pointer to the heap-allocated value.
- * For `STRING`, a pointer to the internal string copy.
+ * For `INT`, `FLOAT`, `DOUBLE`, this will be a pointer to the value inside the node.
+ * For `STRING`, a pointer to the internal string copy (inside the node for short strings).
  * For `T`, the original `void*` that was inserted.
  *
  * @param this A pointer to the list.
  * @param index The zero-based index of the element to retrieve.
  * @return A pointer to the element's value, or `NULL` if the index is out of bounds.
  */
-void *get(List this, int index){
+void *linkedGet(List this, int index){
     if (this == NULL) {
         fprintf(stderr, "Error in get(): The provided list instance is NULL.\n");
         return NULL;
@@ -346,86 +1061,34 @@ void *get(List this, int index){
         fprintf(stderr, "Error in get(): Index %d is negative and invalid.\n", index);
         return NULL;
     }
-    int x = 0;
-    Node current = this->_head;
-    while (current != NULL){
-        if (x == index){
-            return current->_val;
-        }
-        current = current->_nextNode;
-        x++;
+    Node current = seekNode(this, index);
+    if (current == NULL) {
+        fprintf(stderr, "Error in get(): Index %d is out of bounds for list of size %d.\n", index, this->_length);
+        return NULL;
     }
-    fprintf(stderr, "Error in get(): Index %d is out of bounds for list of size %d.\n", index, x);
-    return NULL;
+    return current->_val;
 }
 
 /**
- * @brief Updates the value of an element at a specific index.
- *
- * This is a variadic function. The argument after `index` must match the list's `Type`.
- * For `STRING`, the old string is freed and a new one is allocated and copied.
- * For `T`, the pointer is simply replaced.
- *
+ * @brief Non-variadic core of `set`.
  * @param this A pointer to the list.
  * @param index The zero-based index of the element to update.
+ * @param val The value, in `readArg` form.
+ * @private
  */
-void set(List this, int index, ...){
-    if (this == NULL) {
-        fprintf(stderr, "Error in set(): The provided list instance is NULL.\n");
-        return;
-    }
+void setValue(List this, int index, void *val){
     if (index < 0) {
         fprintf(stderr, "Error in set(): Index %d is negative and invalid.\n", index);
         return;
     }
-
-    va_list args;
-    va_start(args, index);
-    Node current = this->_head;
-    int x = 0;
-    while (current != NULL){
-        if (x == index) {
-            switch (this->_type){
-                case INT:{
-                    int val = va_arg(args, int);
-                    memcpy(current->_val, &val, this->_size);
-                    break;
-                }
-                case FLOAT:{
-                    float flt = (float)va_arg(args, double);
-                    memcpy(current->_val, &flt, this->_size);
-                    break;
-                }
-                case DOUBLE:{
-                    double dbl = va_arg(args, double);
-                    memcpy(current->_val, &dbl, this->_size);
-                    break;
-                }
-                case STRING:{
-                    char *chr = va_arg(args, char *);
-                    free(current->_val);
-                    current->_val = malloc(strlen(chr) + 1);
-                    if (current->_val == NULL) {
-                        fprintf(stderr, "Error in set(): Failed to allocate memory for the new string value.\n");
-                        exit(EXIT_FAILURE);
-                    }
-                    strcpy((char *)current->_val, chr);
-                    break;
-                }
-                case T:{
-                    void *nil = va_arg(args, void *);
-                    current->_val = nil;
-                    break;
-                }
-            }
-            va_end(args);
-            return;
-        }
-        current = current->_nextNode;
-        x++;
+    Node current = seekNode(this, index);
+    if (current == NULL) {
+        fprintf(stderr, "Error in set(): Index %d is out of bounds for list of size %d.\n", index, this->_length);
+        return;
     }
-    fprintf(stderr, "Error in set(): Index %d is out of bounds for list of size %d.\n", index, x);
-    va_end(args);
+    if (this->_extra->_index != NULL) unindexNode(this, current);
+    storeValue(this, current, val);
+    if (this->_extra->_index != NULL) indexNode(this, current);
 }
 
 /**
@@ -436,7 +1099,7 @@ void set(List this, int index, ...){
  * @param this A pointer to the list.
  * @param index The zero-based index of the element to delete.
  */
-void delete(List this, int index){
+void linkedDelete(List this, int index){
     if (this == NULL) {
         fprintf(stderr, "Error in delete(): The provided list instance is NULL.\n");
         return;
@@ -446,34 +1109,14 @@ void delete(List this, int index){
         return;
     }
 
-    if (index == 0) {
-        Node temp = this->_head;
-        this->_head = temp->_nextNode;
-        if (this->_head == NULL) this->_tail = NULL;
-        if(this->_type != T) free(temp->_val);
-        free(temp);
-        this->_length--;
+    if (index >= this->_length) {
+        fprintf(stderr, "Error in delete(): Index %d is out of bounds for list of size %d.\n", index, this->_length);
         return;
     }
-    Node current = this->_head;
-    int x = 0;
-    while (current != NULL){
-        if (index - 1 == x && index != 0){
-            if (current->_nextNode == NULL) break;
-            Node temp = current->_nextNode;
-            current->_nextNode = temp->_nextNode;
-            if (temp == this->_tail) {
-                this->_tail = current;
-            }
-            if(this->_type != T) free(temp->_val);
-            free(temp);
-            this->_length--;
-            return;
-        }
-        current = current->_nextNode;
-        x++;
-    }
-    fprintf(stderr, "Error in delete(): Index %d is out of bounds for list of size %d.\n", index, x);
+    Node prev = index == 0 ? NULL : seekNode(this, index - 1);
+    Node temp = unlinkAfter(this, prev, index);
+    releaseValue(this, temp);
+    releaseNode(this, temp);
 }
 
 /**
@@ -484,79 +1127,89 @@ void delete(List this, int index){
  * @private
  */
 void underInsert(List this, int index, Node node){
-    if (index == 0){
-        node->_nextNode = this->_head;
-        this->_head = node;
-        this->_length++;
+    Node current = index == 0 ? NULL : seekNode(this, index - 1);
+    node->_nextNode = current == NULL ? this->_head : current->_nextNode;
+    if (current == NULL) this->_head = node;
+    else current->_nextNode = node;
+    if (node->_nextNode == NULL) this->_tail = node;
+    LINK_PREV(this, node, current);
+    LINK_PREV(this, node->_nextNode, node);
+    this->_length++;
+    this->_cursor = node;
+    this->_cursorIndex = index;
+}
+
+/** @copydoc insertArray */
+void insertArray(List this, int index, const void *values, size_t n){
+    if (this == NULL) {
+        fprintf(stderr, "Error in insertArray(): The provided list instance is NULL.\n");
         return;
     }
-
-    Node current = this->_head;
-    int x = 0;
-    while (current != NULL){
-        if (x == index - 1){
-            Node temp = current->_nextNode;
-            current->_nextNode = node;
-            node->_nextNode = temp;
-            this->_length++;
-            return;
-        }
-        current = current->_nextNode;
-        x++;
+    if (index < 0 || index > this->_length) {
+        fprintf(stderr, "Error in insertArray(): Index %d is out of bounds. Valid range is 0 to %d.\n", index, this->_length);
+        return;
+    }
+    if (n > (size_t)(INT_MAX - this->_length)) {
+        fprintf(stderr, "Error in insertArray(): Adding %zu elements would overflow the list length.\n", n);
+        return;
     }
+    if (n == 0 || values == NULL) {
+        return;
+    }
+    this->methods->insertArray(this, index, values, n);
 }
 
 /**
- * @brief Inserts a new element at a specific index.
- *
- * This is a variadic function. The argument after `index` must match the list's `Type`.
- * @param this A pointer to the list.
- * @param index The zero-based index at which to insert the new element.
+ * @brief Linked-list implementation of `insertArray`, called with validated arguments.
+ * @private
  */
-void insert(List this, int index, ...){
-    if (this == NULL) {
-        fprintf(stderr, "Error in insert(): The provided list instance is NULL.\n");
-        return;
+void insertValues(List this, int index, const void *values, size_t n){
+    if (listPool(this) != NULL) {
+        reserveNodes(this, n);
     }
-
-    int list_len = len(this);
-    if (index < 0 || index > list_len) {
-        fprintf(stderr, "Error in insert(): Index %d is out of bounds. Valid range is 0 to %d.\n", index, list_len);
-        return;
+    Node first = newNode(this, arrayValue(this, values, 0));
+    Node last = first;
+    for (size_t i = 1; i < n; i++){
+        last->_nextNode = newNode(this, arrayValue(this, values, i));
+        LINK_PREV(this, last->_nextNode, last);
+        last = last->_nextNode;
     }
 
-    va_list args;
-    va_start(args, index);
+    Node prev = index == 0 ? NULL : seekNode(this, index - 1);
+    last->_nextNode = prev == NULL ? this->_head : prev->_nextNode;
+    if (prev == NULL) this->_head = first;
+    else prev->_nextNode = first;
+    if (last->_nextNode == NULL) this->_tail = last;
+    LINK_PREV(this, first, prev);
+    LINK_PREV(this, last->_nextNode, last);
+    if (this->_cursor != NULL && this->_cursorIndex >= index) {
+        this->_cursorIndex += (int)n;
+    }
+    this->_length += (int)n;
+}
 
-    switch (this->_type){
-        case INT:{
-            int val = va_arg(args, int);
-            underInsert(this, index, newNode(&val, this->_size, this->_type));
-            break;
-        }
-        case STRING:{
-            char *str = va_arg(args, char *);
-            underInsert(this, index, newNode(str, this->_size, this->_type));
-            break;
-        }
-        case DOUBLE:{
-            double dbl = va_arg(args, double);
-            underInsert(this, index, newNode(&dbl, this->_size, this->_type));
-            break;
-        }
-        case FLOAT:{
-            float flt = (float)va_arg(args, double);
-            underInsert(this, index, newNode(&flt, this->_size, this->_type));
-            break;
-        }
-        default:{
-            void *unkown = va_arg(args, void *);
-            underInsert(this, index, newNode(unkown, this->_size, this->_type));
-            break;
-        }
+/** @copydoc pushArray */
+void pushArray(List this, const void *values, size_t n){
+    if (this == NULL) {
+        fprintf(stderr, "Error in pushArray(): The provided list instance is NULL.\n");
+        return;
     }
+    insertArray(this, this->_length, values, n);
+}
 
-    va_end(args);
+/**
+ * @brief Non-variadic core of `insert`.
+ * @param this A pointer to the list.
+ * @param index The zero-based index at which to insert the new element.
+ * @param val The value, in `readArg` form.
+ * @private
+ */
+void insertValue(List this, int index, void *val){
+    if (index < 0 || index > this->_length) {
+        fprintf(stderr, "Error in insert(): Index %d is out of bounds. Valid range is 0 to %d.\n", index, this->_length);
+        return;
+    }
+    underInsert(this, index, newNode(this, val));
 }
 
 /**
@@ -570,7 +1223,7 @@ void insert(List this, int index, ...){
  * @param index The zero-based index of the element to remove.
  * @return A pointer to the value of the removed element, or `NULL` if the index is out of bounds.
  */
-void *pick(List this, int index){
+void *linkedPick(List this, int index){
     if (this == NULL) {
         fprintf(stderr, "Error in pick(): The provided list instance is NULL.\n");
         return NULL;
@@ -581,29 +1234,103 @@ void *pick(List this, int index){
     }
 
     if(index == 0){
-        return this->pop(this);
+        return this->methods->pop(this);
+    }
+    if (index >= this->_length) {
+        fprintf(stderr, "Error in pick(): Index %d is out of bounds for list of size %d.\n", index, this->_length);
+        return NULL;
     }
 
-    Node current = this->_head;
-    int x = 0;
-    while (current != NULL){
-        if (x == index - 1 && current->_nextNode != NULL){
-            Node temp = current->_nextNode;
-            current->_nextNode = temp->_nextNode;
-            if (temp == this->_tail) {
-                this->_tail = current;
-            }
-            void *n = temp->_val;
-            free(temp);
-            this->_length--;
-            return n;
-        }
-        current = current->_nextNode;
-        x++;
+    Node temp = unlinkAfter(this, seekNode(this, index - 1), index);
+    void *n = detachValue(this, temp);
+    releaseNode(this, temp);
+    return n;
+}
+
+/** @copydoc pushFront */
+void pushFront(List this, ...){
+    if (this == NULL) {
+        fprintf(stderr, "Error in pushFront(): The provided list instance is NULL.\n");
+        return;
+    }
+    if (this->_flags & LIST_QUEUE) {
+        fprintf(stderr, "Error in pushFront(): Not supported by LIST_QUEUE lists.\n");
+        return;
+    }
+    va_list args;
+    va_start(args, this);
+    Scalar tmp;
+    this->methods->insertValue(this, 0, readArg(this, &args, &tmp));
+    va_end(args);
+}
+
+/** @copydoc popBack */
+void *popBack(List this){
+    if (this == NULL) {
+        fprintf(stderr, "Error in popBack(): The provided list instance is NULL.\n");
+        return NULL;
     }
+    if (this->_flags & LIST_QUEUE) {
+        fprintf(stderr, "Error in popBack(): Not supported by LIST_QUEUE lists.\n");
+        return NULL;
+    }
+    if (!listLock(this, true)) return NULL;
+    // On LIST_DOUBLY lists `pick` finds the second-to-last node from `_tail`.
+    void *val = this->_length == 0 ? NULL : this->methods->pick(this, this->_length - 1);
+    listUnlock(this);
+    return val;
+}
+
+/** @copydoc nodeAt */
+Node nodeAt(List this, int index){
+    if (this == NULL) {
+        fprintf(stderr, "Error in nodeAt(): The provided list instance is NULL.\n");
+        return NULL;
+    }
+    if (this->_flags & (LIST_UNROLLED | LIST_VECTOR | LIST_QUEUE)) {
+        fprintf(stderr, "Error in nodeAt(): Only linked lists have nodes.\n");
+        return NULL;
+    }
+    if (!listLock(this, false)) return NULL;
+    if (this->_extra->_share != NULL) {
+        // A handle allows modification, so the list needs storage of its own.
+        listUnlock(this);
+        if (!listLock(this, true)) return NULL;
+        unshare(this);
+    }
+    Node node = seekNode(this, index);
+    if (node == NULL) {
+        fprintf(stderr, "Error in nodeAt(): Index %d is out of bounds for list of size %d.\n", index, this->_length);
+    }
+    listUnlock(this);
+    return node;
+}
+
+/** @copydoc nodeValue */
+void *nodeValue(Node node){
+    return node == NULL ? NULL : node->_val;
+}
 
-    fprintf(stderr, "Error in pick(): Index %d is out of bounds for list of size %d.\n", index, x);
-    return NULL;
+/** @copydoc removeNode */
+void removeNode(List this, Node node){
+    if (this == NULL || node == NULL) {
+        fprintf(stderr, "Error in removeNode(): The provided list instance or node is NULL.\n");
+        return;
+    }
+    if (!(this->_flags & LIST_DOUBLY)) {
+        fprintf(stderr, "Error in removeNode(): Only LIST_DOUBLY lists can remove a node without searching for it.\n");
+        return;
+    }
+    if (!listLock(this, true)) return;
+    if (!unshare(this)) {
+        fprintf(stderr, "Error in removeNode(): The list was duplicated since the node handle was obtained.\n");
+        listUnlock(this);
+        return;
+    }
+    unlinkNode(this, node);
+    releaseValue(this, node);
+    releaseNode(this, node);
+    listUnlock(this);
 }
 
 /**
@@ -612,7 +1339,7 @@ void *pick(List this, int index){
  * @param this A pointer to the list.
  * @param function A function pointer that takes a `void*` (the element's data) and returns `void`.
  */
-void foreach(List this, void(*function)(void*)){
+void linkedForeach(List this, void(*function)(void*)){
     if (this == NULL) {
         fprintf(stderr, "Error in foreach(): The provided list instance is NULL.\n");
         return;
@@ -622,39 +1349,25 @@ void foreach(List this, void(*function)(void*)){
     }
 }
 
-/**
- * @brief Creates and returns a new list that is a deep copy of the original.
- *
- * This function iterates through the original list and adds each element
- * to a new list. For primitive types (INT, FLOAT, DOUBLE) and STRING,
- * new copies of the values are created. For type `T`, it copies the pointers,
- * meaning both lists will point to the same external data.
- *
- * The caller is responsible for freeing the returned list using `list->free(list)`
- * and then `free(list)`.
- *
- * @param this A pointer to the list to be duplicated.
- * @return A new `List` that is a copy of the original, or `NULL` if the
- *         original list was `NULL`.
- */
+/** @copydoc duplicate */
 List duplicate(List this){
     if (this == NULL) {
         fprintf(stderr, "Error in duplicate(): The provided list instance is NULL.\n");
         return NULL;
     }
-    List list = newList(this->_type);
-    TIterator iterator = newIterator(this);
-    
-    while(hasNext(iterator)){
-        void* val = next(iterator);
-        switch (this->_type){
-            case INT: push(list, *(int *)val); break;
-            case FLOAT: push(list, *(float *)val); break;
-            case DOUBLE: push(list, *(double *)val); break;
-            case STRING: push(list, (char *)val); break;
-            case T: push(list, val); break;
-        }
+    // Sharing swaps the methods of `this`, which needs its write lock.
+    if (!(this->_flags & LIST_QUEUE) && !readLockHeld(this)) {
+        if (!listLock(this, true)) return NULL;
+        List list = shareList(this, this->_flags);
+        listUnlock(this);
+        return list;
+    }
+    if (!listLock(this, false)) return NULL;
+    List list = newListWithFlags(this->_type, this->_flags);
+    TLIST_FOREACH(this, val) {
+        // `get` form is also the form `pushValue` takes.
+        list->methods->pushValue(list, val);
     }
-    iterator->free(iterator);
+    listUnlock(this);
     return list;
 }
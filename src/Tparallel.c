@@ -0,0 +1,365 @@
+/**
+ * @file Tparallel.c
+ * @brief `parallelForeach` and `parallelMap` on a shared pthread worker pool.
+ *
+ * A call splits the list into about `TLIST_TASKS_PER_THREAD` tasks per
+ * participating thread. Each task is a run of consecutive elements together
+ * with its starting position. Linked lists find the task boundaries in one
+ * walk, unrolled lists skip whole chunks, and vector lists compute them
+ * directly. Every participant starts with its own contiguous range of tasks
+ * and takes tasks from the front of it. Once the range is exhausted, the
+ * participant steals from the back of the other ranges, so a few slow
+ * callbacks do not leave the other threads idle.
+ *
+ * The worker threads are created on first use, grown when a call asks for
+ * more, and reused until `parallelShutdown`. The calling thread takes part in
+ * the work. Only one parallel call runs on the pool at a time; a call made
+ * while the pool is busy (including one made from inside a callback) runs
+ * serially on the calling thread instead.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "Tlist.h"
+#include "TlistPrivate.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <unistd.h>
+
+/**
+ * @struct Task
+ * @brief A run of consecutive elements and where it starts.
+ * @private
+ */
+typedef struct Task{
+    int _start;             /**< Index of the first element. */
+    int _count;             /**< Number of elements. */
+    Node _node;             /**< First node, for linked lists. */
+    struct Chunk *_chunk;   /**< Chunk holding the first element, for unrolled lists. */
+    int _offset;            /**< Slot of the first element within `_chunk`. */
+} Task;
+
+/**
+ * @struct TaskRange
+ * @brief The tasks still owned by one participant, `[_front, _back)`.
+ * @private
+ */
+typedef struct TaskRange{
+    pthread_mutex_t _lock;
+    int _front;
+    int _back;
+} TaskRange;
+
+/**
+ * @struct Job
+ * @brief One `parallelForeach` or `parallelMap` call.
+ * @private
+ */
+typedef struct Job{
+    List _list;
+    void (*_each)(void *val);               /**< `parallelForeach` callback. */
+    void (*_map)(void *val, void *out);     /**< `parallelMap` callback. */
+    unsigned char *_out;                    /**< `parallelMap` results, one slot per element. */
+    size_t _outSize;                        /**< Size of one result slot. */
+    Task *_tasks;
+    TaskRange *_ranges;
+    int _workers;                           /**< Number of participants, the caller included. */
+} Job;
+
+/**
+ * @brief The shared worker pool. Worker `i` (from 1) is `_threads[i - 1]`;
+ *        participant 0 is always the calling thread.
+ * @private
+ */
+static struct{
+    pthread_mutex_t _lock;
+    pthread_cond_t _wake;           /**< Signalled when a job is published or the pool stops. */
+    pthread_cond_t _done;           /**< Signalled when the last worker finishes a job. */
+    pthread_t *_threads;
+    int _size;
+    Job *_job;
+    unsigned long _generation;      /**< Incremented for every published job. */
+    unsigned long _spawnGeneration; /**< Generation new workers start from. */
+    int _running;                   /**< Workers that have not finished the current job. */
+    bool _stop;
+} pool = { ._lock = PTHREAD_MUTEX_INITIALIZER, ._wake = PTHREAD_COND_INITIALIZER, ._done = PTHREAD_COND_INITIALIZER };
+
+/** Held for the whole duration of a job, so that jobs never overlap. @private */
+static pthread_mutex_t jobLock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Calls the job's callback on every element of a task.
+ * @private
+ */
+static void runTask(Job *job, const Task *task){
+    List list = job->_list;
+    unsigned char *out = job->_out == NULL ? NULL : job->_out + (size_t)task->_start * job->_outSize;
+    Node node = task->_node;
+    struct Chunk *chunk = task->_chunk;
+    int offset = task->_offset;
+    for (int i = 0; i < task->_count; i++){
+        void *val;
+        if (list->_flags & LIST_VECTOR) {
+            struct VectorStore *store = listStore(list);
+            val = slotValue(list, store->_data + (size_t)(store->_start + task->_start + i) * list->_size);
+        } else if (list->_flags & LIST_UNROLLED) {
+            if (offset == chunk->_count) {
+                chunk = chunk->_nextChunk;
+                offset = 0;
+            }
+            val = slotValue(list, chunk->_slots + (size_t)offset++ * list->_size);
+        } else {
+            val = node->_val;
+            node = node->_nextNode;
+        }
+        if (out == NULL) {
+            job->_each(val);
+        } else {
+            job->_map(val, out);
+            out += job->_outSize;
+        }
+    }
+}
+
+/**
+ * @brief Takes a task from the front of `range`, or from its back when stealing.
+ * @return The task index, or -1 if the range is empty.
+ * @private
+ */
+static int takeTask(TaskRange *range, bool steal){
+    int task = -1;
+    pthread_mutex_lock(&range->_lock);
+    if (range->_front < range->_back) {
+        task = steal ? --range->_back : range->_front++;
+    }
+    pthread_mutex_unlock(&range->_lock);
+    return task;
+}
+
+/**
+ * @brief Runs participant `id`'s tasks, then steals until no task is left.
+ * @private
+ */
+static void work(Job *job, int id){
+    int task;
+    while ((task = takeTask(&job->_ranges[id], false)) >= 0){
+        runTask(job, &job->_tasks[task]);
+    }
+    for (int k = 1; k < job->_workers; k++){
+        TaskRange *victim = &job->_ranges[(id + k) % job->_workers];
+        while ((task = takeTask(victim, true)) >= 0){
+            runTask(job, &job->_tasks[task]);
+        }
+    }
+}
+
+/**
+ * @brief Main loop of a pool thread: waits for jobs and works on them.
+ * @private
+ */
+static void *workerMain(void *arg){
+    int id = (int)(intptr_t)arg;
+    pthread_mutex_lock(&pool._lock);
+    unsigned long seen = pool._spawnGeneration;
+    for (;;){
+        while (pool._generation == seen && !pool._stop){
+            pthread_cond_wait(&pool._wake, &pool._lock);
+        }
+        if (pool._stop) break;
+        seen = pool._generation;
+        Job *job = pool._job;
+        pthread_mutex_unlock(&pool._lock);
+        if (id < job->_workers) work(job, id);
+        pthread_mutex_lock(&pool._lock);
+        if (--pool._running == 0) pthread_cond_signal(&pool._done);
+    }
+    pthread_mutex_unlock(&pool._lock);
+    return NULL;
+}
+
+/**
+ * @brief Makes sure the pool has at least `size` threads. Requires `pool._lock`.
+ * @return The number of threads available, which may be lower if creation failed.
+ * @private
+ */
+static int growPool(int size){
+    if (size <= pool._size) return pool._size;
+    pthread_t *threads = realloc(pool._threads, (size_t)size * sizeof(pthread_t));
+    if (threads == NULL) {
+        fprintf(stderr, "Error in parallelForeach(): Failed to allocate memory for the worker pool.\n");
+        exit(EXIT_FAILURE);
+    }
+    pool._threads = threads;
+    pool._spawnGeneration = pool._generation;
+    while (pool._size < size){
+        if (pthread_create(&pool._threads[pool._size], NULL, workerMain, (void *)(intptr_t)(pool._size + 1)) != 0) {
+            fprintf(stderr, "Error in parallelForeach(): Failed to start a worker thread.\n");
+            break;
+        }
+        pool._size++;
+    }
+    return pool._size;
+}
+
+/**
+ * @brief Returns the number of threads to use when the caller passes `nthreads`.
+ * @private
+ */
+static int threadCount(int nthreads){
+    if (nthreads <= 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = online > 0 ? (int)online : 1;
+    }
+    return nthreads < TLIST_MAX_THREADS ? nthreads : TLIST_MAX_THREADS;
+}
+
+/**
+ * @brief Splits the list into tasks and runs them on `nthreads` participants.
+ * @private
+ */
+static void runJob(Job *job, int nthreads){
+    List list = job->_list;
+    int n = list->_length;
+    if (n == 0) return;
+
+    bool pooled = nthreads > 1 && pthread_mutex_trylock(&jobLock) == 0;
+    if (pooled) {
+        pthread_mutex_lock(&pool._lock);
+        int available = growPool(nthreads - 1);
+        if (available < nthreads - 1) nthreads = available + 1;
+        pthread_mutex_unlock(&pool._lock);
+    } else {
+        nthreads = 1;
+    }
+
+    int tasks = nthreads * TLIST_TASKS_PER_THREAD;
+    if (tasks > n) tasks = n;
+    job->_tasks = malloc((size_t)tasks * sizeof(Task));
+    job->_ranges = malloc((size_t)nthreads * sizeof(TaskRange));
+    if (job->_tasks == NULL || job->_ranges == NULL) {
+        fprintf(stderr, "Error in parallelForeach(): Failed to allocate memory for the task list.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Task t covers elements [t * n / tasks, (t + 1) * n / tasks).
+    Node node = list->_head;
+    struct Chunk *chunk = (list->_flags & LIST_UNROLLED) ? ((struct UnrolledStore *)listStore(list))->_first : NULL;
+    int chunkStart = 0;
+    int position = 0;
+    for (int t = 0; t < tasks; t++){
+        Task *task = &job->_tasks[t];
+        task->_start = (int)((long long)t * n / tasks);
+        task->_count = (int)((long long)(t + 1) * n / tasks) - task->_start;
+        task->_node = NULL;
+        task->_chunk = NULL;
+        task->_offset = 0;
+        if (list->_flags & LIST_UNROLLED) {
+            while (chunkStart + chunk->_count <= task->_start){
+                chunkStart += chunk->_count;
+                chunk = chunk->_nextChunk;
+            }
+            task->_chunk = chunk;
+            task->_offset = task->_start - chunkStart;
+        } else if (!(list->_flags & LIST_VECTOR)) {
+            while (position < task->_start){
+                node = node->_nextNode;
+                position++;
+            }
+            task->_node = node;
+        }
+    }
+    for (int w = 0; w < nthreads; w++){
+        pthread_mutex_init(&job->_ranges[w]._lock, NULL);
+        job->_ranges[w]._front = (int)((long long)w * tasks / nthreads);
+        job->_ranges[w]._back = (int)((long long)(w + 1) * tasks / nthreads);
+    }
+    job->_workers = nthreads;
+
+    if (pooled) {
+        pthread_mutex_lock(&pool._lock);
+        pool._job = job;
+        pool._running = pool._size;
+        pool._generation++;
+        pthread_cond_broadcast(&pool._wake);
+        pthread_mutex_unlock(&pool._lock);
+    }
+    work(job, 0);
+    if (pooled) {
+        pthread_mutex_lock(&pool._lock);
+        while (pool._running > 0){
+            pthread_cond_wait(&pool._done, &pool._lock);
+        }
+        pool._job = NULL;
+        pthread_mutex_unlock(&pool._lock);
+        pthread_mutex_unlock(&jobLock);
+    }
+
+    for (int w = 0; w < nthreads; w++){
+        pthread_mutex_destroy(&job->_ranges[w]._lock);
+    }
+    free(job->_ranges);
+    free(job->_tasks);
+}
+
+/** @copydoc parallelForeach */
+void parallelForeach(List this, void (*function)(void *), int nthreads){
+    if (this == NULL || function == NULL) {
+        fprintf(stderr, "Error in parallelForeach(): The list and the function must not be NULL.\n");
+        return;
+    }
+    if (!listLock(this, false)) return;
+    Job job = { ._list = this, ._each = function };
+    runJob(&job, threadCount(nthreads));
+    listUnlock(this);
+}
+
+/** @copydoc parallelMap */
+List parallelMap(List this, Type type, void (*function)(void *val, void *out), int nthreads){
+    if (this == NULL || function == NULL) {
+        fprintf(stderr, "Error in parallelMap(): The list and the function must not be NULL.\n");
+        return NULL;
+    }
+    if (!listLock(this, false)) return NULL;
+    List result = deriveList(this, type, this->_flags);
+    if (result == NULL || this->_length == 0) {
+        listUnlock(this);
+        return result;
+    }
+
+    size_t n = (size_t)this->_length;
+    Job job = { ._list = this, ._map = function, ._outSize = result->_size };
+    job._out = listCalloc(result, n, job._outSize);
+    if (job._out == NULL) {
+        fprintf(stderr, "Error in parallelMap(): Failed to allocate memory for the results.\n");
+        exit(EXIT_FAILURE);
+    }
+    runJob(&job, threadCount(nthreads));
+    listUnlock(this);
+    pushArray(result, job._out, n);
+    if (type == STRING) {
+        for (size_t i = 0; i < n; i++){
+            free(((char **)job._out)[i]);
+        }
+    }
+    listFree(result, job._out);
+    return result;
+}
+
+/** @copydoc parallelShutdown */
+void parallelShutdown(void){
+    pthread_mutex_lock(&jobLock);
+    pthread_mutex_lock(&pool._lock);
+    pool._stop = true;
+    pthread_cond_broadcast(&pool._wake);
+    pthread_mutex_unlock(&pool._lock);
+    for (int i = 0; i < pool._size; i++){
+        pthread_join(pool._threads[i], NULL);
+    }
+    pthread_mutex_lock(&pool._lock);
+    free(pool._threads);
+    pool._threads = NULL;
+    pool._size = 0;
+    pool._stop = false;
+    pthread_mutex_unlock(&pool._lock);
+    pthread_mutex_unlock(&jobLock);
+}
@@ -0,0 +1,469 @@
+/**
+ * @file Tparse.c
+ * @brief Streaming text loaders: `readInts`, `readDoubles` and `readLines`.
+ *
+ * Input is read in blocks of `TLIST_IO_BYTES` into one buffer and split into
+ * fields in place: each field is NUL-terminated where its separator was and
+ * parsed straight from the buffer. Parsed values are gathered into a staging
+ * array of `TLIST_STAGING_BYTES` and appended with one `pushArray` call per
+ * batch, so linked lists reserve their nodes a batch at a time.
+ *
+ * Only the unfinished field at the end of a block is carried over to the
+ * next read, so memory use does not depend on the size of the input. The
+ * buffer grows only to hold a single field (or, for `readLines`, a single
+ * line) longer than itself.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "Tlist.h"
+#include "TlistPrivate.h"
+#include <errno.h>
+#include <inttypes.h>
+#include <math.h>
+#include <stdint.h>
+#include <unistd.h>
+
+/** Maximum number of bytes of a field quoted in a parse error. @private */
+#define TLIST_QUOTE_BYTES 32
+
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+/** Parse digits 8 at a time within a 64-bit word. @private */
+#define TLIST_SWAR
+#endif
+
+/** Bytes kept readable, and zeroed, after the input in the buffer, so digits can be loaded a word at a time. @private */
+#define TLIST_PARSE_SLACK sizeof(uint64_t)
+
+/**
+ * @struct Scanner
+ * @brief Splits the text read from a file descriptor into fields.
+ * @private
+ */
+typedef struct Scanner{
+    int _fd;
+    const char *_function;      /**< Public function reading, for error messages. */
+    char *_buffer;
+    size_t _capacity;           /**< One byte is always kept free for a NUL after the bytes read. */
+    size_t _start;              /**< First byte not yet split into a field. */
+    size_t _end;                /**< End of the bytes read. */
+    size_t _lineEnd;            /**< Next newline at or after `_start`, or `_end`. */
+    bool _lineKnown;            /**< Whether `_lineEnd` is up to date. */
+    bool _eof;
+    uint64_t _offset;           /**< Input offset of `_buffer[0]`. */
+    uint64_t _line;             /**< Line of `_buffer[_start]`, from 1. */
+    uint64_t _lineStart;        /**< Input offset of the start of that line. */
+    uint64_t _fieldLine;        /**< `_line` and `_lineStart` of the last field returned. */
+    uint64_t _fieldLineStart;
+} Scanner;
+
+/**
+ * @brief Returns the next complete field in the buffer, NUL-terminated.
+ *
+ * A field ends at `delim` or at a newline. Once the input is exhausted the
+ * bytes left after the last separator form a final field.
+ * @return `false` if the buffer holds no complete field: call `refill`.
+ * @private
+ */
+static bool nextField(Scanner *scanner, char delim, char **field, size_t *n){
+    char *begin = scanner->_buffer + scanner->_start;
+    if (!scanner->_lineKnown) {
+        char *newline = memchr(begin, '\n', scanner->_end - scanner->_start);
+        scanner->_lineEnd = newline == NULL ? scanner->_end : (size_t)(newline - scanner->_buffer);
+        scanner->_lineKnown = true;
+    }
+    char *lineEnd = scanner->_buffer + scanner->_lineEnd;
+    char *separator = delim == '\n' ? NULL : memchr(begin, delim, (size_t)(lineEnd - begin));
+    bool newline = separator == NULL && scanner->_lineEnd < scanner->_end;
+    if (newline) separator = lineEnd;
+    if (separator == NULL) {
+        if (!scanner->_eof || scanner->_start == scanner->_end) return false;
+        separator = scanner->_buffer + scanner->_end;
+    }
+    *separator = '\0';
+    *field = begin;
+    *n = (size_t)(separator - begin);
+    scanner->_fieldLine = scanner->_line;
+    scanner->_fieldLineStart = scanner->_lineStart;
+    scanner->_start = separator == scanner->_buffer + scanner->_end ? scanner->_end : (size_t)(separator - scanner->_buffer) + 1;
+    if (newline) {
+        scanner->_line++;
+        scanner->_lineStart = scanner->_offset + scanner->_start;
+        scanner->_lineKnown = false;
+    }
+    return true;
+}
+
+/**
+ * @brief Consumes a value parsed in place by a `FieldScanner` if `stop`, the
+ *        byte after it, is a separator that has been read.
+ * @return `false` if the value must be split off by `nextField` instead.
+ * @private
+ */
+static bool skipValue(Scanner *scanner, char delim, const char *stop){
+    if (stop == NULL || stop == scanner->_buffer + scanner->_end || (*stop != delim && *stop != '\n')) return false;
+    scanner->_start = (size_t)(stop - scanner->_buffer) + 1;
+    if (*stop == '\n') {
+        scanner->_line++;
+        scanner->_lineStart = scanner->_offset + scanner->_start;
+        scanner->_lineKnown = false;
+    }
+    return true;
+}
+
+/**
+ * @brief Moves the unfinished field to the front of the buffer and reads more input.
+ * @return `false` on a read error.
+ * @private
+ */
+static bool refill(Scanner *scanner){
+    if (scanner->_start > 0) {
+        memmove(scanner->_buffer, scanner->_buffer + scanner->_start, scanner->_end - scanner->_start);
+        scanner->_offset += scanner->_start;
+        scanner->_end -= scanner->_start;
+        scanner->_start = 0;
+    }
+    if (scanner->_end + 1 == scanner->_capacity) {
+        // A single field fills the buffer.
+        char *grown = realloc(scanner->_buffer, scanner->_capacity * 2 + TLIST_PARSE_SLACK);
+        if (grown == NULL) {
+            fprintf(stderr, "Error in %s(): Failed to grow the input buffer.\n", scanner->_function);
+            exit(EXIT_FAILURE);
+        }
+        scanner->_buffer = grown;
+        scanner->_capacity *= 2;
+    }
+    ssize_t got;
+    do {
+        got = read(scanner->_fd, scanner->_buffer + scanner->_end, scanner->_capacity - 1 - scanner->_end);
+    } while (got < 0 && errno == EINTR);
+    if (got < 0) {
+        fprintf(stderr, "Error in %s(): Read failed: %s.\n", scanner->_function, strerror(errno));
+        return false;
+    }
+    if (got == 0) scanner->_eof = true;
+    scanner->_end += (size_t)got;
+    memset(scanner->_buffer + scanner->_end, 0, TLIST_PARSE_SLACK);
+    scanner->_lineKnown = false;
+    return true;
+}
+
+/* Parsers ----------------------------------------------------------------- */
+
+/**
+ * @brief Parses a trimmed, NUL-terminated field into one `pushArray` slot.
+ * @return `NULL` on success, otherwise what is wrong with the field.
+ * @private
+ */
+typedef const char *(*FieldParser)(char *field, size_t n, void *out);
+
+/**
+ * @brief Parses a value at `p` in the common form only, without knowing where the field ends.
+ *
+ * The input is terminated by a NUL or a separator.
+ * @return The first byte after the value, or `NULL` if the value is not in
+ *         the common form and must go through the matching `FieldParser`.
+ * @private
+ */
+typedef const char *(*FieldScanner)(const char *p, void *out);
+
+/** Powers of ten that fit in 8 digits. @private */
+static const uint64_t digitPowers[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+
+#ifdef TLIST_SWAR
+/** Number of ASCII digits at the start of the 8 bytes of `chunk`, in memory order. @private */
+static int leadingDigits(uint64_t chunk){
+    // Zero in each byte that holds '0' to '9'; a carry only disturbs bytes after a non-digit.
+    uint64_t nonDigits = ((chunk & 0xF0F0F0F0F0F0F0F0) | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ^ 0x3333333333333333;
+    return nonDigits == 0 ? 8 : __builtin_ctzll(nonDigits) / 8;
+}
+
+/** Value of 8 ASCII digits, the first in the lowest byte, in three multiplications. @private */
+static uint64_t eightDigits(uint64_t chunk){
+    chunk = (chunk & 0x0F0F0F0F0F0F0F0F) * 2561 >> 8;
+    chunk = (chunk & 0x00FF00FF00FF00FF) * 6553601 >> 16;
+    return (chunk & 0x0000FFFF0000FFFF) * 42949672960001 >> 32;
+}
+#endif
+
+/**
+ * @brief Appends the digits at `p` to `*value`, counting them in `*digits`.
+ *
+ * Stops at the first non-digit, or once `*digits` exceeds 19, after which
+ * `*value` is meaningless. With `TLIST_SWAR` the digits are converted 8 at a
+ * time, which avoids a hard-to-predict branch per digit.
+ * @return The first byte not consumed.
+ * @private
+ */
+static const char *readDigits(const char *p, uint64_t *value, int *digits){
+#ifdef TLIST_SWAR
+    for (;;){
+        uint64_t chunk;
+        memcpy(&chunk, p, sizeof chunk);
+        int n = leadingDigits(chunk);
+        if (n == 0 || *digits + n > 19) break;
+        // Shift the digits to the top; the zero bytes below act as leading zeros.
+        *value = *value * digitPowers[n] + eightDigits(chunk << (64 - 8 * n));
+        *digits += n;
+        p += n;
+        if (n < 8) return p;
+    }
+#endif
+    for (unsigned digit; (digit = (unsigned char)*p - '0') <= 9 && *digits <= 19; p++){
+        *value = *value * 10 + digit;
+        ++*digits;
+    }
+    return p;
+}
+
+/** @private */
+static const char *scanInt(const char *p, void *out){
+    bool negative = *p == '-';
+    if (*p == '-' || *p == '+') p++;
+    const char *start = p;
+    // Leading zeros do not count towards the 19 digits `readDigits` converts.
+    while (*p == '0') p++;
+    uint64_t value = 0;
+    int digits = 0;
+    p = readDigits(p, &value, &digits);
+    if (p == start || digits > 19 || value > (uint64_t)INT_MAX + negative) return NULL;
+    *(int *)out = negative ? (int)-(int64_t)value : (int)value;
+    return p;
+}
+
+/** @private */
+static const char *parseInt(char *field, size_t n, void *out){
+    if (scanInt(field, out) == field + n) return NULL;
+    size_t i = field[0] == '-' || field[0] == '+' ? 1 : 0;
+    if (i == n) return "is not an integer";
+    for (; i < n; i++){
+        if ((unsigned)((unsigned char)field[i] - '0') > 9) return "is not an integer";
+    }
+    return "is out of range";
+}
+
+/** Powers of ten that are exact as doubles. @private */
+static const double exactPowers[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/**
+ * @brief Parses a plain decimal whose conversion is exact.
+ *
+ * With at most 19 significant digits, a mantissa of at most 2^53 and a power
+ * of ten of at most 22 both operands are exact doubles, so one
+ * multiplication or division rounds correctly.
+ * @private
+ */
+static const char *scanDecimal(const char *p, double *out){
+    bool negative = *p == '-';
+    if (*p == '-' || *p == '+') p++;
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    const char *start = p;
+    p = readDigits(p, &mantissa, &digits);
+    bool any = p != start;
+    if (*p == '.') {
+        const char *fraction = ++p;
+        p = readDigits(p, &mantissa, &digits);
+        exponent = -(int)(p - fraction);
+        any = any || p != fraction;
+    }
+    if (!any || digits > 19) return NULL;
+    if (*p == 'e' || *p == 'E') {
+        p++;
+        bool negativeExponent = *p == '-';
+        if (*p == '-' || *p == '+') p++;
+        int value = 0;
+        const char *exponentStart = p;
+        for (; (unsigned)((unsigned char)*p - '0') <= 9 && value < 1000; p++) value = value * 10 + (*p - '0');
+        if (p == exponentStart) return NULL;
+        exponent += negativeExponent ? -value : value;
+    }
+    if (mantissa > (UINT64_C(1) << 53) || exponent < -22 || exponent > 22) return NULL;
+    double value = (double)mantissa;
+    value = exponent < 0 ? value / exactPowers[-exponent] : value * exactPowers[exponent];
+    *out = negative ? -value : value;
+    return p;
+}
+
+/**
+ * @brief Parses a decimal number, falling back to `strtod` for the forms
+ *        `scanDecimal` does not convert, including `inf`, `nan` and hexadecimal floats.
+ * @private
+ */
+static const char *parseNumber(char *field, size_t n, double *out){
+    if (scanDecimal(field, out) == field + n) return NULL;
+    char *parsed;
+    errno = 0;
+    double value = strtod(field, &parsed);
+    if (parsed != field + n) return "is not a number";
+    if (errno == ERANGE && isinf(value)) return "is out of range";
+    *out = value;
+    return NULL;
+}
+
+/** @private */
+static const char *scanDouble(const char *p, void *out){
+    return scanDecimal(p, out);
+}
+
+/** @private */
+static const char *parseDouble(char *field, size_t n, void *out){
+    return parseNumber(field, n, out);
+}
+
+/**
+ * @brief Parses a plain decimal into a `float` through `scanDecimal`.
+ *
+ * Rounding to a double and then to a float is correct unless the double
+ * lies exactly halfway between two floats: the decimal may have been just
+ * off the midpoint, so such values are left to `strtof`. All the values
+ * `scanDecimal` converts are normal floats, whose midpoints are the doubles
+ * with only the highest of the 29 extra mantissa bits set.
+ * @private
+ */
+static const char *scanFloat(const char *p, void *out){
+    double value;
+    p = scanDecimal(p, &value);
+    if (p == NULL) return NULL;
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof bits);
+    if ((bits & 0x1FFFFFFF) == 0x10000000) return NULL;
+    *(float *)out = (float)value;
+    return p;
+}
+
+/**
+ * @brief Parses a decimal number as `parseNumber` does, but rounds once,
+ *        straight to a `float`, with `strtof`.
+ * @private
+ */
+static const char *parseFloat(char *field, size_t n, void *out){
+    if (scanFloat(field, out) == field + n) return NULL;
+    char *parsed;
+    errno = 0;
+    float value = strtof(field, &parsed);
+    if (parsed != field + n) return "is not a number";
+    if (errno == ERANGE && isinf(value)) return "is out of range";
+    *(float *)out = value;
+    return NULL;
+}
+
+/** Stores the line itself; `pushArray` copies it. @private */
+static const char *parseLine(char *field, size_t n, void *out){
+    (void)n;
+    *(char **)out = field;
+    return NULL;
+}
+
+/* Driver ------------------------------------------------------------------ */
+
+/** @private */
+static bool isBlank(char c){
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/**
+ * @brief Splits the input on `delim` and newlines and appends every field parsed by `parse`.
+ *
+ * Values that `scan` recognizes are parsed without being split off first,
+ * which saves a pass over the bytes; the rest take the general path. Numeric fields are trimmed of blanks and empty ones are skipped; lines are
+ * only stripped of a trailing `'\r'`.
+ * @private
+ */
+static bool readFields(List list, int fd, char delim, FieldScanner scan, FieldParser parse, const char *function){
+    bool lines = parse == parseLine;
+    Scanner scanner = {
+        ._fd = fd,
+        ._function = function,
+        ._buffer = calloc(TLIST_IO_BYTES + TLIST_PARSE_SLACK, 1),
+        ._capacity = TLIST_IO_BYTES,
+        ._line = 1,
+    };
+    if (scanner._buffer == NULL) {
+        fprintf(stderr, "Error in %s(): Failed to allocate the input buffer.\n", function);
+        exit(EXIT_FAILURE);
+    }
+    unsigned char batch[TLIST_STAGING_BYTES];
+    size_t capacity = TLIST_STAGING_BYTES / list->_size;
+    size_t count = 0;
+    bool ok = true;
+    while (ok){
+        if (scan != NULL) {
+            const char *stop = scan(scanner._buffer + scanner._start, batch + count * list->_size);
+            if (skipValue(&scanner, delim, stop)) {
+                if (++count == capacity) {
+                    pushArray(list, batch, count);
+                    count = 0;
+                }
+                continue;
+            }
+        }
+        char *field;
+        size_t n;
+        if (!nextField(&scanner, delim, &field, &n)) {
+            // Flush first: string slots point into the buffer that `refill` moves.
+            if (count > 0) pushArray(list, batch, count);
+            count = 0;
+            if (scanner._eof) break;
+            ok = refill(&scanner);
+            continue;
+        }
+        if (lines) {
+            if (n > 0 && field[n - 1] == '\r') field[--n] = '\0';
+        } else {
+            while (n > 0 && isBlank(*field)){
+                field++;
+                n--;
+            }
+            while (n > 0 && isBlank(field[n - 1])) n--;
+            if (n == 0) continue;
+            field[n] = '\0';
+        }
+        const char *error = parse(field, n, batch + count * list->_size);
+        if (error != NULL) {
+            uint64_t column = scanner._offset + (uint64_t)(field - scanner._buffer) - scanner._fieldLineStart + 1;
+            int quoted = n > TLIST_QUOTE_BYTES ? TLIST_QUOTE_BYTES : (int)n;
+            fprintf(stderr, "Error in %s(): \"%.*s%s\" %s at line %" PRIu64 ", column %" PRIu64 ".\n",
+                    function, quoted, field, n > TLIST_QUOTE_BYTES ? "..." : "", error, scanner._fieldLine, column);
+            ok = false;
+        } else if (++count == capacity) {
+            pushArray(list, batch, count);
+            count = 0;
+        }
+    }
+    // Values parsed before an error stay appended.
+    if (count > 0) pushArray(list, batch, count);
+    free(scanner._buffer);
+    return ok;
+}
+
+/** @copydoc readInts */
+bool readInts(List list, int fd, char delim){
+    if (!checkType(list, INT, "readInts")) return false;
+    return readFields(list, fd, delim, scanInt, parseInt, "readInts");
+}
+
+/** @copydoc readDoubles */
+bool readDoubles(List list, int fd, char delim){
+    if (list == NULL) {
+        fprintf(stderr, "Error in readDoubles(): The provided list instance is NULL.\n");
+        return false;
+    }
+    if (list->_type != DOUBLE && list->_type != FLOAT) {
+        fprintf(stderr, "Error in readDoubles(): The list does not hold elements of the expected type.\n");
+        return false;
+    }
+    return readFields(list, fd, delim,
+                      list->_type == DOUBLE ? scanDouble : scanFloat,
+                      list->_type == DOUBLE ? parseDouble : parseFloat, "readDoubles");
+}
+
+/** @copydoc readLines */
+bool readLines(List list, int fd){
+    if (!checkType(list, STRING, "readLines")) return false;
+    return readFields(list, fd, '\n', NULL, parseLine, "readLines");
+}
@@ -0,0 +1,446 @@
+/**
+ * @file Tqueue.c
+ * @brief Lock-free multi-producer, multi-consumer queue backend, selected with `LIST_QUEUE`.
+ *
+ * The list is a Michael-Scott queue built from ordinary list nodes: `push`
+ * links a node after the tail with a compare-and-swap, and `pop` swings the
+ * head to the next node, which becomes the new dummy. Any number of threads
+ * may call `push`, `pop`, `popInto`, `pushArray` and `len` concurrently without
+ * a lock.
+ *
+ * Popped dummy nodes cannot be freed right away, since another thread may
+ * still be reading them. Each thread therefore publishes the nodes it is about
+ * to dereference in a hazard record. Retired nodes collect in the thread's
+ * record and are freed in batches of `TLIST_HAZARD_SCAN`, skipping any node
+ * that some thread still lists as hazardous. Records are shared by all queues
+ * and recycled when threads exit. The pending retired nodes stay with the
+ * record and are freed by its next owner.
+ *
+ * `_nextNode` is a plain field of `struct Node`, shared with the other
+ * backends, so it is accessed with the GCC `__atomic` builtins rather than
+ * through an `_Atomic` type.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "Tlist.h"
+#include "TlistPrivate.h"
+#include <pthread.h>
+#include <stdint.h>
+
+/** @brief Returns the queue state of a list. @private */
+#define STORE(list) ((struct QueueStore *)listStore(list))
+
+/** @brief Atomically loads a node's successor. @private */
+#define NEXT(node) __atomic_load_n(&(node)->_nextNode, __ATOMIC_SEQ_CST)
+
+/**
+ * @struct HazardRecord
+ * @brief One thread's hazard pointers and not yet reclaimed nodes.
+ * @private
+ */
+typedef struct HazardRecord{
+    struct HazardRecord *_next;         /**< Next record; records are never unlinked. */
+    atomic_bool _active;                /**< Whether a thread currently owns the record. */
+    _Atomic(Node) _hazards[2];          /**< Nodes the owner may dereference. */
+    Node *_retired;                     /**< Nodes removed from a queue, awaiting reclamation. */
+    size_t _retiredCount;
+    size_t _retiredCapacity;
+} HazardRecord;
+
+/** Head of the list of all hazard records. @private */
+static _Atomic(HazardRecord *) hazardRecords;
+
+/** Number of records in `hazardRecords`. @private */
+static atomic_size_t hazardRecordCount;
+
+/** Releases a thread's record when it exits. @private */
+static pthread_key_t hazardKey;
+static pthread_once_t hazardOnce = PTHREAD_ONCE_INIT;
+
+/** The calling thread's record, or `NULL` before its first queue operation. @private */
+static _Thread_local HazardRecord *ownRecord;
+
+/**
+ * @brief Thread-exit destructor: clears the hazards and hands the record back.
+ * @private
+ */
+static void releaseRecord(void *record){
+    HazardRecord *rec = record;
+    atomic_store(&rec->_hazards[0], NULL);
+    atomic_store(&rec->_hazards[1], NULL);
+    atomic_store(&rec->_active, false);
+}
+
+/** @private */
+static void createHazardKey(void){
+    if (pthread_key_create(&hazardKey, releaseRecord) != 0) {
+        fprintf(stderr, "Error in newList(): Failed to create the hazard pointer key.\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Returns the calling thread's hazard record, claiming or creating one on first use.
+ * @private
+ */
+static HazardRecord *hazardRecord(void){
+    if (ownRecord != NULL) return ownRecord;
+    pthread_once(&hazardOnce, createHazardKey);
+    HazardRecord *rec;
+    for (rec = atomic_load(&hazardRecords); rec != NULL; rec = rec->_next){
+        bool idle = false;
+        if (!atomic_load(&rec->_active) && atomic_compare_exchange_strong(&rec->_active, &idle, true)) break;
+    }
+    if (rec == NULL) {
+        rec = calloc(1, sizeof(HazardRecord));
+        if (rec == NULL) {
+            fprintf(stderr, "Error in push(): Failed to allocate memory for a hazard record.\n");
+            exit(EXIT_FAILURE);
+        }
+        atomic_init(&rec->_active, true);
+        atomic_init(&rec->_hazards[0], NULL);
+        atomic_init(&rec->_hazards[1], NULL);
+        HazardRecord *head = atomic_load(&hazardRecords);
+        do {
+            rec->_next = head;
+        } while (!atomic_compare_exchange_weak(&hazardRecords, &head, rec));
+        atomic_fetch_add(&hazardRecordCount, 1);
+    }
+    pthread_setspecific(hazardKey, rec);
+    ownRecord = rec;
+    return rec;
+}
+
+/**
+ * @brief Publishes the node currently stored in `source` as hazard `slot` and returns it.
+ *
+ * The node is re-read after publishing, so once this returns it cannot be
+ * reclaimed until the hazard is cleared.
+ * @private
+ */
+static Node protect(HazardRecord *rec, int slot, _Atomic(Node) *source){
+    Node node = atomic_load(source);
+    for (;;){
+        atomic_store(&rec->_hazards[slot], node);
+        Node again = atomic_load(source);
+        if (again == node) return node;
+        node = again;
+    }
+}
+
+/** @private */
+static int compareNodes(const void *a, const void *b){
+    uintptr_t x = (uintptr_t)*(const Node *)a;
+    uintptr_t y = (uintptr_t)*(const Node *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Frees the retired nodes of `rec` that no thread holds as a hazard.
+ * @private
+ */
+static void reclaim(HazardRecord *rec){
+    size_t capacity = 2 * atomic_load(&hazardRecordCount) + 2;
+    Node *hazards = malloc(capacity * sizeof(Node));
+    if (hazards == NULL) return;
+    size_t count = 0;
+    // Records pushed since the count was read are linked in front, so walk the
+    // whole chain rather than stopping after `capacity / 2` records.
+    for (HazardRecord *other = atomic_load(&hazardRecords); other != NULL; other = other->_next){
+        if (count + 2 > capacity) {
+            Node *grown = realloc(hazards, 2 * capacity * sizeof(Node));
+            if (grown == NULL) {
+                // Without every hazard no node is known to be safe; the next scan retries.
+                free(hazards);
+                return;
+            }
+            hazards = grown;
+            capacity *= 2;
+        }
+        for (int i = 0; i < 2; i++){
+            Node node = atomic_load(&other->_hazards[i]);
+            if (node != NULL) hazards[count++] = node;
+        }
+    }
+    qsort(hazards, count, sizeof(Node), compareNodes);
+    size_t kept = 0;
+    for (size_t i = 0; i < rec->_retiredCount; i++){
+        Node node = rec->_retired[i];
+        if (count > 0 && bsearch(&node, hazards, count, sizeof(Node), compareNodes) != NULL) {
+            rec->_retired[kept++] = node;
+        } else {
+            free(node);
+        }
+    }
+    rec->_retiredCount = kept;
+    free(hazards);
+}
+
+/**
+ * @brief Hands a node that is no longer reachable from the queue over for reclamation.
+ *
+ * The node's value has already been taken by `pop`, so only its storage is freed.
+ * @private
+ */
+static void retire(HazardRecord *rec, Node node){
+    if (rec->_retiredCount == rec->_retiredCapacity) {
+        size_t capacity = rec->_retiredCapacity == 0 ? TLIST_HAZARD_SCAN : rec->_retiredCapacity * 2;
+        Node *retired = realloc(rec->_retired, capacity * sizeof(Node));
+        if (retired == NULL) {
+            fprintf(stderr, "Error in pop(): Failed to allocate memory for retired nodes.\n");
+            exit(EXIT_FAILURE);
+        }
+        rec->_retired = retired;
+        rec->_retiredCapacity = capacity;
+    }
+    rec->_retired[rec->_retiredCount++] = node;
+    if (rec->_retiredCount >= TLIST_HAZARD_SCAN) reclaim(rec);
+}
+
+/**
+ * @brief Links a new node holding `val` (in `readArg` form) after the tail.
+ * @private
+ */
+static void queuePushValue(List this, void *val){
+    struct QueueStore *store = STORE(this);
+    HazardRecord *rec = hazardRecord();
+    Node node = newNode(this, val);
+    for (;;){
+        Node tail = protect(rec, 0, &store->_tail);
+        Node next = NEXT(tail);
+        if (tail != atomic_load(&store->_tail)) continue;
+        if (next != NULL) {
+            // Another producer linked a node but has not swung the tail yet; help it.
+            atomic_compare_exchange_strong(&store->_tail, &tail, next);
+            continue;
+        }
+        if (__atomic_compare_exchange_n(&tail->_nextNode, &next, node, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+            atomic_compare_exchange_strong(&store->_tail, &tail, node);
+            break;
+        }
+    }
+    atomic_store(&rec->_hazards[0], NULL);
+    atomic_fetch_add(&store->_length, 1);
+}
+
+/**
+ * @brief Unlinks the first element and writes its value to `out`, as `popInto` does.
+ * @return `false` if the queue was empty.
+ * @private
+ */
+static bool queuePopValue(List this, void *out){
+    struct QueueStore *store = STORE(this);
+    HazardRecord *rec = hazardRecord();
+    Node head;
+    Node next;
+    for (;;){
+        head = protect(rec, 0, &store->_head);
+        Node tail = atomic_load(&store->_tail);
+        next = NEXT(head);
+        atomic_store(&rec->_hazards[1], next);
+        if (head != atomic_load(&store->_head)) continue;
+        if (next == NULL) {
+            atomic_store(&rec->_hazards[0], NULL);
+            atomic_store(&rec->_hazards[1], NULL);
+            return false;
+        }
+        if (head == tail) {
+            atomic_compare_exchange_strong(&store->_tail, &tail, next);
+            continue;
+        }
+        if (atomic_compare_exchange_strong(&store->_head, &head, next)) break;
+    }
+    // `next` is the new dummy; its value belongs to this thread alone.
+    switch (this->_type){
+        case STRING:
+            *(char **)out = detachValue(this, next);
+            break;
+        case T:
+            *(void **)out = next->_val;
+            break;
+        default:
+            memcpy(out, next->_val, this->_size);
+            break;
+    }
+    atomic_store(&rec->_hazards[0], NULL);
+    atomic_store(&rec->_hazards[1], NULL);
+    atomic_fetch_sub(&store->_length, 1);
+    if (head != (Node)store->_sentinel) {
+        // Counted as freed now, though its thread frees it once no hazard protects it.
+        STAT_MEMORY(this, -(long long)this->_nodeSize, 0, 0, 1);
+        retire(rec, head);
+    }
+    return true;
+}
+
+/**
+ * @brief Appends the values of an array one by one; queues have no other insertion point.
+ * @private
+ */
+static void queueInsertArray(List this, int index, const void *values, size_t n){
+    (void)index;
+    for (size_t i = 0; i < n; i++){
+        queuePushValue(this, arrayValue(this, values, i));
+    }
+}
+
+/** @private */
+static void queueUnsupported(const char *function){
+    fprintf(stderr, "Error in %s(): LIST_QUEUE lists only support push and pop.\n", function);
+}
+
+/** @private */
+static void queueInsertValue(List this, int index, void *val){
+    (void)this; (void)index; (void)val;
+    queueUnsupported("insert");
+}
+
+/** @private */
+static void queueSetValue(List this, int index, void *val){
+    (void)this; (void)index; (void)val;
+    queueUnsupported("set");
+}
+
+/** @private */
+static void *queuePop(List this){
+    if (this == NULL) {
+        fprintf(stderr, "Error in pop(): The provided list instance is NULL.\n");
+        return NULL;
+    }
+    Scalar value;
+    if (!queuePopValue(this, &value)) return NULL;
+    if (this->_type == STRING || this->_type == T) return value._ptr;
+    void *copy = malloc(this->_size);
+    if (copy == NULL) {
+        fprintf(stderr, "Error in pop(): Failed to allocate memory for the returned value.\n");
+        exit(EXIT_FAILURE);
+    }
+    STAT_MEMORY(this, 0, 0, 1, 0);
+    memcpy(copy, &value, this->_size);
+    return copy;
+}
+
+/** @private */
+static int queueLen(List this){
+    if (this == NULL) {
+        fprintf(stderr, "Error in len(): The provided list instance is NULL.\n");
+        return -1;
+    }
+    return atomic_load(&STORE(this)->_length);
+}
+
+/** @copydoc queueFirst */
+Node queueFirst(List this){
+    return NEXT(atomic_load(&STORE(this)->_head));
+}
+
+/** @private */
+static void queuePrint(List this){
+    if (this == NULL) {
+        fprintf(stderr, "Error in print(): The provided list instance is NULL.\n");
+        return;
+    }
+    printf("[");
+    for (Node current = queueFirst(this); current != NULL; current = NEXT(current)){
+        printValue(this, current->_val);
+        if (NEXT(current) != NULL){
+            printf(", ");
+        }
+    }
+    printf("]");
+    printf("\n");
+}
+
+/** @private */
+static void queueForeach(List this, void(*function)(void*)){
+    if (this == NULL || function == NULL) {
+        fprintf(stderr, "Error in foreach(): The list and the function must not be NULL.\n");
+        return;
+    }
+    for (Node current = queueFirst(this); current != NULL; current = NEXT(current)){
+        function(current->_val);
+    }
+}
+
+/**
+ * @brief Frees the queued nodes and their values, leaving an empty queue.
+ *
+ * No other thread may use the list during the call. Nodes retired by earlier
+ * `pop` calls are freed by their threads' hazard records, not here.
+ * @private
+ */
+static void queueDestroy(List this){
+    if (this == NULL) {
+        fprintf(stderr, "Error in destroyList(): The provided list instance is NULL.\n");
+        return;
+    }
+    struct QueueStore *store = STORE(this);
+    Node dummy = atomic_load(&store->_head);
+    Node current = dummy->_nextNode;
+    while (current != NULL){
+        Node temp = current;
+        current = temp->_nextNode;
+        releaseValue(this, temp);
+        releaseNode(this, temp);
+    }
+    if (dummy != (Node)store->_sentinel) releaseNode(this, dummy);
+    dummy = (Node)store->_sentinel;
+    dummy->_val = NULL;
+    dummy->_nextNode = NULL;
+    atomic_store(&store->_head, dummy);
+    atomic_store(&store->_tail, dummy);
+    atomic_store(&store->_length, 0);
+    releaseExtra(this);
+}
+
+/** @private */
+static void *queueGet(List this, int index){
+    (void)this; (void)index;
+    queueUnsupported("get");
+    return NULL;
+}
+
+/** @private */
+static void queueDelete(List this, int index){
+    (void)this; (void)index;
+    queueUnsupported("remove");
+}
+
+/** @private */
+static void *queuePick(List this, int index){
+    (void)this; (void)index;
+    queueUnsupported("pick");
+    return NULL;
+}
+
+/**
+ * @brief Methods of `LIST_QUEUE` lists, one table per `Type`.
+ * @private
+ */
+static const struct ListMethods queueMethods[TLIST_TYPES] = LIST_METHODS(
+    .pop = queuePop,
+    .print = queuePrint,
+    .len = queueLen,
+    .free = queueDestroy,
+    .get = queueGet,
+    .remove = queueDelete,
+    .pick = queuePick,
+    .foreach = queueForeach,
+    .pushValue = queuePushValue,
+    .insertValue = queueInsertValue,
+    .setValue = queueSetValue,
+    .popValue = queuePopValue,
+    .insertArray = queueInsertArray,
+);
+
+/** @copydoc initQueue */
+void initQueue(List this, struct QueueStore *store){
+    Node dummy = (Node)store->_sentinel;
+    dummy->_val = NULL;
+    dummy->_nextNode = NULL;
+    atomic_init(&store->_head, dummy);
+    atomic_init(&store->_tail, dummy);
+    atomic_init(&store->_length, 0);
+    setMethods(this, &queueMethods[this->_type]);
+}
@@ -0,0 +1,710 @@
+/**
+ * @file Treduce.c
+ * @brief Numeric reductions (`listSum`, `listMin`, `listMax`, `listMean`) and
+ *        value searches (`listIndexOf`, `listCountOf`).
+ *
+ * Elements are processed as contiguous segments (see `forEachSegment`): the
+ * vector backend's array and the unrolled backend's chunks are used in place,
+ * and linked-list values are gathered into a staging buffer. Each segment is
+ * handed to a kernel chosen at run time: AVX2 when the CPU supports it, SSE2
+ * otherwise on x86, and portable scalar code everywhere else or when the
+ * library is built with `TLIST_NO_SIMD`.
+ *
+ * Sums of `INT` lists are accumulated in 64-bit integers and sums of `FLOAT`
+ * lists in `double`. The SIMD kernels add in a different order than a plain
+ * loop, so floating-point sums may differ from it in the last bits. The
+ * results of `listMin`/`listMax` are unspecified if the list contains NaN.
+ */
+
+#include "Tlist.h"
+#include "TlistPrivate.h"
+#include <stdint.h>
+
+#if !defined(TLIST_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TLIST_X86_SIMD
+#include <immintrin.h>
+#endif
+
+/**
+ * @struct Kernels
+ * @brief One implementation of every segment kernel.
+ *
+ * `minmax*` kernels fold a segment into `*min`/`*max`, which must already hold
+ * a value. `match*` kernels count the elements equal to `value`, stop once
+ * `limit` matches have been seen, and store the position of the first match
+ * in `*first`.
+ * @private
+ */
+typedef struct Kernels{
+    long long (*sumInt)(const int *v, size_t n);
+    double (*sumFloat)(const float *v, size_t n);
+    double (*sumDouble)(const double *v, size_t n);
+    void (*minmaxInt)(const int *v, size_t n, int *min, int *max);
+    void (*minmaxFloat)(const float *v, size_t n, float *min, float *max);
+    void (*minmaxDouble)(const double *v, size_t n, double *min, double *max);
+    size_t (*matchInt)(const int *v, size_t n, int value, size_t limit, size_t *first);
+    size_t (*matchFloat)(const float *v, size_t n, float value, size_t limit, size_t *first);
+    size_t (*matchDouble)(const double *v, size_t n, double value, size_t limit, size_t *first);
+} Kernels;
+
+/* Scalar kernels ---------------------------------------------------------- */
+
+static long long sumIntScalar(const int *v, size_t n){
+    long long sum = 0;
+    for (size_t i = 0; i < n; i++) sum += v[i];
+    return sum;
+}
+
+static double sumFloatScalar(const float *v, size_t n){
+    double sum = 0;
+    for (size_t i = 0; i < n; i++) sum += v[i];
+    return sum;
+}
+
+static double sumDoubleScalar(const double *v, size_t n){
+    double sum = 0;
+    for (size_t i = 0; i < n; i++) sum += v[i];
+    return sum;
+}
+
+static void minmaxIntScalar(const int *v, size_t n, int *min, int *max){
+    for (size_t i = 0; i < n; i++){
+        if (v[i] < *min) *min = v[i];
+        if (v[i] > *max) *max = v[i];
+    }
+}
+
+static void minmaxFloatScalar(const float *v, size_t n, float *min, float *max){
+    for (size_t i = 0; i < n; i++){
+        if (v[i] < *min) *min = v[i];
+        if (v[i] > *max) *max = v[i];
+    }
+}
+
+static void minmaxDoubleScalar(const double *v, size_t n, double *min, double *max){
+    for (size_t i = 0; i < n; i++){
+        if (v[i] < *min) *min = v[i];
+        if (v[i] > *max) *max = v[i];
+    }
+}
+
+static size_t matchIntScalar(const int *v, size_t n, int value, size_t limit, size_t *first){
+    size_t count = 0;
+    for (size_t i = 0; i < n && count < limit; i++){
+        if (v[i] == value && count++ == 0) *first = i;
+    }
+    return count;
+}
+
+static size_t matchFloatScalar(const float *v, size_t n, float value, size_t limit, size_t *first){
+    size_t count = 0;
+    for (size_t i = 0; i < n && count < limit; i++){
+        if (v[i] == value && count++ == 0) *first = i;
+    }
+    return count;
+}
+
+static size_t matchDoubleScalar(const double *v, size_t n, double value, size_t limit, size_t *first){
+    size_t count = 0;
+    for (size_t i = 0; i < n && count < limit; i++){
+        if (v[i] == value && count++ == 0) *first = i;
+    }
+    return count;
+}
+
+static const Kernels scalarKernels = {
+    sumIntScalar, sumFloatScalar, sumDoubleScalar,
+    minmaxIntScalar, minmaxFloatScalar, minmaxDoubleScalar,
+    matchIntScalar, matchFloatScalar, matchDoubleScalar,
+};
+
+#ifdef TLIST_X86_SIMD
+
+/**
+ * @brief Records the matches of one vector compare, given as a bit mask.
+ * @return `true` once `limit` matches have been counted.
+ * @private
+ */
+static inline bool recordMatches(unsigned mask, size_t i, size_t limit, size_t *count, size_t *first){
+    if (mask == 0) return false;
+    if (*count == 0) *first = i + (size_t)__builtin_ctz(mask);
+    *count += (size_t)__builtin_popcount(mask);
+    return *count >= limit;
+}
+
+/* SSE2 kernels ------------------------------------------------------------ */
+
+__attribute__((target("sse2")))
+static long long sumIntSse2(const int *v, size_t n){
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4){
+        __m128i x = _mm_loadu_si128((const __m128i *)(v + i));
+        __m128i sign = _mm_srai_epi32(x, 31);
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(x, sign));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(x, sign));
+    }
+    long long lanes[2];
+    _mm_storeu_si128((__m128i *)lanes, acc);
+    return lanes[0] + lanes[1] + sumIntScalar(v + i, n - i);
+}
+
+__attribute__((target("sse2")))
+static double sumFloatSse2(const float *v, size_t n){
+    __m128d acc = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4){
+        __m128 x = _mm_loadu_ps(v + i);
+        acc = _mm_add_pd(acc, _mm_cvtps_pd(x));
+        acc = _mm_add_pd(acc, _mm_cvtps_pd(_mm_movehl_ps(x, x)));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, acc);
+    return lanes[0] + lanes[1] + sumFloatScalar(v + i, n - i);
+}
+
+__attribute__((target("sse2")))
+static double sumDoubleSse2(const double *v, size_t n){
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4){
+        acc0 = _mm_add_pd(acc0, _mm_loadu_pd(v + i));
+        acc1 = _mm_add_pd(acc1, _mm_loadu_pd(v + i + 2));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+    return lanes[0] + lanes[1] + sumDoubleScalar(v + i, n - i);
+}
+
+__attribute__((target("sse2")))
+static void minmaxIntSse2(const int *v, size_t n, int *min, int *max){
+    __m128i lo = _mm_set1_epi32(*min);
+    __m128i hi = _mm_set1_epi32(*max);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4){
+        __m128i x = _mm_loadu_si128((const __m128i *)(v + i));
+        __m128i less = _mm_cmplt_epi32(x, lo);
+        __m128i greater = _mm_cmpgt_epi32(x, hi);
+        lo = _mm_or_si128(_mm_and_si128(less, x), _mm_andnot_si128(less, lo));
+        hi = _mm_or_si128(_mm_and_si128(greater, x), _mm_andnot_si128(greater, hi));
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i *)lanes, lo);
+    minmaxIntScalar(lanes, 4, min, max);
+    _mm_storeu_si128((__m128i *)lanes, hi);
+    minmaxIntScalar(lanes, 4, min, max);
+    minmaxIntScalar(v + i, n - i, min, max);
+}
+
+__attribute__((target("sse2")))
+static void minmaxFloatSse2(const float *v, size_t n, float *min, float *max){
+    __m128 lo = _mm_set1_ps(*min);
+    __m128 hi = _mm_set1_ps(*max);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4){
+        __m128 x = _mm_loadu_ps(v + i);
+        lo = _mm_min_ps(lo, x);
+        hi = _mm_max_ps(hi, x);
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, lo);
+    minmaxFloatScalar(lanes, 4, min, max);
+    _mm_storeu_ps(lanes, hi);
+    minmaxFloatScalar(lanes, 4, min, max);
+    minmaxFloatScalar(v + i, n - i, min, max);
+}
+
+__attribute__((target("sse2")))
+static void minmaxDoubleSse2(const double *v, size_t n, double *min, double *max){
+    __m128d lo = _mm_set1_pd(*min);
+    __m128d hi = _mm_set1_pd(*max);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2){
+        __m128d x = _mm_loadu_pd(v + i);
+        lo = _mm_min_pd(lo, x);
+        hi = _mm_max_pd(hi, x);
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, lo);
+    minmaxDoubleScalar(lanes, 2, min, max);
+    _mm_storeu_pd(lanes, hi);
+    minmaxDoubleScalar(lanes, 2, min, max);
+    minmaxDoubleScalar(v + i, n - i, min, max);
+}
+
+__attribute__((target("sse2")))
+static size_t matchIntSse2(const int *v, size_t n, int value, size_t limit, size_t *first){
+    __m128i needle = _mm_set1_epi32(value);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4){
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(v + i)), needle);
+        if (recordMatches((unsigned)_mm_movemask_ps(_mm_castsi128_ps(eq)), i, limit, &count, first)) return count;
+    }
+    size_t tailFirst = 0;
+    size_t tail = matchIntScalar(v + i, n - i, value, limit - count, &tailFirst);
+    if (count == 0 && tail > 0) *first = i + tailFirst;
+    return count + tail;
+}
+
+__attribute__((target("sse2")))
+static size_t matchFloatSse2(const float *v, size_t n, float value, size_t limit, size_t *first){
+    __m128 needle = _mm_set1_ps(value);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4){
+        __m128 eq = _mm_cmpeq_ps(_mm_loadu_ps(v + i), needle);
+        if (recordMatches((unsigned)_mm_movemask_ps(eq), i, limit, &count, first)) return count;
+    }
+    size_t tailFirst = 0;
+    size_t tail = matchFloatScalar(v + i, n - i, value, limit - count, &tailFirst);
+    if (count == 0 && tail > 0) *first = i + tailFirst;
+    return count + tail;
+}
+
+__attribute__((target("sse2")))
+static size_t matchDoubleSse2(const double *v, size_t n, double value, size_t limit, size_t *first){
+    __m128d needle = _mm_set1_pd(value);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2){
+        __m128d eq = _mm_cmpeq_pd(_mm_loadu_pd(v + i), needle);
+        if (recordMatches((unsigned)_mm_movemask_pd(eq), i, limit, &count, first)) return count;
+    }
+    size_t tailFirst = 0;
+    size_t tail = matchDoubleScalar(v + i, n - i, value, limit - count, &tailFirst);
+    if (count == 0 && tail > 0) *first = i + tailFirst;
+    return count + tail;
+}
+
+static const Kernels sse2Kernels = {
+    sumIntSse2, sumFloatSse2, sumDoubleSse2,
+    minmaxIntSse2, minmaxFloatSse2, minmaxDoubleSse2,
+    matchIntSse2, matchFloatSse2, matchDoubleSse2,
+};
+
+/* AVX2 kernels ------------------------------------------------------------ */
+
+__attribute__((target("avx2")))
+static long long sumIntAvx2(const int *v, size_t n){
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8){
+        __m256i x = _mm256_loadu_si256((const __m256i *)(v + i));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1)));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sumIntScalar(v + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static double sumFloatAvx2(const float *v, size_t n){
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8){
+        __m256 x = _mm256_loadu_ps(v + i);
+        acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(_mm256_castps256_ps128(x)));
+        acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(_mm256_extractf128_ps(x, 1)));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sumFloatScalar(v + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static double sumDoubleAvx2(const double *v, size_t n){
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8){
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(v + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(v + i + 4));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sumDoubleScalar(v + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static void minmaxIntAvx2(const int *v, size_t n, int *min, int *max){
+    __m256i lo = _mm256_set1_epi32(*min);
+    __m256i hi = _mm256_set1_epi32(*max);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8){
+        __m256i x = _mm256_loadu_si256((const __m256i *)(v + i));
+        lo = _mm256_min_epi32(lo, x);
+        hi = _mm256_max_epi32(hi, x);
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, lo);
+    minmaxIntScalar(lanes, 8, min, max);
+    _mm256_storeu_si256((__m256i *)lanes, hi);
+    minmaxIntScalar(lanes, 8, min, max);
+    minmaxIntScalar(v + i, n - i, min, max);
+}
+
+__attribute__((target("avx2")))
+static void minmaxFloatAvx2(const float *v, size_t n, float *min, float *max){
+    __m256 lo = _mm256_set1_ps(*min);
+    __m256 hi = _mm256_set1_ps(*max);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8){
+        __m256 x = _mm256_loadu_ps(v + i);
+        lo = _mm256_min_ps(lo, x);
+        hi = _mm256_max_ps(hi, x);
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, lo);
+    minmaxFloatScalar(lanes, 8, min, max);
+    _mm256_storeu_ps(lanes, hi);
+    minmaxFloatScalar(lanes, 8, min, max);
+    minmaxFloatScalar(v + i, n - i, min, max);
+}
+
+__attribute__((target("avx2")))
+static void minmaxDoubleAvx2(const double *v, size_t n, double *min, double *max){
+    __m256d lo = _mm256_set1_pd(*min);
+    __m256d hi = _mm256_set1_pd(*max);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4){
+        __m256d x = _mm256_loadu_pd(v + i);
+        lo = _mm256_min_pd(lo, x);
+        hi = _mm256_max_pd(hi, x);
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, lo);
+    minmaxDoubleScalar(lanes, 4, min, max);
+    _mm256_storeu_pd(lanes, hi);
+    minmaxDoubleScalar(lanes, 4, min, max);
+    minmaxDoubleScalar(v + i, n - i, min, max);
+}
+
+__attribute__((target("avx2")))
+static size_t matchIntAvx2(const int *v, size_t n, int value, size_t limit, size_t *first){
+    __m256i needle = _mm256_set1_epi32(value);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8){
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(v + i)), needle);
+        if (recordMatches((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(eq)), i, limit, &count, first)) return count;
+    }
+    size_t tailFirst = 0;
+    size_t tail = matchIntScalar(v + i, n - i, value, limit - count, &tailFirst);
+    if (count == 0 && tail > 0) *first = i + tailFirst;
+    return count + tail;
+}
+
+__attribute__((target("avx2")))
+static size_t matchFloatAvx2(const float *v, size_t n, float value, size_t limit, size_t *first){
+    __m256 needle = _mm256_set1_ps(value);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8){
+        __m256 eq = _mm256_cmp_ps(_mm256_loadu_ps(v + i), needle, _CMP_EQ_OQ);
+        if (recordMatches((unsigned)_mm256_movemask_ps(eq), i, limit, &count, first)) return count;
+    }
+    size_t tailFirst = 0;
+    size_t tail = matchFloatScalar(v + i, n - i, value, limit - count, &tailFirst);
+    if (count == 0 && tail > 0) *first = i + tailFirst;
+    return count + tail;
+}
+
+__attribute__((target("avx2")))
+static size_t matchDoubleAvx2(const double *v, size_t n, double value, size_t limit, size_t *first){
+    __m256d needle = _mm256_set1_pd(value);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4){
+        __m256d eq = _mm256_cmp_pd(_mm256_loadu_pd(v + i), needle, _CMP_EQ_OQ);
+        if (recordMatches((unsigned)_mm256_movemask_pd(eq), i, limit, &count, first)) return count;
+    }
+    size_t tailFirst = 0;
+    size_t tail = matchDoubleScalar(v + i, n - i, value, limit - count, &tailFirst);
+    if (count == 0 && tail > 0) *first = i + tailFirst;
+    return count + tail;
+}
+
+static const Kernels avx2Kernels = {
+    sumIntAvx2, sumFloatAvx2, sumDoubleAvx2,
+    minmaxIntAvx2, minmaxFloatAvx2, minmaxDoubleAvx2,
+    matchIntAvx2, matchFloatAvx2, matchDoubleAvx2,
+};
+
+#endif
+
+/** Kernels set by `forceSimdLevel`, `NULL` for the automatic choice. @private */
+static const Kernels *forcedKernels;
+
+/**
+ * @brief Picks the best kernels supported by the running CPU.
+ * @private
+ */
+static const Kernels *kernels(void){
+    if (forcedKernels != NULL) return forcedKernels;
+#ifdef TLIST_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return &avx2Kernels;
+    if (__builtin_cpu_supports("sse2")) return &sse2Kernels;
+#endif
+    return &scalarKernels;
+}
+
+/** @copydoc forceSimdLevel */
+bool forceSimdLevel(const char *level){
+    if (level == NULL) {
+        forcedKernels = NULL;
+        return true;
+    }
+    if (strcmp(level, "scalar") == 0) {
+        forcedKernels = &scalarKernels;
+        return true;
+    }
+#ifdef TLIST_X86_SIMD
+    __builtin_cpu_init();
+    if (strcmp(level, "avx2") == 0 && __builtin_cpu_supports("avx2")) {
+        forcedKernels = &avx2Kernels;
+        return true;
+    }
+    if (strcmp(level, "sse2") == 0 && __builtin_cpu_supports("sse2")) {
+        forcedKernels = &sse2Kernels;
+        return true;
+    }
+#endif
+    return false;
+}
+
+/** @copydoc simdLevel */
+const char *simdLevel(void){
+    const Kernels *k = kernels();
+#ifdef TLIST_X86_SIMD
+    if (k == &avx2Kernels) return "avx2";
+    if (k == &sse2Kernels) return "sse2";
+#endif
+    (void)k;
+    return "scalar";
+}
+
+/**
+ * @brief Checks that a reduction is applied to a non-empty numeric list.
+ * @private
+ */
+static bool numericList(List this, const char *function){
+    if (this == NULL) {
+        fprintf(stderr, "Error in %s(): The provided list instance is NULL.\n", function);
+        return false;
+    }
+    if (this->_type != INT && this->_type != FLOAT && this->_type != DOUBLE) {
+        fprintf(stderr, "Error in %s(): Only INT, FLOAT and DOUBLE lists can be reduced.\n", function);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @struct Reduction
+ * @brief State shared by the reduction visitors.
+ * @private
+ */
+typedef struct Reduction{
+    const Kernels *_kernels;
+    Type _type;
+    long long _intSum;
+    double _sum;
+    bool _started;
+    Scalar _min;
+    Scalar _max;
+} Reduction;
+
+/** @private */
+static bool sumSegment(const void *data, size_t n, void *context){
+    Reduction *r = context;
+    switch (r->_type){
+        case INT: r->_intSum += r->_kernels->sumInt(data, n); break;
+        case FLOAT: r->_sum += r->_kernels->sumFloat(data, n); break;
+        default: r->_sum += r->_kernels->sumDouble(data, n); break;
+    }
+    return true;
+}
+
+/** @private */
+static bool minmaxSegment(const void *data, size_t n, void *context){
+    Reduction *r = context;
+    if (!r->_started) {
+        memcpy(&r->_min, data, r->_type == INT ? sizeof(int) : r->_type == FLOAT ? sizeof(float) : sizeof(double));
+        r->_max = r->_min;
+        r->_started = true;
+    }
+    switch (r->_type){
+        case INT: r->_kernels->minmaxInt(data, n, &r->_min._int, &r->_max._int); break;
+        case FLOAT: r->_kernels->minmaxFloat(data, n, &r->_min._float, &r->_max._float); break;
+        default: r->_kernels->minmaxDouble(data, n, &r->_min._double, &r->_max._double); break;
+    }
+    return true;
+}
+
+/** @copydoc listSum */
+double listSum(List this){
+    if (!numericList(this, "listSum")) return 0;
+    if (!listLock(this, false)) return 0;
+    Reduction r = { ._kernels = kernels(), ._type = this->_type };
+    forEachSegment(this, sumSegment, &r);
+    listUnlock(this);
+    return this->_type == INT ? (double)r._intSum : r._sum;
+}
+
+/** @copydoc listMean */
+double listMean(List this){
+    if (!numericList(this, "listMean") || !listLock(this, false)) return 0;
+    double mean = 0;
+    if (this->_length == 0) {
+        fprintf(stderr, "Error in listMean(): The list is empty.\n");
+    } else {
+        mean = listSum(this) / this->_length;
+    }
+    listUnlock(this);
+    return mean;
+}
+
+/**
+ * @brief Computes both extremes of a numeric list.
+ * @private
+ */
+static bool minMax(List this, const char *function, double *min, double *max){
+    if (!numericList(this, function) || !listLock(this, false)) return false;
+    if (this->_length == 0) {
+        fprintf(stderr, "Error in %s(): The list is empty.\n", function);
+        listUnlock(this);
+        return false;
+    }
+    Reduction r = { ._kernels = kernels(), ._type = this->_type };
+    forEachSegment(this, minmaxSegment, &r);
+    listUnlock(this);
+    switch (this->_type){
+        case INT: *min = r._min._int; *max = r._max._int; break;
+        case FLOAT: *min = r._min._float; *max = r._max._float; break;
+        default: *min = r._min._double; *max = r._max._double; break;
+    }
+    return true;
+}
+
+/** @copydoc listMin */
+double listMin(List this){
+    double min = 0, max = 0;
+    minMax(this, "listMin", &min, &max);
+    return min;
+}
+
+/** @copydoc listMax */
+double listMax(List this){
+    double min = 0, max = 0;
+    minMax(this, "listMax", &min, &max);
+    return max;
+}
+
+/**
+ * @struct Search
+ * @brief State shared by the search visitor.
+ * @private
+ */
+typedef struct Search{
+    const Kernels *_kernels;
+    Type _type;
+    void *_value;       /**< Needle, in `readArg` form. */
+    bool _identity;     /**< Compare pointers: `T` lists, and strings of `LIST_INTERN` lists. */
+    size_t _limit;      /**< Stop after this many matches. */
+    size_t _count;      /**< Matches found so far. */
+    size_t _first;      /**< Index of the first match. */
+    size_t _offset;     /**< Index of the segment's first element. */
+} Search;
+
+/** @private */
+static bool searchSegment(const void *data, size_t n, void *context){
+    Search *s = context;
+    size_t first = 0;
+    size_t found = 0;
+    size_t limit = s->_limit - s->_count;
+    switch (s->_type){
+        case INT: found = s->_kernels->matchInt(data, n, *(int *)s->_value, limit, &first); break;
+        case FLOAT: found = s->_kernels->matchFloat(data, n, *(float *)s->_value, limit, &first); break;
+        case DOUBLE: found = s->_kernels->matchDouble(data, n, *(double *)s->_value, limit, &first); break;
+        case STRING:
+        case T:
+            for (size_t i = 0; i < n && found < limit; i++){
+                void *element = ((void *const *)data)[i];
+                bool equal = s->_identity ? element == s->_value : strcmp(element, s->_value) == 0;
+                if (equal && found++ == 0) first = i;
+            }
+            break;
+    }
+    if (found > 0 && s->_count == 0) s->_first = s->_offset + first;
+    s->_count += found;
+    s->_offset += n;
+    return s->_count < s->_limit;
+}
+
+/**
+ * @brief Runs a search for `value` (in `readArg` form) with the given match limit.
+ *
+ * Indexed lists count the matches through their hash index, and walk the list
+ * only when `locate` asks for the position of the first one.
+ * @private
+ */
+static Search search(List this, void *value, size_t limit, bool locate){
+    Search s = { ._kernels = kernels(), ._type = this->_type, ._value = value, ._limit = limit, ._identity = this->_type == T };
+    if (this->_type == STRING && value == NULL) return s;
+    if (!listLock(this, false)) return s;
+    if (this->_extra->_index != NULL) {
+        s._count = indexMatches(this, value, limit, locate ? &s._first : NULL);
+        listUnlock(this);
+        return s;
+    }
+    if (this->_flags & LIST_INTERN) {
+        // Equal elements are the stored copy itself; a string never stored matches nothing.
+        s._value = (void *)findInterned(this, value);
+        s._identity = true;
+        if (s._value == NULL) {
+            listUnlock(this);
+            return s;
+        }
+    }
+    forEachSegment(this, searchSegment, &s);
+    listUnlock(this);
+    return s;
+}
+
+/** @copydoc countValue */
+size_t countValue(List this, void *val, size_t limit){
+    return search(this, val, limit, false)._count;
+}
+
+/** @copydoc listIndexOf */
+int listIndexOf(List this, ...){
+    if (this == NULL) {
+        fprintf(stderr, "Error in listIndexOf(): The provided list instance is NULL.\n");
+        return -1;
+    }
+    va_list args;
+    va_start(args, this);
+    Scalar tmp;
+    Search s = search(this, readArg(this, &args, &tmp), 1, true);
+    va_end(args);
+    return s._count > 0 ? (int)s._first : -1;
+}
+
+/** @copydoc listCountOf */
+int listCountOf(List this, ...){
+    if (this == NULL) {
+        fprintf(stderr, "Error in listCountOf(): The provided list instance is NULL.\n");
+        return 0;
+    }
+    va_list args;
+    va_start(args, this);
+    Scalar tmp;
+    Search s = search(this, readArg(this, &args, &tmp), SIZE_MAX, false);
+    va_end(args);
+    return (int)s._count;
+}
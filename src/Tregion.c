@@ -0,0 +1,178 @@
+/**
+ * @file Tregion.c
+ * @brief A bump allocator for lists that are discarded all at once.
+ *
+ * A region hands out memory from large blocks by advancing an offset, so an
+ * allocation costs a comparison and an addition, and nothing is freed one
+ * element at a time. Freeing the latest allocation gives its bytes back, and
+ * growing it extends it in place when the block has room; any other `free`
+ * is a no-op. `resetRegion` and `freeRegion` release everything at once.
+ */
+
+#include "Tlist.h"
+#include "TlistPrivate.h"
+
+/**
+ * @brief Size of a region block when `newRegion` is given 0.
+ * @private
+ */
+#define TLIST_REGION_BLOCK (1 << 16)
+
+/**
+ * @struct RegionBlock
+ * @brief A block of memory handed out by a region.
+ * @private
+ */
+struct RegionBlock{
+    struct RegionBlock *_nextBlock;
+    size_t _capacity;
+    size_t _used;
+    _Alignas(max_align_t) unsigned char _bytes[];
+};
+
+/**
+ * @struct TRegion
+ * @brief A region and the allocator that lists use to reach it.
+ * @private
+ */
+struct TRegion{
+    TAllocator _allocator;          /**< Functions handed to `newListWithAllocator`; `context` is the region. */
+    struct RegionBlock *_blocks;    /**< Blocks, the one being filled first. */
+    size_t _blockSize;
+    void *_last;                    /**< Latest allocation of the current block, or `NULL`. */
+};
+
+/** @brief Rounds `size` up to the alignment of every allocation. @private */
+#define REGION_ALIGN(size) (((size) + _Alignof(max_align_t) - 1) / _Alignof(max_align_t) * _Alignof(max_align_t))
+
+/**
+ * @brief Allocates a block with room for `size` bytes.
+ *
+ * Requests larger than a quarter of the block size get a block of their
+ * own, linked behind the current block so that it keeps filling up.
+ * Otherwise the new block becomes the current one.
+ * @private
+ */
+static struct RegionBlock *addBlock(TRegion *region, size_t size){
+    bool dedicated = size > region->_blockSize / 4;
+    size_t capacity = dedicated ? size : region->_blockSize;
+    struct RegionBlock *block = malloc(sizeof(struct RegionBlock) + capacity);
+    if (block == NULL) return NULL;
+    block->_capacity = capacity;
+    block->_used = 0;
+    if (dedicated && region->_blocks != NULL) {
+        block->_nextBlock = region->_blocks->_nextBlock;
+        region->_blocks->_nextBlock = block;
+    } else {
+        block->_nextBlock = region->_blocks;
+        region->_blocks = block;
+    }
+    return block;
+}
+
+/** @private */
+static void *regionAlloc(void *context, size_t size){
+    TRegion *region = context;
+    if (size > SIZE_MAX - _Alignof(max_align_t)) return NULL;
+    size = REGION_ALIGN(size);
+    struct RegionBlock *block = region->_blocks;
+    if (block == NULL || block->_capacity - block->_used < size) {
+        block = addBlock(region, size);
+        if (block == NULL) return NULL;
+    }
+    void *memory = block->_bytes + block->_used;
+    block->_used += size;
+    // Only the current block can give memory back or grow it in place.
+    region->_last = block == region->_blocks ? memory : NULL;
+    return memory;
+}
+
+/**
+ * @brief Grows or shrinks the latest allocation in place, and moves any other one.
+ * @private
+ */
+static void *regionRealloc(void *context, void *ptr, size_t oldSize, size_t size){
+    TRegion *region = context;
+    struct RegionBlock *block = region->_blocks;
+    if (ptr == region->_last && size <= SIZE_MAX - _Alignof(max_align_t)) {
+        size_t start = (size_t)((unsigned char *)ptr - block->_bytes);
+        if (block->_capacity - start >= REGION_ALIGN(size)) {
+            block->_used = start + REGION_ALIGN(size);
+            return ptr;
+        }
+    }
+    void *memory = regionAlloc(region, size);
+    if (memory != NULL) memcpy(memory, ptr, oldSize < size ? oldSize : size);
+    return memory;
+}
+
+/**
+ * @brief Gives back the latest allocation; other memory waits for the region to be reset.
+ * @private
+ */
+static void regionFree(void *context, void *ptr){
+    TRegion *region = context;
+    if (ptr != region->_last) return;
+    region->_blocks->_used = (size_t)((unsigned char *)ptr - region->_blocks->_bytes);
+    region->_last = NULL;
+}
+
+/** @copydoc newRegion */
+TRegion *newRegion(size_t blockSize){
+    TRegion *region = malloc(sizeof(TRegion));
+    if (region == NULL) {
+        fprintf(stderr, "Error in newRegion(): Failed to allocate memory for the region.\n");
+        exit(EXIT_FAILURE);
+    }
+    region->_allocator = (TAllocator){
+        .alloc = regionAlloc,
+        .realloc = regionRealloc,
+        .free = regionFree,
+        .context = region,
+    };
+    region->_blocks = NULL;
+    region->_blockSize = blockSize == 0 ? TLIST_REGION_BLOCK : blockSize;
+    region->_last = NULL;
+    return region;
+}
+
+/** @copydoc regionAllocator */
+const TAllocator *regionAllocator(TRegion *region){
+    if (region == NULL) {
+        fprintf(stderr, "Error in regionAllocator(): The provided region is NULL.\n");
+        return NULL;
+    }
+    return &region->_allocator;
+}
+
+/**
+ * @brief Frees the blocks of a region, except the last one in the chain if `keep` is set.
+ * @private
+ */
+static void releaseBlocks(TRegion *region, bool keep){
+    struct RegionBlock *block = region->_blocks;
+    while (block != NULL && (!keep || block->_nextBlock != NULL)){
+        struct RegionBlock *temp = block;
+        block = temp->_nextBlock;
+        free(temp);
+    }
+    if (block != NULL) block->_used = 0;
+    region->_blocks = block;
+    region->_last = NULL;
+}
+
+/** @copydoc resetRegion */
+void resetRegion(TRegion *region){
+    if (region == NULL) {
+        fprintf(stderr, "Error in resetRegion(): The provided region is NULL.\n");
+        return;
+    }
+    releaseBlocks(region, true);
+}
+
+/** @copydoc freeRegion */
+void freeRegion(TRegion *region){
+    if (region == NULL) return;
+    releaseBlocks(region, false);
+    free(region);
+}
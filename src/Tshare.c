@@ -0,0 +1,284 @@
+/**
+ * @file Tshare.c
+ * @brief Copy-on-write sharing behind `duplicate` and `snapshot`.
+ *
+ * Duplicating a list does not copy its elements. The first time a list is
+ * duplicated, its storage (nodes and `LIST_SLAB` pool, unrolled chunks or the
+ * vector array, and the `LIST_ARENA` strings) moves into a hidden owner list, and the list and each of its
+ * duplicates become views: they hold copies of the owner's `_head`, `_tail`,
+ * `_length` and backend state, and read the shared storage directly.
+ *
+ * The method table of a view is swapped for wrappers whose
+ * modifying methods call `unshare` first, which gives the list a private
+ * copy and restores the original table. A view that is the last one left
+ * takes the storage over instead of copying it. The owner is freed together
+ * with the last view.
+ *
+ * `mmapList` lists are views whose owner's array lies in a read-only file
+ * mapping; such storage is always copied, never taken over.
+ *
+ * For `LIST_SYNC` lists the wrappers replace the table kept by the lock
+ * layer (`syncInner`), so they are only swapped and called with the lock
+ * held.
+ */
+
+#include "Tlist.h"
+#include "TlistPrivate.h"
+
+/**
+ * @struct SharedStorage
+ * @brief Storage shared by several lists.
+ * @private
+ */
+struct SharedStorage{
+    atomic_int _refs;   /**< Number of lists viewing the storage. */
+    List _owner;        /**< Hidden list that owns the storage. */
+    void *_image;       /**< File mapping holding the storage of `mmapList` lists, `NULL` otherwise. */
+    size_t _imageSize;
+};
+
+/**
+ * @brief Frees shared storage once no list views it.
+ * @private
+ */
+static void releaseStorage(struct SharedStorage *storage){
+    if (storage->_image != NULL) releaseImage(storage->_owner, storage->_image, storage->_imageSize);
+    else storage->_owner->methods->free(storage->_owner);
+    List owner = storage->_owner;
+    listFree(owner, storage);
+    freeHiddenList(owner);
+}
+
+/**
+ * @struct Share
+ * @brief Copy-on-write state of one list viewing a `SharedStorage`.
+ * @private
+ */
+struct Share{
+    struct SharedStorage *_storage;
+    const struct ListMethods *_saved;   /**< Table replaced by the wrappers. */
+};
+
+/**
+ * @brief Makes `dst` describe the storage of `src`, without copying any element.
+ *
+ * Copies the list state, the string arena and the backend state that follows the `struct Lista`,
+ * and moves the byte counts of the instrumentation build.
+ * @private
+ */
+static void adoptStorage(List dst, List src){
+    dst->_head = src->_head;
+    dst->_tail = src->_tail;
+    dst->_length = src->_length;
+    if (src->_extra->_arena != NULL || dst->_extra->_arena != NULL) listExtra(dst)->_arena = src->_extra->_arena;
+    memcpy(dst + 1, src + 1, storeSize(src->_flags));
+    STAT_ADOPT(dst, src);
+    dst->_cursor = NULL;
+    dst->_cursorIndex = 0;
+}
+
+/**
+ * @brief Stops `this` from viewing shared storage.
+ *
+ * @param keep Whether the elements are needed: if not, the list is left
+ *        empty rather than given a copy.
+ * @return `true` if the list kept its storage (it was not shared, or was the
+ *         last view), `false` if it had to switch to new storage.
+ * @private
+ */
+static bool detach(List this, bool keep){
+    if (this->_extra->_share == NULL) return true;
+    if (!listLock(this, true)) return false;
+    struct Share *share = this->_extra->_share;
+    struct SharedStorage *storage = share->_storage;
+    // The last view already describes the storage, so it takes it over,
+    // unless the storage is a read-only file mapping.
+    bool kept = atomic_load(&storage->_refs) == 1 && storage->_image == NULL;
+    if (kept) {
+        STAT_ADOPT(this, storage->_owner);
+        freeHiddenList(storage->_owner);
+        listFree(this, storage);
+    } else {
+        List copy = deriveList(this, this->_type, this->_flags & ~LIST_SYNC);
+        if (keep) {
+            TLIST_FOREACH(this, val) {
+                copy->methods->pushValue(copy, val);
+            }
+        }
+        adoptStorage(this, copy);
+        releaseExtra(copy);
+        free(copy);
+        if (this->_extra->_index != NULL) rebuildIndex(this);
+        if (atomic_fetch_sub(&storage->_refs, 1) == 1) releaseStorage(storage);
+    }
+    if (this->_extra->_sync != NULL) {
+        *syncInner(this) = share->_saved;
+    } else {
+        setMethods(this, share->_saved);
+    }
+    this->_extra->_share = NULL;
+    listFree(this, share);
+    listUnlock(this);
+    return kept;
+}
+
+/** @copydoc unshare */
+bool unshare(List this){
+    return detach(this, true);
+}
+
+/* Wrappers ---------------------------------------------------------------- */
+
+/** @private */
+static void cowPushValue(List this, void *val){
+    unshare(this);
+    this->methods->pushValue(this, val);
+}
+
+/** @private */
+static void cowInsertValue(List this, int index, void *val){
+    unshare(this);
+    this->methods->insertValue(this, index, val);
+}
+
+/** @private */
+static void cowSetValue(List this, int index, void *val){
+    unshare(this);
+    this->methods->setValue(this, index, val);
+}
+
+/** @private */
+static bool cowPopValue(List this, void *out){
+    unshare(this);
+    return this->methods->popValue(this, out);
+}
+
+/** @private */
+static void cowInsertArray(List this, int index, const void *values, size_t n){
+    unshare(this);
+    this->methods->insertArray(this, index, values, n);
+}
+
+/** @private */
+static void *cowPop(List this){
+    unshare(this);
+    return this->methods->pop(this);
+}
+
+/** @private */
+static void cowRemove(List this, int index){
+    unshare(this);
+    this->methods->remove(this, index);
+}
+
+/** @private */
+static void *cowPick(List this, int index){
+    unshare(this);
+    return this->methods->pick(this, index);
+}
+
+/** @private */
+static void cowFree(List this){
+    detach(this, false);
+    this->methods->free(this);
+}
+
+/** @private */
+static void cowPrint(List this){
+    this->_extra->_share->_saved->print(this);
+}
+
+/** @private */
+static int cowLen(List this){
+    return this->_extra->_share->_saved->len(this);
+}
+
+/** @private */
+static void *cowGet(List this, int index){
+    return this->_extra->_share->_saved->get(this, index);
+}
+
+/** @private */
+static void cowForeach(List this, void(*function)(void*)){
+    this->_extra->_share->_saved->foreach(this, function);
+}
+
+/**
+ * @brief Methods of a view, one table per `Type`; reading methods forward to the saved table.
+ * @private
+ */
+static const struct ListMethods cowMethods[TLIST_TYPES] = LIST_METHODS(
+    .pop = cowPop,
+    .print = cowPrint,
+    .len = cowLen,
+    .free = cowFree,
+    .get = cowGet,
+    .remove = cowRemove,
+    .pick = cowPick,
+    .foreach = cowForeach,
+    .pushValue = cowPushValue,
+    .insertValue = cowInsertValue,
+    .setValue = cowSetValue,
+    .popValue = cowPopValue,
+    .insertArray = cowInsertArray,
+);
+
+/**
+ * @brief Turns `this` into a view of `storage` by swapping in the wrappers.
+ * @private
+ */
+static void installShare(List this, struct SharedStorage *storage){
+    struct Share *share = listAlloc(this, sizeof(struct Share));
+    if (share == NULL) {
+        fprintf(stderr, "Error in duplicate(): Failed to allocate memory for the sharing state.\n");
+        exit(EXIT_FAILURE);
+    }
+    share->_storage = storage;
+    atomic_fetch_add(&storage->_refs, 1);
+    const struct ListMethods **inner = this->_extra->_sync != NULL ? syncInner(this) : NULL;
+    share->_saved = inner != NULL ? *inner : this->methods;
+    if (inner != NULL) {
+        *inner = &cowMethods[this->_type];
+    } else {
+        setMethods(this, &cowMethods[this->_type]);
+    }
+    listExtra(this)->_share = share;
+}
+
+/** @copydoc shareList */
+List shareList(List this, int flags){
+    if (this->_extra->_share == NULL) {
+        struct SharedStorage *storage = listAlloc(this, sizeof(struct SharedStorage));
+        if (storage == NULL) {
+            fprintf(stderr, "Error in duplicate(): Failed to allocate memory for the sharing state.\n");
+            exit(EXIT_FAILURE);
+        }
+        atomic_init(&storage->_refs, 0);
+        storage->_image = NULL;
+        storage->_imageSize = 0;
+        storage->_owner = hiddenList(this, this->_flags & ~LIST_SYNC);
+        adoptStorage(storage->_owner, this);
+        installShare(this, storage);
+    }
+    List view = deriveList(this, this->_type, flags);
+    adoptStorage(view, this);
+    installShare(view, this->_extra->_share->_storage);
+    return view;
+}
+
+/** @copydoc shareImage */
+List shareImage(List owner, void *image, size_t imageSize){
+    struct SharedStorage *storage = listAlloc(owner, sizeof(struct SharedStorage));
+    if (storage == NULL) {
+        fprintf(stderr, "Error in mmapList(): Failed to allocate memory for the sharing state.\n");
+        exit(EXIT_FAILURE);
+    }
+    atomic_init(&storage->_refs, 0);
+    storage->_owner = owner;
+    storage->_image = image;
+    storage->_imageSize = imageSize;
+    List view = deriveList(owner, owner->_type, owner->_flags);
+    adoptStorage(view, owner);
+    installShare(view, storage);
+    return view;
+}
@@ -0,0 +1,355 @@
+/**
+ * @file Tsort.c
+ * @brief Stable sorting for every storage backend.
+ *
+ * Linked lists are sorted by relinking their nodes with a bottom-up merge
+ * sort, so no value is copied or allocated. `LIST_VECTOR` and `LIST_UNROLLED` lists
+ * merge-sort their slots through a scratch array of the same size.
+ *
+ * Large `INT` and `FLOAT` lists sorted in their natural order skip the
+ * comparisons altogether: their keys are gathered into an array, ordered with
+ * an LSD radix sort (one pass per significant byte) and written back in place.
+ */
+
+#include "Tlist.h"
+#include "TlistPrivate.h"
+#include <stdint.h>
+
+/** @copydoc compareInt */
+int compareInt(const void *a, const void *b){
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/** @copydoc compareFloat */
+int compareFloat(const void *a, const void *b){
+    float x = *(const float *)a;
+    float y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+/** @copydoc compareDouble */
+int compareDouble(const void *a, const void *b){
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/** @copydoc compareString */
+int compareString(const void *a, const void *b){
+    return strcmp((const char *)a, (const char *)b);
+}
+
+/**
+ * @brief Returns the natural comparator of a list type, or `NULL` for `T`.
+ * @private
+ */
+static Comparator defaultComparator(Type type){
+    switch (type){
+        case INT: return compareInt;
+        case FLOAT: return compareFloat;
+        case DOUBLE: return compareDouble;
+        case STRING: return compareString;
+        default: return NULL;
+    }
+}
+
+/* Radix sort -------------------------------------------------------------- */
+
+/**
+ * @brief Maps an `INT` or `FLOAT` value to an unsigned key with the same order.
+ *
+ * Negative floats have all bits flipped and the others only the sign bit, so
+ * -0.0 sorts just before 0.0 and NaNs sort after +infinity (or before
+ * -infinity, for negative NaNs).
+ * @private
+ */
+static inline uint32_t radixKey(Type type, const void *val){
+    uint32_t bits;
+    memcpy(&bits, val, sizeof(bits));
+    if (type == FLOAT && (bits & 0x80000000u)) return ~bits;
+    return bits ^ 0x80000000u;
+}
+
+/** @brief Inverse of `radixKey`. @private */
+static inline void radixValue(Type type, uint32_t key, void *val){
+    uint32_t bits = (type == FLOAT && !(key & 0x80000000u)) ? ~key : key ^ 0x80000000u;
+    memcpy(val, &bits, sizeof(bits));
+}
+
+/**
+ * @brief Sorts `n` keys with one counting pass per byte, skipping bytes all keys share.
+ *
+ * `scratch` must hold `n` keys. Returns the buffer holding the sorted keys.
+ * @private
+ */
+static uint32_t *radixSort(uint32_t *keys, uint32_t *scratch, size_t n){
+    size_t counts[4][256] = {{0}};
+    for (size_t i = 0; i < n; i++){
+        uint32_t key = keys[i];
+        counts[0][key & 0xff]++;
+        counts[1][(key >> 8) & 0xff]++;
+        counts[2][(key >> 16) & 0xff]++;
+        counts[3][key >> 24]++;
+    }
+    for (int pass = 0; pass < 4; pass++){
+        unsigned shift = 8u * (unsigned)pass;
+        if (counts[pass][(keys[0] >> shift) & 0xff] == n) continue;
+        size_t offset = 0;
+        for (int digit = 0; digit < 256; digit++){
+            size_t count = counts[pass][digit];
+            counts[pass][digit] = offset;
+            offset += count;
+        }
+        for (size_t i = 0; i < n; i++){
+            scratch[counts[pass][(keys[i] >> shift) & 0xff]++] = keys[i];
+        }
+        uint32_t *swap = keys;
+        keys = scratch;
+        scratch = swap;
+    }
+    return keys;
+}
+
+/**
+ * @brief Sorts an `INT` or `FLOAT` list in ascending order by radix.
+ * @return `false` if the scratch buffers could not be allocated.
+ * @private
+ */
+static bool radixSortList(List this){
+    size_t n = (size_t)this->_length;
+    uint32_t *keys = listAlloc(this, 2 * n * sizeof(uint32_t));
+    if (keys == NULL) return false;
+    Type type = this->_type;
+
+    size_t i = 0;
+    if (this->_flags & LIST_VECTOR) {
+        struct VectorStore *store = listStore(this);
+        unsigned char *data = store->_data + (size_t)store->_start * this->_size;
+        for (; i < n; i++) keys[i] = radixKey(type, data + i * this->_size);
+    } else if (this->_flags & LIST_UNROLLED) {
+        for (struct Chunk *chunk = ((struct UnrolledStore *)listStore(this))->_first; chunk != NULL; chunk = chunk->_nextChunk){
+            for (int j = 0; j < chunk->_count; j++) keys[i++] = radixKey(type, chunk->_slots + (size_t)j * this->_size);
+        }
+    } else {
+        for (Node current = this->_head; current != NULL; current = current->_nextNode){
+            keys[i++] = radixKey(type, current->_val);
+        }
+    }
+
+    uint32_t *sorted = radixSort(keys, keys + n, n);
+
+    i = 0;
+    if (this->_flags & LIST_VECTOR) {
+        struct VectorStore *store = listStore(this);
+        unsigned char *data = store->_data + (size_t)store->_start * this->_size;
+        for (; i < n; i++) radixValue(type, sorted[i], data + i * this->_size);
+    } else if (this->_flags & LIST_UNROLLED) {
+        for (struct Chunk *chunk = ((struct UnrolledStore *)listStore(this))->_first; chunk != NULL; chunk = chunk->_nextChunk){
+            for (int j = 0; j < chunk->_count; j++) radixValue(type, sorted[i++], chunk->_slots + (size_t)j * this->_size);
+        }
+    } else {
+        for (Node current = this->_head; current != NULL; current = current->_nextNode){
+            radixValue(type, sorted[i++], current->_val);
+        }
+    }
+    listFree(this, keys);
+    return true;
+}
+
+/* Linked lists ------------------------------------------------------------ */
+
+/**
+ * @brief Merges two sorted, `NULL`-terminated chains; ties favour `a`.
+ * @param tail On entry the last node of `b`, on return the last node of the merged chain.
+ * @private
+ */
+static Node mergeNodes(Node a, Node aTail, Node b, Comparator cmp, Node *tail){
+    Node head = NULL;
+    Node *link = &head;
+    Node last = NULL;
+    while (a != NULL && b != NULL){
+        if (cmp(b->_val, a->_val) < 0) {
+            last = *link = b;
+            b = b->_nextNode;
+        } else {
+            last = *link = a;
+            a = a->_nextNode;
+        }
+        link = &last->_nextNode;
+    }
+    *link = a != NULL ? a : b;
+    if (a != NULL) *tail = aTail;
+    return head;
+}
+
+/**
+ * @brief Bottom-up merge sort of a linked list.
+ *
+ * Bin `i` holds a sorted run of `2^i` nodes. Each node is merged into the
+ * bins like a carry propagating through a binary counter, so the list is
+ * read exactly once and no recursion or index arithmetic is needed. Older
+ * runs are always the left operand of a merge, which keeps the sort stable.
+ * @private
+ */
+static void sortNodes(List this, Comparator cmp){
+    Node bins[sizeof(size_t) * CHAR_BIT] = {NULL};
+    Node tails[sizeof(size_t) * CHAR_BIT] = {NULL};
+    int used = 0;
+
+    Node current = this->_head;
+    while (current != NULL){
+        Node carry = current;
+        Node carryTail = current;
+        current = current->_nextNode;
+        carry->_nextNode = NULL;
+        int i = 0;
+        for (; i < used && bins[i] != NULL; i++){
+            carry = mergeNodes(bins[i], tails[i], carry, cmp, &carryTail);
+            bins[i] = NULL;
+        }
+        bins[i] = carry;
+        tails[i] = carryTail;
+        if (i == used) used++;
+    }
+
+    Node head = NULL;
+    Node tail = NULL;
+    for (int i = 0; i < used; i++){
+        if (bins[i] == NULL) continue;
+        if (head == NULL) {
+            head = bins[i];
+            tail = tails[i];
+        } else {
+            head = mergeNodes(bins[i], tails[i], head, cmp, &tail);
+        }
+    }
+    this->_head = head;
+    this->_tail = tail;
+    this->_cursor = NULL;
+    this->_cursorIndex = 0;
+    if (this->_flags & LIST_DOUBLY) {
+        Node prev = NULL;
+        for (Node node = head; node != NULL; node = node->_nextNode){
+            PREV_NODE(node) = prev;
+            prev = node;
+        }
+    }
+}
+
+/* Array-based backends ---------------------------------------------------- */
+
+/** Runs shorter than this are sorted by insertion before merging. */
+#define TLIST_SORT_RUN 16
+
+/**
+ * @brief Stable merge sort of `n` slots of `size` bytes through `scratch`.
+ *
+ * Runs of `TLIST_SORT_RUN` slots are first sorted by insertion, then merged
+ * pairwise, alternating between `slots` and `scratch`.
+ * @return The buffer holding the sorted slots.
+ * @private
+ */
+static unsigned char *sortSlots(List this, unsigned char *slots, unsigned char *scratch, size_t n, Comparator cmp){
+    size_t size = this->_size;
+    _Alignas(double) unsigned char held[sizeof(double)];
+    for (size_t start = 0; start < n; start += TLIST_SORT_RUN){
+        size_t end = start + TLIST_SORT_RUN < n ? start + TLIST_SORT_RUN : n;
+        for (size_t i = start + 1; i < end; i++){
+            memcpy(held, slots + i * size, size);
+            size_t j = i;
+            while (j > start && cmp(slotValue(this, held), slotValue(this, slots + (j - 1) * size)) < 0) j--;
+            if (j == i) continue;
+            memmove(slots + (j + 1) * size, slots + j * size, (i - j) * size);
+            memcpy(slots + j * size, held, size);
+        }
+    }
+    for (size_t width = TLIST_SORT_RUN; width < n; width *= 2){
+        for (size_t left = 0; left < n; left += 2 * width){
+            size_t mid = left + width < n ? left + width : n;
+            size_t right = mid + width < n ? mid + width : n;
+            size_t a = left, b = mid, out = left;
+            while (a < mid && b < right){
+                if (cmp(slotValue(this, slots + b * size), slotValue(this, slots + a * size)) < 0) {
+                    memcpy(scratch + out++ * size, slots + b++ * size, size);
+                } else {
+                    memcpy(scratch + out++ * size, slots + a++ * size, size);
+                }
+            }
+            memcpy(scratch + out * size, slots + a * size, (mid - a) * size);
+            out += mid - a;
+            memcpy(scratch + out * size, slots + b * size, (right - b) * size);
+        }
+        unsigned char *swap = slots;
+        slots = scratch;
+        scratch = swap;
+    }
+    return slots;
+}
+
+/**
+ * @brief Sorts the slots of a `LIST_VECTOR` or `LIST_UNROLLED` list.
+ *
+ * Vector slots are sorted in place; unrolled chunks are copied into one array,
+ * sorted and copied back, so each chunk keeps its element count.
+ * @private
+ */
+static void sortArrayBackend(List this, Comparator cmp){
+    size_t n = (size_t)this->_length;
+    size_t bytes = n * this->_size;
+    bool vector = (this->_flags & LIST_VECTOR) != 0;
+    unsigned char *buffer = listAlloc(this, vector ? bytes : 2 * bytes);
+    if (buffer == NULL) {
+        fprintf(stderr, "Error in listSort(): Failed to allocate memory for the sort buffer.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (vector) {
+        struct VectorStore *store = listStore(this);
+        unsigned char *data = store->_data + (size_t)store->_start * this->_size;
+        unsigned char *sorted = sortSlots(this, data, buffer, n, cmp);
+        if (sorted != data) memcpy(data, sorted, bytes);
+    } else {
+        struct UnrolledStore *store = listStore(this);
+        size_t offset = 0;
+        for (struct Chunk *chunk = store->_first; chunk != NULL; chunk = chunk->_nextChunk){
+            memcpy(buffer + offset, chunk->_slots, (size_t)chunk->_count * this->_size);
+            offset += (size_t)chunk->_count * this->_size;
+        }
+        unsigned char *sorted = sortSlots(this, buffer, buffer + bytes, n, cmp);
+        offset = 0;
+        for (struct Chunk *chunk = store->_first; chunk != NULL; chunk = chunk->_nextChunk){
+            memcpy(chunk->_slots, sorted + offset, (size_t)chunk->_count * this->_size);
+            offset += (size_t)chunk->_count * this->_size;
+        }
+    }
+    listFree(this, buffer);
+}
+
+/** @copydoc listSort */
+void listSort(List this, Comparator cmp){
+    if (this == NULL) {
+        fprintf(stderr, "Error in listSort(): The provided list instance is NULL.\n");
+        return;
+    }
+    Comparator natural = defaultComparator(this->_type);
+    if (cmp == NULL) cmp = natural;
+    if (cmp == NULL) {
+        fprintf(stderr, "Error in listSort(): Lists of type T need an explicit comparator.\n");
+        return;
+    }
+    if (!listLock(this, true)) return;
+    unshare(this);
+    if (this->_length < 2) {
+        // Nothing to sort.
+    } else if ((this->_type == INT || this->_type == FLOAT) && cmp == natural
+        && this->_length >= TLIST_RADIX_MIN && radixSortList(this)) {
+        // Sorted by radix, which rewrites the values of linked nodes in place.
+        if (this->_extra->_index != NULL) rebuildIndex(this);
+    } else if (this->_flags & (LIST_VECTOR | LIST_UNROLLED)) {
+        sortArrayBackend(this, cmp);
+    } else {
+        sortNodes(this, cmp);
+    }
+    listUnlock(this);
+}
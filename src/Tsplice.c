@@ -0,0 +1,175 @@
+/**
+ * @file Tsplice.c
+ * @brief Moving ranges of elements between lists: `listConcat`, `splitAt` and `spliceRange`.
+ *
+ * When both lists use the same storage the elements move without being
+ * copied: linked nodes are relinked, unrolled chunks are relinked after
+ * splitting at most three of them, and vector slots are moved in one block.
+ * `LIST_SLAB` nodes belong to the slab of the list that allocated them and
+ * `LIST_DOUBLY` nodes carry an extra link. `LIST_ARENA` strings likewise
+ * belong to the arena of their list. Lists with a slab, an arena or a hash
+ * index, and pairs with different storage flags or different allocators,
+ * fall back to copying the range and removing it from the source.
+ */
+
+#include "Tlist.h"
+#include "TlistPrivate.h"
+
+/** Storage flags two lists must share for their elements to move without copying. @private */
+#define SPLICE_STORAGE (LIST_SLAB | LIST_DOUBLY | LIST_UNROLLED | LIST_VECTOR | LIST_QUEUE | LIST_ARENA)
+
+/**
+ * @brief Moves nodes `[from, to)` of the linked list `src` before index `pos` of `dst`.
+ * @private
+ */
+static void linkedSplice(List dst, int pos, List src, int from, int to){
+    int n = to - from;
+    Node before = from == 0 ? NULL : seekNode(src, from - 1);
+    Node first = before == NULL ? src->_head : before->_nextNode;
+    Node last = to == src->_length ? src->_tail : seekNode(src, to - 1);
+    if (before == NULL) src->_head = last->_nextNode;
+    else before->_nextNode = last->_nextNode;
+    if (src->_tail == last) src->_tail = before;
+    LINK_PREV(src, last->_nextNode, before);
+    src->_length -= n;
+    src->_cursor = NULL;
+
+    Node at = pos == 0 ? NULL : seekNode(dst, pos - 1);
+    last->_nextNode = at == NULL ? dst->_head : at->_nextNode;
+    if (at == NULL) dst->_head = first;
+    else at->_nextNode = first;
+    if (last->_nextNode == NULL) dst->_tail = last;
+    LINK_PREV(dst, first, at);
+    LINK_PREV(dst, last->_nextNode, last);
+    dst->_length += n;
+    if (dst->_cursor != NULL && dst->_cursorIndex >= pos) {
+        dst->_cursorIndex += n;
+    }
+}
+
+/**
+ * @brief Copies `[from, to)` of `src` into `dst` at `pos`, then removes it from `src`.
+ * @private
+ */
+static void copySplice(List dst, int pos, List src, int from, int to){
+    int n = to - from;
+    unsigned char *values = listAlloc(src, (size_t)n * src->_size);
+    if (values == NULL) {
+        fprintf(stderr, "Error in spliceRange(): Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    struct TIterator iterator = iteratorOf(src);
+    void *val;
+    for (int i = 0; i < from; i++) iteratorStep(&iterator, &val);
+    for (int i = 0; i < n && iteratorStep(&iterator, &val); i++){
+        // Array layout: the value for numerics, the pointer for `STRING` and `T`.
+        if (src->_type == STRING || src->_type == T) memcpy(values + (size_t)i * src->_size, &val, src->_size);
+        else memcpy(values + (size_t)i * src->_size, val, src->_size);
+    }
+    dst->methods->insertArray(dst, pos, values, (size_t)n);
+    listFree(src, values);
+    for (int i = 0; i < n; i++) src->methods->remove(src, from);
+}
+
+/**
+ * @brief Write-locks two distinct lists, in address order so that two threads
+ *        splicing in opposite directions cannot deadlock.
+ * @private
+ */
+static bool lockPair(List a, List b){
+    List lower = a < b ? a : b;
+    List upper = a < b ? b : a;
+    if (!listLock(lower, true)) return false;
+    if (!listLock(upper, true)) {
+        listUnlock(lower);
+        return false;
+    }
+    return true;
+}
+
+/** @private */
+static void unlockPair(List a, List b){
+    listUnlock(a);
+    listUnlock(b);
+}
+
+/** @copydoc spliceRange */
+void spliceRange(List dst, int pos, List src, int from, int to){
+    if (dst == NULL || src == NULL) {
+        fprintf(stderr, "Error in spliceRange(): The provided list instance is NULL.\n");
+        return;
+    }
+    if (dst == src) {
+        fprintf(stderr, "Error in spliceRange(): Cannot splice a list into itself.\n");
+        return;
+    }
+    if (dst->_type != src->_type) {
+        fprintf(stderr, "Error in spliceRange(): Lists of different types cannot be spliced.\n");
+        return;
+    }
+    if ((dst->_flags | src->_flags) & LIST_QUEUE) {
+        fprintf(stderr, "Error in spliceRange(): Not supported by LIST_QUEUE lists.\n");
+        return;
+    }
+    if (!lockPair(dst, src)) return;
+    unshare(dst);
+    unshare(src);
+    if (from < 0 || to < from || to > src->_length) {
+        fprintf(stderr, "Error in spliceRange(): Range [%d, %d) is out of bounds for list of size %d.\n", from, to, src->_length);
+    } else if (pos < 0 || pos > dst->_length) {
+        fprintf(stderr, "Error in spliceRange(): Index %d is out of bounds. Valid range is 0 to %d.\n", pos, dst->_length);
+    } else if (to - from > INT_MAX - dst->_length) {
+        fprintf(stderr, "Error in spliceRange(): Adding %d elements would overflow the list length.\n", to - from);
+    } else if (from < to) {
+        int storage = dst->_flags & SPLICE_STORAGE;
+        if (storage != (src->_flags & SPLICE_STORAGE) || storage & (LIST_SLAB | LIST_ARENA)
+            || dst->_extra->_index != NULL || src->_extra->_index != NULL
+            || dst->_extra->_allocator != src->_extra->_allocator) copySplice(dst, pos, src, from, to);
+        else if (storage & LIST_UNROLLED) unrolledSplice(dst, pos, src, from, to);
+        else if (storage & LIST_VECTOR) vectorSplice(dst, pos, src, from, to);
+        else linkedSplice(dst, pos, src, from, to);
+    }
+    unlockPair(dst, src);
+}
+
+/** @copydoc listConcat */
+void listConcat(List dst, List src){
+    if (dst == NULL || src == NULL) {
+        fprintf(stderr, "Error in listConcat(): The provided list instance is NULL.\n");
+        return;
+    }
+    if (dst == src) {
+        fprintf(stderr, "Error in listConcat(): Cannot concatenate a list to itself.\n");
+        return;
+    }
+    if ((dst->_flags | src->_flags) & LIST_QUEUE) {
+        fprintf(stderr, "Error in listConcat(): Not supported by LIST_QUEUE lists.\n");
+        return;
+    }
+    // Hold both locks so the lengths cannot change before the nested call relocks.
+    if (!lockPair(dst, src)) return;
+    spliceRange(dst, dst->_length, src, 0, src->_length);
+    unlockPair(dst, src);
+}
+
+/** @copydoc splitAt */
+List splitAt(List list, int index){
+    if (list == NULL) {
+        fprintf(stderr, "Error in splitAt(): The provided list instance is NULL.\n");
+        return NULL;
+    }
+    if (list->_flags & LIST_QUEUE) {
+        fprintf(stderr, "Error in splitAt(): Not supported by LIST_QUEUE lists.\n");
+        return NULL;
+    }
+    if (!listLock(list, true)) return NULL;
+    if (index < 0 || index > list->_length) {
+        fprintf(stderr, "Error in splitAt(): Index %d is out of bounds. Valid range is 0 to %d.\n", index, list->_length);
+        listUnlock(list);
+        return NULL;
+    }
+    List tail = deriveList(list, list->_type, list->_flags);
+    spliceRange(tail, 0, list, index, list->_length);
+    listUnlock(list);
+    return tail;
+}
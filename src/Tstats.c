@@ -0,0 +1,410 @@
+/**
+ * @file Tstats.c
+ * @brief Operation counters and latency histograms of the instrumentation build.
+ *
+ * With `TLIST_STATS` defined, `initStats` wraps the method table of every
+ * new list, on top of the `LIST_SYNC` layer if any. Each wrapper counts the call and, while `statsTiming` is on, the time
+ * it took, then forwards to the wrapped method. The storage code reports
+ * traversals and allocations through the `STAT_*` macros of `TlistPrivate.h`.
+ *
+ * Every counter is recorded twice: in the list, and in process-wide totals
+ * that outlive it. Counters are relaxed atomics, since the readers of a
+ * `LIST_SYNC` list and the threads of a `LIST_QUEUE` list update them
+ * concurrently.
+ *
+ * Without `TLIST_STATS` the macros expand to nothing, lists are not wrapped,
+ * and only the public functions remain, reporting that no counters exist.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "Tlist.h"
+#include "TlistPrivate.h"
+
+#ifdef TLIST_STATS
+
+#include <time.h>
+
+/**
+ * @struct Counters
+ * @brief The counters behind `ListStats`.
+ * @private
+ */
+typedef struct Counters{
+    atomic_size_t _calls[LIST_OP_COUNT];
+    atomic_size_t _latency[LIST_OP_COUNT][TLIST_LATENCY_BUCKETS];
+    atomic_size_t _traversed;
+    atomic_size_t _cursorHits;
+    atomic_size_t _cursorMisses;
+    atomic_size_t _mallocs;
+    atomic_size_t _frees;
+    atomic_llong _nodeBytes;
+    atomic_llong _valueBytes;
+} Counters;
+
+/**
+ * @struct StatsStore
+ * @brief The counters of one list and the methods its wrappers forward to.
+ * @private
+ */
+struct StatsStore{
+    const struct ListMethods *_inner;
+    Counters _counters;
+};
+
+/** @private */
+#define STORE(list) ((list)->_extra->_stats)
+
+/** Totals over every list. @private */
+static Counters globalCounters;
+
+/** Whether the wrappers time the calls. @private */
+static atomic_bool timing;
+
+/** @private */
+static void add(atomic_size_t *counter, size_t n){
+    atomic_fetch_add_explicit(counter, n, memory_order_relaxed);
+}
+
+/** @private */
+static void addBytes(atomic_llong *counter, long long n){
+    atomic_fetch_add_explicit(counter, n, memory_order_relaxed);
+}
+
+/** @private */
+static uint64_t now(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Counts a call to `op` on `this`.
+ * @private
+ * @return The start time of the call, or 0 when timing is off.
+ */
+static uint64_t beginOp(List this, ListOp op){
+    add(&STORE(this)->_counters._calls[op], 1);
+    add(&globalCounters._calls[op], 1);
+    return atomic_load_explicit(&timing, memory_order_relaxed) ? now() : 0;
+}
+
+/**
+ * @brief Records the latency of a call started by `beginOp`.
+ * @private
+ */
+static void endOp(List this, ListOp op, uint64_t start){
+    if (start == 0) return;
+    uint64_t elapsed = now() - start;
+    int bucket = 0;
+    while (elapsed > 1 && bucket < TLIST_LATENCY_BUCKETS - 1){
+        elapsed >>= 1;
+        bucket++;
+    }
+    add(&STORE(this)->_counters._latency[op][bucket], 1);
+    add(&globalCounters._latency[op][bucket], 1);
+}
+
+/* Backend primitives ------------------------------------------------------ */
+
+/** @private */
+static void statsPushValue(List this, void *val){
+    uint64_t start = beginOp(this, LIST_OP_PUSH);
+    STORE(this)->_inner->pushValue(this, val);
+    endOp(this, LIST_OP_PUSH, start);
+}
+
+/** @private */
+static void statsInsertValue(List this, int index, void *val){
+    uint64_t start = beginOp(this, LIST_OP_INSERT);
+    STORE(this)->_inner->insertValue(this, index, val);
+    endOp(this, LIST_OP_INSERT, start);
+}
+
+/** @private */
+static void statsSetValue(List this, int index, void *val){
+    uint64_t start = beginOp(this, LIST_OP_SET);
+    STORE(this)->_inner->setValue(this, index, val);
+    endOp(this, LIST_OP_SET, start);
+}
+
+/** @private */
+static bool statsPopValue(List this, void *out){
+    uint64_t start = beginOp(this, LIST_OP_POP);
+    bool popped = STORE(this)->_inner->popValue(this, out);
+    endOp(this, LIST_OP_POP, start);
+    return popped;
+}
+
+/** @private */
+static void statsInsertArray(List this, int index, const void *values, size_t n){
+    uint64_t start = beginOp(this, LIST_OP_ARRAY);
+    STORE(this)->_inner->insertArray(this, index, values, n);
+    endOp(this, LIST_OP_ARRAY, start);
+}
+
+/* Methods ----------------------------------------------------------------- */
+
+/** @private */
+static void *statsPop(List this){
+    uint64_t start = beginOp(this, LIST_OP_POP);
+    void *val = STORE(this)->_inner->pop(this);
+    endOp(this, LIST_OP_POP, start);
+    return val;
+}
+
+/** @private */
+static void statsPrint(List this){
+    uint64_t start = beginOp(this, LIST_OP_PRINT);
+    STORE(this)->_inner->print(this);
+    endOp(this, LIST_OP_PRINT, start);
+}
+
+/** @private */
+static int statsLen(List this){
+    uint64_t start = beginOp(this, LIST_OP_LEN);
+    int length = STORE(this)->_inner->len(this);
+    endOp(this, LIST_OP_LEN, start);
+    return length;
+}
+
+/** @private */
+static void statsFree(List this){
+    uint64_t start = beginOp(this, LIST_OP_FREE);
+    STORE(this)->_inner->free(this);
+    endOp(this, LIST_OP_FREE, start);
+}
+
+/** @private */
+static void *statsGet(List this, int index){
+    uint64_t start = beginOp(this, LIST_OP_GET);
+    void *val = STORE(this)->_inner->get(this, index);
+    endOp(this, LIST_OP_GET, start);
+    return val;
+}
+
+/** @private */
+static void statsDelete(List this, int index){
+    uint64_t start = beginOp(this, LIST_OP_REMOVE);
+    STORE(this)->_inner->remove(this, index);
+    endOp(this, LIST_OP_REMOVE, start);
+}
+
+/** @private */
+static void *statsPick(List this, int index){
+    uint64_t start = beginOp(this, LIST_OP_PICK);
+    void *val = STORE(this)->_inner->pick(this, index);
+    endOp(this, LIST_OP_PICK, start);
+    return val;
+}
+
+/** @private */
+static void statsForeach(List this, void(*function)(void*)){
+    uint64_t start = beginOp(this, LIST_OP_FOREACH);
+    STORE(this)->_inner->foreach(this, function);
+    endOp(this, LIST_OP_FOREACH, start);
+}
+
+/**
+ * @brief Methods of every list of an instrumentation build, one table per `Type`.
+ * @private
+ */
+static const struct ListMethods statsMethods[TLIST_TYPES] = LIST_METHODS(
+    .pop = statsPop,
+    .print = statsPrint,
+    .len = statsLen,
+    .free = statsFree,
+    .get = statsGet,
+    .remove = statsDelete,
+    .pick = statsPick,
+    .foreach = statsForeach,
+    .pushValue = statsPushValue,
+    .insertValue = statsInsertValue,
+    .setValue = statsSetValue,
+    .popValue = statsPopValue,
+    .insertArray = statsInsertArray,
+);
+
+/** @copydoc statsStoreSize */
+size_t statsStoreSize(void){
+    return sizeof(struct StatsStore);
+}
+
+/** @copydoc initStats */
+void initStats(List this, void *memory){
+    struct StatsStore *store = memory;
+    memset(&store->_counters, 0, sizeof(Counters));
+    store->_inner = this->methods;
+    listExtra(this)->_stats = store;
+    setMethods(this, &statsMethods[this->_type]);
+}
+
+/** @copydoc statTraversed */
+void statTraversed(List this, size_t nodes){
+    if (STORE(this) == NULL || nodes == 0) return;
+    add(&STORE(this)->_counters._traversed, nodes);
+    add(&globalCounters._traversed, nodes);
+}
+
+/** @copydoc statCursor */
+void statCursor(List this, bool hit){
+    if (STORE(this) == NULL) return;
+    add(hit ? &STORE(this)->_counters._cursorHits : &STORE(this)->_counters._cursorMisses, 1);
+}
+
+/** @copydoc statMemory */
+void statMemory(List this, long long nodeBytes, long long valueBytes, int mallocs, int frees){
+    Counters *counters[2] = { STORE(this) == NULL ? NULL : &STORE(this)->_counters, &globalCounters };
+    for (int i = 0; i < 2; i++){
+        if (counters[i] == NULL) continue;
+        if (nodeBytes != 0) addBytes(&counters[i]->_nodeBytes, nodeBytes);
+        if (valueBytes != 0) addBytes(&counters[i]->_valueBytes, valueBytes);
+        if (mallocs != 0) add(&counters[i]->_mallocs, (size_t)mallocs);
+        if (frees != 0) add(&counters[i]->_frees, (size_t)frees);
+    }
+}
+
+/** @copydoc adoptStats */
+void adoptStats(List dst, List src){
+    if (STORE(dst) == NULL || STORE(src) == NULL) return;
+    Counters *from = &STORE(src)->_counters;
+    Counters *to = &STORE(dst)->_counters;
+    addBytes(&to->_nodeBytes, atomic_exchange_explicit(&from->_nodeBytes, 0, memory_order_relaxed));
+    addBytes(&to->_valueBytes, atomic_exchange_explicit(&from->_valueBytes, 0, memory_order_relaxed));
+}
+
+/**
+ * @brief Copies counters into the public structure.
+ * @private
+ */
+static void readCounters(Counters *counters, ListStats *out){
+    for (int op = 0; op < LIST_OP_COUNT; op++){
+        out->calls[op] = atomic_load_explicit(&counters->_calls[op], memory_order_relaxed);
+        for (int b = 0; b < TLIST_LATENCY_BUCKETS; b++){
+            out->latency[op][b] = atomic_load_explicit(&counters->_latency[op][b], memory_order_relaxed);
+        }
+    }
+    out->nodesTraversed = atomic_load_explicit(&counters->_traversed, memory_order_relaxed);
+    out->mallocs = atomic_load_explicit(&counters->_mallocs, memory_order_relaxed);
+    out->frees = atomic_load_explicit(&counters->_frees, memory_order_relaxed);
+    out->nodeBytes = atomic_load_explicit(&counters->_nodeBytes, memory_order_relaxed);
+    out->valueBytes = atomic_load_explicit(&counters->_valueBytes, memory_order_relaxed);
+}
+
+/**
+ * @brief Zeroes every counter except the byte counts.
+ * @private
+ */
+static void clearCounters(Counters *counters){
+    for (int op = 0; op < LIST_OP_COUNT; op++){
+        atomic_store_explicit(&counters->_calls[op], 0, memory_order_relaxed);
+        for (int b = 0; b < TLIST_LATENCY_BUCKETS; b++){
+            atomic_store_explicit(&counters->_latency[op][b], 0, memory_order_relaxed);
+        }
+    }
+    atomic_store_explicit(&counters->_traversed, 0, memory_order_relaxed);
+    atomic_store_explicit(&counters->_cursorHits, 0, memory_order_relaxed);
+    atomic_store_explicit(&counters->_cursorMisses, 0, memory_order_relaxed);
+    atomic_store_explicit(&counters->_mallocs, 0, memory_order_relaxed);
+    atomic_store_explicit(&counters->_frees, 0, memory_order_relaxed);
+}
+
+#endif
+
+/** @copydoc listStats */
+bool listStats(List this, ListStats *out){
+    if (out == NULL) {
+        fprintf(stderr, "Error in listStats(): The output pointer is NULL.\n");
+        return false;
+    }
+    memset(out, 0, sizeof(ListStats));
+    if (this == NULL) {
+        fprintf(stderr, "Error in listStats(): The provided list instance is NULL.\n");
+        return false;
+    }
+#ifdef TLIST_STATS
+    readCounters(&STORE(this)->_counters, out);
+    return true;
+#else
+    return false;
+#endif
+}
+
+/** @copydoc cursorStats */
+void cursorStats(List this, size_t *hits, size_t *misses){
+    if (hits != NULL) *hits = 0;
+    if (misses != NULL) *misses = 0;
+    if (this == NULL) {
+        fprintf(stderr, "Error in cursorStats(): The provided list instance is NULL.\n");
+        return;
+    }
+#ifdef TLIST_STATS
+    if (hits != NULL) *hits = atomic_load_explicit(&STORE(this)->_counters._cursorHits, memory_order_relaxed);
+    if (misses != NULL) *misses = atomic_load_explicit(&STORE(this)->_counters._cursorMisses, memory_order_relaxed);
+#endif
+}
+
+/** @copydoc globalStats */
+bool globalStats(ListStats *out){
+    if (out == NULL) {
+        fprintf(stderr, "Error in globalStats(): The output pointer is NULL.\n");
+        return false;
+    }
+    memset(out, 0, sizeof(ListStats));
+#ifdef TLIST_STATS
+    readCounters(&globalCounters, out);
+    return true;
+#else
+    return false;
+#endif
+}
+
+/** @copydoc resetStats */
+void resetStats(List this){
+#ifdef TLIST_STATS
+    clearCounters(this == NULL ? &globalCounters : &STORE(this)->_counters);
+#else
+    (void)this;
+#endif
+}
+
+/** @copydoc statsTiming */
+void statsTiming(bool enabled){
+#ifdef TLIST_STATS
+    atomic_store(&timing, enabled);
+#else
+    (void)enabled;
+#endif
+}
+
+/** Names of the `ListOp` values, as printed by `dumpStats`. @private */
+static const char *const opNames[LIST_OP_COUNT] = {
+    "push", "pop", "print", "len", "free", "get", "set", "remove", "insert", "pick", "foreach", "array",
+};
+
+/** @copydoc dumpStats */
+void dumpStats(FILE *out){
+    if (out == NULL) {
+        fprintf(stderr, "Error in dumpStats(): The output stream is NULL.\n");
+        return;
+    }
+    ListStats stats;
+    if (!globalStats(&stats)) {
+        fprintf(out, "Tlist statistics are not available (built without TLIST_STATS).\n");
+        return;
+    }
+    fprintf(out, "Tlist statistics\n");
+    for (int op = 0; op < LIST_OP_COUNT; op++){
+        if (stats.calls[op] == 0) continue;
+        fprintf(out, "  %-8s %12zu calls", opNames[op], stats.calls[op]);
+        for (int b = 0; b < TLIST_LATENCY_BUCKETS; b++){
+            if (stats.latency[op][b] == 0) continue;
+            fprintf(out, " | %s%lluns: %zu", b == TLIST_LATENCY_BUCKETS - 1 ? ">=" : "<",
+                1ull << (b == TLIST_LATENCY_BUCKETS - 1 ? b : b + 1), stats.latency[op][b]);
+        }
+        fputc('\n', out);
+    }
+    fprintf(out, "  nodes traversed %zu\n", stats.nodesTraversed);
+    fprintf(out, "  mallocs %zu, frees %zu\n", stats.mallocs, stats.frees);
+    fprintf(out, "  node bytes %lld, value bytes %lld\n", stats.nodeBytes, stats.valueBytes);
+}
@@ -0,0 +1,292 @@
+/**
+ * @file Tsync.c
+ * @brief Reader-writer locking for lists created with `LIST_SYNC`.
+ *
+ * `initSync` wraps the method table of whichever storage backend the list
+ * uses. Every wrapper takes the list's `pthread_rwlock_t`:
+ * shared for `get`, `len`, `print` and `foreach`, exclusive for everything
+ * that modifies the list. Readers therefore run concurrently and only wait
+ * for writers.
+ *
+ * Locks are re-entrant per thread: each thread records the lists it holds,
+ * so a method called while `listLock` is held (or from inside a `foreach`
+ * callback) reuses the existing acquisition instead of deadlocking. A read
+ * lock cannot be upgraded; a modifying call made under one reports an error
+ * and does nothing.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "Tlist.h"
+#include "TlistPrivate.h"
+#include <pthread.h>
+
+/**
+ * @struct SyncStore
+ * @brief The lock of a `LIST_SYNC` list and the methods it wraps.
+ * @private
+ */
+struct SyncStore{
+    pthread_rwlock_t _lock;
+    const struct ListMethods *_inner;       /**< Methods of the wrapped storage. */
+    bool _freed;                            /**< Set by `syncFree`; the last unlock then destroys `_lock`. */
+};
+
+/** @private */
+#define STORE(list) ((list)->_extra->_sync)
+
+/**
+ * @struct HeldLock
+ * @brief A list locked by the current thread.
+ * @private
+ */
+typedef struct HeldLock{
+    List _list;
+    int _depth;         /**< Number of nested acquisitions. */
+    bool _exclusive;
+} HeldLock;
+
+/** Lists locked by the current thread. @private */
+static _Thread_local HeldLock heldLocks[TLIST_SYNC_NESTING];
+static _Thread_local int heldCount;
+
+/** @private */
+static HeldLock *findHeld(List this){
+    for (int i = 0; i < heldCount; i++){
+        if (heldLocks[i]._list == this) return &heldLocks[i];
+    }
+    return NULL;
+}
+
+/** @copydoc listLock */
+bool listLock(List this, bool exclusive){
+    if (this == NULL) {
+        fprintf(stderr, "Error in listLock(): The provided list instance is NULL.\n");
+        return false;
+    }
+    if (STORE(this) == NULL) return true;
+    HeldLock *held = findHeld(this);
+    if (held != NULL) {
+        if (exclusive && !held->_exclusive) {
+            fprintf(stderr, "Error in listLock(): Cannot modify a list while holding its read lock.\n");
+            return false;
+        }
+        held->_depth++;
+        return true;
+    }
+    if (heldCount == TLIST_SYNC_NESTING) {
+        fprintf(stderr, "Error in listLock(): A thread can hold at most %d list locks.\n", TLIST_SYNC_NESTING);
+        return false;
+    }
+    if (exclusive) pthread_rwlock_wrlock(&STORE(this)->_lock);
+    else pthread_rwlock_rdlock(&STORE(this)->_lock);
+    heldLocks[heldCount++] = (HeldLock){ this, 1, exclusive };
+    return true;
+}
+
+/** @copydoc readLockHeld */
+bool readLockHeld(List this){
+    HeldLock *held = STORE(this) == NULL ? NULL : findHeld(this);
+    return held != NULL && !held->_exclusive;
+}
+
+/** @copydoc listUnlock */
+void listUnlock(List this){
+    if (this == NULL) {
+        fprintf(stderr, "Error in listUnlock(): The provided list instance is NULL.\n");
+        return;
+    }
+    if (STORE(this) == NULL) return;
+    HeldLock *held = findHeld(this);
+    if (held == NULL) {
+        fprintf(stderr, "Error in listUnlock(): The list is not locked by this thread.\n");
+        return;
+    }
+    if (--held->_depth > 0) return;
+    pthread_rwlock_unlock(&STORE(this)->_lock);
+    *held = heldLocks[--heldCount];
+    if (STORE(this)->_freed) pthread_rwlock_destroy(&STORE(this)->_lock);
+}
+
+/* Backend primitives ------------------------------------------------------ */
+
+/** @private */
+static void syncPushValue(List this, void *val){
+    if (!listLock(this, true)) return;
+    STORE(this)->_inner->pushValue(this, val);
+    listUnlock(this);
+}
+
+/** @private */
+static void syncInsertValue(List this, int index, void *val){
+    if (!listLock(this, true)) return;
+    STORE(this)->_inner->insertValue(this, index, val);
+    listUnlock(this);
+}
+
+/** @private */
+static void syncSetValue(List this, int index, void *val){
+    if (!listLock(this, true)) return;
+    STORE(this)->_inner->setValue(this, index, val);
+    listUnlock(this);
+}
+
+/** @private */
+static bool syncPopValue(List this, void *out){
+    if (!listLock(this, true)) return false;
+    bool popped = STORE(this)->_inner->popValue(this, out);
+    listUnlock(this);
+    return popped;
+}
+
+/**
+ * @brief Inserts an array under the write lock, re-checking the index.
+ *
+ * `insertArray` validates the index before calling the backend, but another
+ * writer may have shrunk the list since.
+ * @private
+ */
+static void syncInsertArray(List this, int index, const void *values, size_t n){
+    if (!listLock(this, true)) return;
+    if (index > this->_length) {
+        fprintf(stderr, "Error in insertArray(): Index %d is out of bounds. Valid range is 0 to %d.\n", index, this->_length);
+    } else {
+        STORE(this)->_inner->insertArray(this, index, values, n);
+    }
+    listUnlock(this);
+}
+
+/* Methods ----------------------------------------------------------------- */
+
+/** @private */
+static void *syncPop(List this){
+    if (!listLock(this, true)) return NULL;
+    void *val = STORE(this)->_inner->pop(this);
+    listUnlock(this);
+    return val;
+}
+
+/** @private */
+static void syncPrint(List this){
+    if (!listLock(this, false)) return;
+    STORE(this)->_inner->print(this);
+    listUnlock(this);
+}
+
+/** @private */
+static int syncLen(List this){
+    if (!listLock(this, false)) return -1;
+    int length = STORE(this)->_inner->len(this);
+    listUnlock(this);
+    return length;
+}
+
+/**
+ * @brief Frees the elements and, once this thread releases the list, its lock.
+ *
+ * The list must not be used after this, not even by a thread that was
+ * waiting for the lock.
+ * @private
+ */
+static void syncFree(List this){
+    if (!listLock(this, true)) return;
+    STORE(this)->_inner->free(this);
+    STORE(this)->_freed = true;
+    listUnlock(this);
+}
+
+/** @private */
+static void *syncGet(List this, int index){
+    if (!listLock(this, false)) return NULL;
+    void *val = STORE(this)->_inner->get(this, index);
+    listUnlock(this);
+    return val;
+}
+
+/** @private */
+static void syncDelete(List this, int index){
+    if (!listLock(this, true)) return;
+    STORE(this)->_inner->remove(this, index);
+    listUnlock(this);
+}
+
+/** @private */
+static void *syncPick(List this, int index){
+    if (!listLock(this, true)) return NULL;
+    void *val = STORE(this)->_inner->pick(this, index);
+    listUnlock(this);
+    return val;
+}
+
+/** @private */
+static void syncForeach(List this, void(*function)(void*)){
+    if (!listLock(this, false)) return;
+    STORE(this)->_inner->foreach(this, function);
+    listUnlock(this);
+}
+
+/**
+ * @brief Methods of `LIST_SYNC` lists, one table per `Type`.
+ * @private
+ */
+static const struct ListMethods syncMethods[TLIST_TYPES] = LIST_METHODS(
+    .pop = syncPop,
+    .print = syncPrint,
+    .len = syncLen,
+    .free = syncFree,
+    .get = syncGet,
+    .remove = syncDelete,
+    .pick = syncPick,
+    .foreach = syncForeach,
+    .pushValue = syncPushValue,
+    .insertValue = syncInsertValue,
+    .setValue = syncSetValue,
+    .popValue = syncPopValue,
+    .insertArray = syncInsertArray,
+);
+
+/** @copydoc syncStoreSize */
+size_t syncStoreSize(void){
+    return sizeof(struct SyncStore);
+}
+
+/** @copydoc syncInner */
+const struct ListMethods **syncInner(List this){
+    return &STORE(this)->_inner;
+}
+
+/** @copydoc initSync */
+void initSync(List this, void *memory){
+    struct SyncStore *store = memory;
+    if (pthread_rwlock_init(&store->_lock, NULL) != 0) {
+        fprintf(stderr, "Error in newList(): Failed to initialize the list lock.\n");
+        exit(EXIT_FAILURE);
+    }
+    store->_inner = this->methods;
+    store->_freed = false;
+    listExtra(this)->_sync = store;
+    setMethods(this, &syncMethods[this->_type]);
+}
+
+/** @copydoc snapshot */
+List snapshot(List this){
+    if (this == NULL) {
+        fprintf(stderr, "Error in snapshot(): The provided list instance is NULL.\n");
+        return NULL;
+    }
+    if (!readLockHeld(this)) {
+        if (!listLock(this, true)) return NULL;
+        List copy = shareList(this, this->_flags & ~LIST_SYNC);
+        listUnlock(this);
+        return copy;
+    }
+    // Sharing needs the write lock, so a caller holding the read lock gets a full copy.
+    if (!listLock(this, false)) return NULL;
+    List copy = deriveList(this, this->_type, this->_flags & ~LIST_SYNC);
+    TLIST_FOREACH(this, val) {
+        // `get` form is also the form `pushValue` takes.
+        copy->methods->pushValue(copy, val);
+    }
+    listUnlock(this);
+    return copy;
+}
@@ -0,0 +1,549 @@
+/**
+ * @file Tunrolled.c
+ * @brief Unrolled linked list backend, selected with `LIST_UNROLLED`.
+ *
+ * Elements are packed into `Chunk`s of about `TLIST_CHUNK_BYTES` bytes instead
+ * of one node per element. Indexed operations skip whole chunks using their
+ * element counts and scans walk contiguous memory. A full chunk is split in
+ * two when an element is inserted into it, and a chunk that drops below half
+ * its capacity is merged with its successor when both fit in one chunk.
+ *
+ * The backend fills the same `struct Lista` methods as the linked list, with
+ * the same semantics: `get` returns a pointer to the stored value (the string
+ * for `STRING`, the stored pointer for `T`), and `pop`/`pick` return a
+ * caller-owned pointer.
+ */
+
+#include "Tlist.h"
+#include "TlistPrivate.h"
+
+/** @brief Returns the address of slot `i` of `chunk`. @private */
+#define SLOT(list, chunk, i) ((chunk)->_slots + (size_t)(i) * (list)->_size)
+
+/** @brief Returns the unrolled storage state of a list. @private */
+#define STORE(list) ((struct UnrolledStore *)listStore(list))
+
+/** @brief Size in bytes of one chunk of a list. @private */
+#define CHUNK_BYTES(list) (sizeof(struct Chunk) + (size_t)STORE(list)->_capacity * (list)->_size)
+
+/**
+ * @brief Methods of `LIST_UNROLLED` lists, one table per `Type`.
+ * @private
+ */
+static const struct ListMethods unrolledMethods[TLIST_TYPES] = LIST_METHODS(
+    .pop = unrolledPop,
+    .print = unrolledPrint,
+    .len = listLength,
+    .free = unrolledDestroy,
+    .get = unrolledGet,
+    .remove = unrolledDelete,
+    .pick = unrolledPick,
+    .foreach = unrolledForeach,
+    .pushValue = unrolledPushValue,
+    .insertValue = unrolledInsertValue,
+    .setValue = unrolledSetValue,
+    .popValue = unrolledPopValue,
+    .insertArray = unrolledInsertArray,
+);
+
+/** @copydoc initUnrolled */
+void initUnrolled(List this, struct UnrolledStore *store){
+    store->_first = NULL;
+    store->_last = NULL;
+    int capacity = (int)((TLIST_CHUNK_BYTES - sizeof(struct Chunk)) / this->_size);
+    store->_capacity = capacity < 2 ? 2 : capacity;
+    setMethods(this, &unrolledMethods[this->_type]);
+}
+
+/**
+ * @brief Allocates an empty chunk sized for the list's type.
+ * @private
+ */
+static struct Chunk *newChunk(List this){
+    struct Chunk *chunk = (struct Chunk *)listAlloc(this, CHUNK_BYTES(this));
+    if (chunk == NULL) {
+        fprintf(stderr, "Error in newChunk(): Failed to allocate memory for a new chunk.\n");
+        exit(EXIT_FAILURE);
+    }
+    STAT_MEMORY(this, CHUNK_BYTES(this), 0, 1, 0);
+    chunk->_nextChunk = NULL;
+    chunk->_count = 0;
+    return chunk;
+}
+
+/**
+ * @brief Finds the chunk holding the element at `*index`.
+ *
+ * Whole chunks are skipped using their counts. On success `*index` is replaced
+ * by the offset inside the chunk and `*prev` (if not `NULL`) receives the
+ * preceding chunk.
+ * @return The chunk, or `NULL` if the index is out of bounds.
+ * @private
+ */
+static struct Chunk *findChunk(List this, int *index, struct Chunk **prev){
+    struct Chunk *before = NULL;
+    struct Chunk *chunk = STORE(this)->_first;
+    int offset = *index;
+    while (chunk != NULL && offset >= chunk->_count){
+        offset -= chunk->_count;
+        before = chunk;
+        chunk = chunk->_nextChunk;
+        STAT_TRAVERSED(this, 1);
+    }
+    if (chunk == NULL) {
+        return NULL;
+    }
+    *index = offset;
+    if (prev != NULL) *prev = before;
+    return chunk;
+}
+
+/**
+ * @brief Removes slot `offset` from `chunk` and rebalances the chunk chain.
+ *
+ * The slot's value must already have been released or handed to the caller.
+ * Empty chunks are unlinked and freed; a chunk below half capacity absorbs its
+ * successor when their elements fit in one chunk.
+ * @private
+ */
+static void removeSlot(List this, struct Chunk *chunk, struct Chunk *prev, int offset){
+    struct UnrolledStore *store = STORE(this);
+    memmove(SLOT(this, chunk, offset), SLOT(this, chunk, offset + 1), (size_t)(chunk->_count - offset - 1) * this->_size);
+    chunk->_count--;
+    this->_length--;
+
+    if (chunk->_count == 0) {
+        if (prev == NULL) store->_first = chunk->_nextChunk;
+        else prev->_nextChunk = chunk->_nextChunk;
+        if (store->_last == chunk) store->_last = prev;
+        STAT_MEMORY(this, -(long long)CHUNK_BYTES(this), 0, 0, 1);
+        listFree(this, chunk);
+        return;
+    }
+    struct Chunk *next = chunk->_nextChunk;
+    if (next != NULL && chunk->_count < store->_capacity / 2 && chunk->_count + next->_count <= store->_capacity) {
+        memcpy(SLOT(this, chunk, chunk->_count), next->_slots, (size_t)next->_count * this->_size);
+        chunk->_count += next->_count;
+        chunk->_nextChunk = next->_nextChunk;
+        if (store->_last == next) store->_last = chunk;
+        STAT_MEMORY(this, -(long long)CHUNK_BYTES(this), 0, 0, 1);
+        listFree(this, next);
+    }
+}
+
+/**
+ * @brief Makes element `index` start a chunk, splitting the chunk holding it if needed.
+ * @return The chunk ending just before `index`, or `NULL` if `index` is 0.
+ * @private
+ */
+static struct Chunk *chunkBoundary(List this, int index){
+    struct UnrolledStore *store = STORE(this);
+    if (index == 0) return NULL;
+    if (index == this->_length) return store->_last;
+    int offset = index;
+    struct Chunk *prev = NULL;
+    struct Chunk *chunk = findChunk(this, &offset, &prev);
+    if (offset == 0) return prev;
+    struct Chunk *rest = newChunk(this);
+    rest->_count = chunk->_count - offset;
+    memcpy(rest->_slots, SLOT(this, chunk, offset), (size_t)rest->_count * this->_size);
+    chunk->_count = offset;
+    rest->_nextChunk = chunk->_nextChunk;
+    chunk->_nextChunk = rest;
+    if (store->_last == chunk) store->_last = rest;
+    return chunk;
+}
+
+/**
+ * @brief Moves elements `[from, to)` of `src` before index `pos` of `dst`.
+ *
+ * Both ends of the range and the insertion point are turned into chunk
+ * boundaries (at most three chunk splits), and the chunks in between are
+ * relinked as a whole. Arguments are validated by `spliceRange`.
+ * @private
+ */
+void unrolledSplice(List dst, int pos, List src, int from, int to){
+    struct UnrolledStore *source = STORE(src);
+    struct UnrolledStore *target = STORE(dst);
+    int n = to - from;
+    struct Chunk *before = chunkBoundary(src, from);
+    struct Chunk *last = chunkBoundary(src, to);
+    struct Chunk *first = before == NULL ? source->_first : before->_nextChunk;
+    if (before == NULL) source->_first = last->_nextChunk;
+    else before->_nextChunk = last->_nextChunk;
+    if (source->_last == last) source->_last = before;
+    src->_length -= n;
+
+    struct Chunk *at = chunkBoundary(dst, pos);
+    last->_nextChunk = at == NULL ? target->_first : at->_nextChunk;
+    if (at == NULL) target->_first = first;
+    else at->_nextChunk = first;
+    if (last->_nextChunk == NULL) target->_last = last;
+    dst->_length += n;
+}
+
+/**
+ * @brief Non-variadic core of `push`; `val` is in `readArg` form.
+ * @private
+ */
+void unrolledPushValue(List this, void *val){
+    struct UnrolledStore *store = STORE(this);
+    if (store->_last == NULL) {
+        store->_first = store->_last = newChunk(this);
+    } else if (store->_last->_count == store->_capacity) {
+        store->_last->_nextChunk = newChunk(this);
+        store->_last = store->_last->_nextChunk;
+    }
+    writeSlot(this, SLOT(this, store->_last, store->_last->_count), val);
+    store->_last->_count++;
+    this->_length++;
+}
+
+/**
+ * @brief Removes the first element of the list and returns a caller-owned pointer to it.
+ * @param this A pointer to the list.
+ * @return The removed value, or `NULL` if the list is empty.
+ * @private
+ */
+void *unrolledPop(List this){
+    if (this == NULL) {
+        fprintf(stderr, "Error in pop(): The provided list instance is NULL.\n");
+        return NULL;
+    }
+    struct Chunk *first = STORE(this)->_first;
+    if (first == NULL) {
+        return NULL;
+    }
+    void *val = detachSlot(this, first->_slots);
+    removeSlot(this, first, NULL, 0);
+    return val;
+}
+
+/**
+ * @brief Removes the first element of the list and writes it to `out`. See `popInto`.
+ * @private
+ */
+bool unrolledPopValue(List this, void *out){
+    struct Chunk *first = STORE(this)->_first;
+    if (first == NULL) {
+        return false;
+    }
+    // Strings are handed over as is, arena strings as a copy.
+    if (this->_type == STRING) *(char **)out = detachSlot(this, first->_slots);
+    else memcpy(out, first->_slots, this->_size);
+    removeSlot(this, first, NULL, 0);
+    return true;
+}
+
+/**
+ * @brief Prints the contents of the list to standard output.
+ * @param this A pointer to the list.
+ * @private
+ */
+void unrolledPrint(List this){
+    if (this == NULL) {
+        fprintf(stderr, "Error in print(): The provided list instance is NULL.\n");
+        return;
+    }
+    printf("[");
+    for (struct Chunk *chunk = STORE(this)->_first; chunk != NULL; chunk = chunk->_nextChunk){
+        for (int i = 0; i < chunk->_count; i++){
+            printValue(this, slotValue(this, SLOT(this, chunk, i)));
+            if (i + 1 < chunk->_count || chunk->_nextChunk != NULL){
+                printf(", ");
+            }
+        }
+    }
+    printf("]");
+    printf("\n");
+}
+
+/**
+ * @brief Frees all chunks and the strings they own. Does not free the `List` struct.
+ * @param this A pointer to the list.
+ * @private
+ */
+void unrolledDestroy(List this){
+    if (this == NULL) {
+        fprintf(stderr, "Error in destroyList(): The provided list instance is NULL.\n");
+        return;
+    }
+    struct Chunk *chunk = STORE(this)->_first;
+    while (chunk != NULL){
+        struct Chunk *temp = chunk;
+        chunk = temp->_nextChunk;
+        if (this->_type == STRING && !(this->_flags & LIST_ARENA)) {
+            for (int i = 0; i < temp->_count; i++){
+                releaseString(this, *(char **)SLOT(this, temp, i));
+            }
+        }
+        STAT_MEMORY(this, -(long long)CHUNK_BYTES(this), 0, 0, 1);
+        listFree(this, temp);
+    }
+    releaseArena(this);
+    releaseExtra(this);
+    STORE(this)->_first = NULL;
+    STORE(this)->_last = NULL;
+    this->_length = 0;
+}
+
+/**
+ * @brief Retrieves a pointer to the element at a specific index.
+ * @param this A pointer to the list.
+ * @param index The zero-based index of the element to retrieve.
+ * @return A pointer to the element's value, or `NULL` if the index is out of bounds.
+ * @private
+ */
+void *unrolledGet(List this, int index){
+    if (this == NULL) {
+        fprintf(stderr, "Error in get(): The provided list instance is NULL.\n");
+        return NULL;
+    }
+    if (index < 0) {
+        fprintf(stderr, "Error in get(): Index %d is negative and invalid.\n", index);
+        return NULL;
+    }
+    int offset = index;
+    struct Chunk *chunk = findChunk(this, &offset, NULL);
+    if (chunk == NULL) {
+        fprintf(stderr, "Error in get(): Index %d is out of bounds for list of size %d.\n", index, this->_length);
+        return NULL;
+    }
+    return slotValue(this, SLOT(this, chunk, offset));
+}
+
+/**
+ * @brief Non-variadic core of `set`; `val` is in `readArg` form.
+ * @private
+ */
+void unrolledSetValue(List this, int index, void *val){
+    if (index < 0) {
+        fprintf(stderr, "Error in set(): Index %d is negative and invalid.\n", index);
+        return;
+    }
+    int offset = index;
+    struct Chunk *chunk = findChunk(this, &offset, NULL);
+    if (chunk == NULL) {
+        fprintf(stderr, "Error in set(): Index %d is out of bounds for list of size %d.\n", index, this->_length);
+        return;
+    }
+    unsigned char *slot = SLOT(this, chunk, offset);
+    // The new string is copied before the old one is freed, so `val` may alias it.
+    char *old = this->_type == STRING ? *(char **)slot : NULL;
+    writeSlot(this, slot, val);
+    releaseString(this, old);
+}
+
+/**
+ * @brief Deletes the element at a specific index, freeing its value.
+ * @param this A pointer to the list.
+ * @param index The zero-based index of the element to delete.
+ * @private
+ */
+void unrolledDelete(List this, int index){
+    if (this == NULL) {
+        fprintf(stderr, "Error in delete(): The provided list instance is NULL.\n");
+        return;
+    }
+    if (index < 0) {
+        fprintf(stderr, "Error in delete(): Index %d is negative and invalid.\n", index);
+        return;
+    }
+    int offset = index;
+    struct Chunk *prev;
+    struct Chunk *chunk = findChunk(this, &offset, &prev);
+    if (chunk == NULL) {
+        fprintf(stderr, "Error in delete(): Index %d is out of bounds for list of size %d.\n", index, this->_length);
+        return;
+    }
+    if (this->_type == STRING) {
+        releaseString(this, *(char **)SLOT(this, chunk, offset));
+    }
+    removeSlot(this, chunk, prev, offset);
+}
+
+/**
+ * @brief Inserts a new element at a specific index; `val` is in `readArg` form.
+ *
+ * Inserting into a full chunk first splits it, moving its upper half into a
+ * new chunk linked right after it.
+ * @private
+ */
+void unrolledInsertValue(List this, int index, void *val){
+    if (index < 0 || index > this->_length) {
+        fprintf(stderr, "Error in insert(): Index %d is out of bounds. Valid range is 0 to %d.\n", index, this->_length);
+        return;
+    }
+    if (index == this->_length) {
+        unrolledPushValue(this, val);
+        return;
+    }
+    struct UnrolledStore *store = STORE(this);
+    int offset = index;
+    struct Chunk *chunk = findChunk(this, &offset, NULL);
+    if (chunk->_count == store->_capacity) {
+        int half = store->_capacity / 2;
+        struct Chunk *upper = newChunk(this);
+        upper->_count = chunk->_count - half;
+        memcpy(upper->_slots, SLOT(this, chunk, half), (size_t)upper->_count * this->_size);
+        chunk->_count = half;
+        upper->_nextChunk = chunk->_nextChunk;
+        chunk->_nextChunk = upper;
+        if (store->_last == chunk) store->_last = upper;
+        if (offset > half) {
+            chunk = upper;
+            offset -= half;
+        }
+    }
+    memmove(SLOT(this, chunk, offset + 1), SLOT(this, chunk, offset), (size_t)(chunk->_count - offset) * this->_size);
+    writeSlot(this, SLOT(this, chunk, offset), val);
+    chunk->_count++;
+    this->_length++;
+}
+
+/**
+ * @brief Inserts `n` array elements at `index`. See `insertArray`.
+ *
+ * The chunk holding `index` is split once at the insertion point and the new
+ * elements are packed into full chunks linked in between.
+ * @private
+ */
+void unrolledInsertArray(List this, int index, const void *values, size_t n){
+    struct UnrolledStore *store = STORE(this);
+    if (index == this->_length) {
+        for (size_t i = 0; i < n; i++){
+            unrolledPushValue(this, arrayValue(this, values, i));
+        }
+        return;
+    }
+    int offset = index;
+    struct Chunk *before = NULL;
+    struct Chunk *rest = findChunk(this, &offset, &before);
+    if (offset > 0) {
+        struct Chunk *chunk = rest;
+        rest = newChunk(this);
+        rest->_count = chunk->_count - offset;
+        memcpy(rest->_slots, SLOT(this, chunk, offset), (size_t)rest->_count * this->_size);
+        chunk->_count = offset;
+        rest->_nextChunk = chunk->_nextChunk;
+        if (store->_last == chunk) store->_last = rest;
+        before = chunk;
+    }
+    struct Chunk *first = NULL;
+    struct Chunk *last = NULL;
+    for (size_t i = 0; i < n; i++){
+        if (last == NULL || last->_count == store->_capacity) {
+            struct Chunk *chunk = newChunk(this);
+            if (last == NULL) first = chunk;
+            else last->_nextChunk = chunk;
+            last = chunk;
+        }
+        writeSlot(this, SLOT(this, last, last->_count), arrayValue(this, values, i));
+        last->_count++;
+    }
+    if (before == NULL) store->_first = first;
+    else before->_nextChunk = first;
+    last->_nextChunk = rest;
+    this->_length += (int)n;
+}
+
+/**
+ * @brief Removes and returns the element at a specific index.
+ * @param this A pointer to the list.
+ * @param index The zero-based index of the element to remove.
+ * @return A caller-owned pointer to the removed value, or `NULL` if the index is out of bounds.
+ * @private
+ */
+void *unrolledPick(List this, int index){
+    if (this == NULL) {
+        fprintf(stderr, "Error in pick(): The provided list instance is NULL.\n");
+        return NULL;
+    }
+    if (index < 0) {
+        fprintf(stderr, "Error in pick(): Index %d is negative and invalid.\n", index);
+        return NULL;
+    }
+    int offset = index;
+    struct Chunk *prev;
+    struct Chunk *chunk = findChunk(this, &offset, &prev);
+    if (chunk == NULL) {
+        fprintf(stderr, "Error in pick(): Index %d is out of bounds for list of size %d.\n", index, this->_length);
+        return NULL;
+    }
+    void *val = detachSlot(this, SLOT(this, chunk, offset));
+    removeSlot(this, chunk, prev, offset);
+    return val;
+}
+
+/**
+ * @brief Applies a given function to each element in the list.
+ * @param this A pointer to the list.
+ * @param function The function to apply to each element's value.
+ * @private
+ */
+void unrolledForeach(List this, void(*function)(void*)){
+    if (this == NULL) {
+        fprintf(stderr, "Error in foreach(): The provided list instance is NULL.\n");
+        return;
+    }
+    for (struct Chunk *chunk = STORE(this)->_first; chunk != NULL; chunk = chunk->_nextChunk){
+        for (int i = 0; i < chunk->_count; i++){
+            function(slotValue(this, SLOT(this, chunk, i)));
+        }
+    }
+}
+
+/**
+ * @brief Iterator `next` for unrolled lists.
+ * @param iterator A pointer to the iterator.
+ * @return A pointer to the next element's value, or `NULL` if the end is reached.
+ * @private
+ */
+void* unrolledNext(TIterator iterator){
+    if (iterator == NULL || iterator->_chunk == NULL) {
+        fprintf(stderr, "Error in next(): No more elements to iterate or invalid iterator.\n");
+        return NULL;
+    }
+    List list = iterator->_list;
+    void *val = slotValue(list, SLOT(list, iterator->_chunk, iterator->_offset));
+    iterator->_index++;
+    if (++iterator->_offset == iterator->_chunk->_count) {
+        iterator->_chunk = iterator->_chunk->_nextChunk;
+        iterator->_offset = 0;
+    }
+    return val;
+}
+
+/**
+ * @brief `nextBatch` for unrolled lists: copies element pointers chunk by chunk.
+ * @private
+ */
+size_t unrolledNextBatch(TIterator iterator, void **out, size_t max){
+    List list = iterator->_list;
+    size_t n = 0;
+    while (n < max && iterator->_chunk != NULL){
+        struct Chunk *chunk = iterator->_chunk;
+        while (n < max && iterator->_offset < chunk->_count){
+            out[n++] = slotValue(list, SLOT(list, chunk, iterator->_offset++));
+        }
+        if (iterator->_offset == chunk->_count) {
+            iterator->_chunk = chunk->_nextChunk;
+            iterator->_offset = 0;
+        }
+    }
+    iterator->_index += (int)n;
+    return n;
+}
+
+/**
+ * @brief Iterator `hasNext` for unrolled lists.
+ * @param iterator A pointer to the iterator.
+ * @return `true` if there is at least one more element.
+ * @private
+ */
+bool unrolledHasNext(TIterator iterator){
+    if (iterator == NULL) {
+        return false;
+    }
+    return iterator->_chunk != NULL;
+}
@@ -0,0 +1,469 @@
+/**
+ * @file Tvector.c
+ * @brief Contiguous dynamic-array backend, selected with `LIST_VECTOR`.
+ *
+ * Elements live in a single array of slots that grows geometrically, so `get`
+ * and `set` are O(1) and scans walk sequential memory. The live elements
+ * occupy a window starting at `_start`: `pop` only advances the window, and
+ * `insert`/`remove` shift whichever side of the index is shorter. The unused
+ * front space is reclaimed by compacting the array before growing it, which
+ * keeps `push` and `pop` amortized O(1) when the list is used as a queue.
+ *
+ * Slots are laid out like those of the unrolled backend (see `slotValue`), and
+ * all methods keep the semantics of the linked list.
+ */
+
+#include "Tlist.h"
+#include "TlistPrivate.h"
+
+/** @brief Returns the vector storage state of a list. @private */
+#define STORE(list) ((struct VectorStore *)listStore(list))
+
+/** @brief Returns the address of the element at list index `i`. @private */
+#define ELEMENT(list, i) (STORE(list)->_data + (size_t)(STORE(list)->_start + (i)) * (list)->_size)
+
+/**
+ * @brief Methods of `LIST_VECTOR` lists, one table per `Type`.
+ * @private
+ */
+static const struct ListMethods vectorMethods[TLIST_TYPES] = LIST_METHODS(
+    .pop = vectorPop,
+    .print = vectorPrint,
+    .len = listLength,
+    .free = vectorDestroy,
+    .get = vectorGet,
+    .remove = vectorDelete,
+    .pick = vectorPick,
+    .foreach = vectorForeach,
+    .pushValue = vectorPushValue,
+    .insertValue = vectorInsertValue,
+    .setValue = vectorSetValue,
+    .popValue = vectorPopValue,
+    .insertArray = vectorInsertArray,
+);
+
+/** @copydoc initVector */
+void initVector(List this, struct VectorStore *store){
+    store->_data = NULL;
+    store->_start = 0;
+    store->_capacity = 0;
+    setMethods(this, &vectorMethods[this->_type]);
+}
+
+/**
+ * @brief Moves the elements to the front of the array and makes room for `capacity` of them.
+ *
+ * The array is only reallocated when `capacity` exceeds the current one.
+ * @param this A pointer to the list.
+ * @param capacity The number of elements the array must hold from slot 0.
+ * @private
+ */
+void vectorReserve(List this, int capacity){
+    struct VectorStore *store = STORE(this);
+    if (store->_start > 0) {
+        memmove(store->_data, ELEMENT(this, 0), (size_t)this->_length * this->_size);
+        store->_start = 0;
+    }
+    if (capacity <= store->_capacity) {
+        return;
+    }
+    unsigned char *data = listRealloc(this, store->_data, (size_t)store->_capacity * this->_size, (size_t)capacity * this->_size);
+    if (data == NULL) {
+        fprintf(stderr, "Error in listReserve(): Failed to allocate memory for %d elements.\n", capacity);
+        exit(EXIT_FAILURE);
+    }
+    // A reallocation releases the former array, so `mallocs - frees` stays the number of live blocks.
+    STAT_MEMORY(this, (long long)(capacity - store->_capacity) * (long long)this->_size, 0, 1, store->_data != NULL);
+    store->_data = data;
+    store->_capacity = capacity;
+}
+
+/** @copydoc listReserve */
+void listReserve(List this, int capacity){
+    if (this == NULL) {
+        fprintf(stderr, "Error in listReserve(): The provided list instance is NULL.\n");
+        return;
+    }
+    if (!listLock(this, true)) return;
+    unshare(this);
+    if ((this->_flags & LIST_VECTOR) && capacity > STORE(this)->_capacity - STORE(this)->_start) {
+        vectorReserve(this, capacity);
+    }
+    listUnlock(this);
+}
+
+/**
+ * @brief Moves elements `[from, to)` of `src` before index `pos` of `dst`.
+ *
+ * The slots are copied in bulk; `STRING` slots carry their heap pointer, so
+ * ownership moves without copying any string. Arguments are validated by
+ * `spliceRange`.
+ * @private
+ */
+void vectorSplice(List dst, int pos, List src, int from, int to){
+    int n = to - from;
+    struct VectorStore *target = STORE(dst);
+    if (target->_capacity - target->_start < dst->_length + n) {
+        int capacity = 2 * target->_capacity;
+        vectorReserve(dst, capacity > dst->_length + n ? capacity : dst->_length + n);
+    }
+    memmove(ELEMENT(dst, pos + n), ELEMENT(dst, pos), (size_t)(dst->_length - pos) * dst->_size);
+    memcpy(ELEMENT(dst, pos), ELEMENT(src, from), (size_t)n * src->_size);
+    dst->_length += n;
+    memmove(ELEMENT(src, from), ELEMENT(src, to), (size_t)(src->_length - to) * src->_size);
+    src->_length -= n;
+    if (src->_length == 0) STORE(src)->_start = 0;
+}
+
+/**
+ * @brief Ensures there is a free slot after the last element.
+ *
+ * Front space left by `pop` is reclaimed first when it makes up at least half
+ * of the array; otherwise the capacity doubles.
+ * @private
+ */
+static void growBack(List this){
+    struct VectorStore *store = STORE(this);
+    if (store->_start + this->_length < store->_capacity) {
+        return;
+    }
+    if (store->_start >= store->_capacity / 2 && store->_start > 0) {
+        vectorReserve(this, store->_capacity);
+    } else {
+        int capacity = store->_capacity < TLIST_VECTOR_MIN_CAPACITY ? TLIST_VECTOR_MIN_CAPACITY : store->_capacity * 2;
+        vectorReserve(this, capacity);
+    }
+}
+
+/**
+ * @brief Adds a new element to the end of the list in amortized O(1); `val` is in `readArg` form.
+ * @private
+ */
+void vectorPushValue(List this, void *val){
+    growBack(this);
+    writeSlot(this, ELEMENT(this, this->_length), val);
+    this->_length++;
+}
+
+/**
+ * @brief Removes the element at `index` from the array, keeping the others in order.
+ *
+ * The slot's value must already have been released or handed to the caller.
+ * The shorter side of the array is shifted; removing the first element is O(1).
+ * @private
+ */
+static void removeElement(List this, int index){
+    struct VectorStore *store = STORE(this);
+    if (index < this->_length / 2) {
+        memmove(ELEMENT(this, 1), ELEMENT(this, 0), (size_t)index * this->_size);
+        store->_start++;
+    } else {
+        memmove(ELEMENT(this, index), ELEMENT(this, index + 1), (size_t)(this->_length - index - 1) * this->_size);
+    }
+    this->_length--;
+    if (this->_length == 0) {
+        store->_start = 0;
+    }
+}
+
+/**
+ * @brief Removes the first element of the list in O(1) and returns a caller-owned pointer to it.
+ * @param this A pointer to the list.
+ * @return The removed value, or `NULL` if the list is empty.
+ * @private
+ */
+void *vectorPop(List this){
+    if (this == NULL) {
+        fprintf(stderr, "Error in pop(): The provided list instance is NULL.\n");
+        return NULL;
+    }
+    if (this->_length == 0) {
+        return NULL;
+    }
+    void *val = detachSlot(this, ELEMENT(this, 0));
+    removeElement(this, 0);
+    return val;
+}
+
+/**
+ * @brief Removes the first element of the list and writes it to `out`. See `popInto`.
+ * @private
+ */
+bool vectorPopValue(List this, void *out){
+    if (this->_length == 0) {
+        return false;
+    }
+    // Strings are handed over as is, arena strings as a copy.
+    if (this->_type == STRING) *(char **)out = detachSlot(this, ELEMENT(this, 0));
+    else memcpy(out, ELEMENT(this, 0), this->_size);
+    removeElement(this, 0);
+    return true;
+}
+
+/**
+ * @brief Prints the contents of the list to standard output.
+ * @param this A pointer to the list.
+ * @private
+ */
+void vectorPrint(List this){
+    if (this == NULL) {
+        fprintf(stderr, "Error in print(): The provided list instance is NULL.\n");
+        return;
+    }
+    printf("[");
+    for (int i = 0; i < this->_length; i++){
+        printValue(this, slotValue(this, ELEMENT(this, i)));
+        if (i + 1 < this->_length){
+            printf(", ");
+        }
+    }
+    printf("]");
+    printf("\n");
+}
+
+/**
+ * @brief Frees the array and the strings it owns. Does not free the `List` struct.
+ * @param this A pointer to the list.
+ * @private
+ */
+void vectorDestroy(List this){
+    if (this == NULL) {
+        fprintf(stderr, "Error in destroyList(): The provided list instance is NULL.\n");
+        return;
+    }
+    if (this->_type == STRING && !(this->_flags & LIST_ARENA)) {
+        for (int i = 0; i < this->_length; i++){
+            releaseString(this, *(char **)ELEMENT(this, i));
+        }
+    }
+    releaseArena(this);
+    if (STORE(this)->_data != NULL) STAT_MEMORY(this, -(long long)STORE(this)->_capacity * (long long)this->_size, 0, 0, 1);
+    listFree(this, STORE(this)->_data);
+    STORE(this)->_data = NULL;
+    STORE(this)->_start = 0;
+    STORE(this)->_capacity = 0;
+    this->_length = 0;
+    releaseExtra(this);
+}
+
+/**
+ * @brief Retrieves a pointer to the element at a specific index in O(1).
+ * @param this A pointer to the list.
+ * @param index The zero-based index of the element to retrieve.
+ * @return A pointer to the element's value, or `NULL` if the index is out of bounds.
+ * @private
+ */
+void *vectorGet(List this, int index){
+    if (this == NULL) {
+        fprintf(stderr, "Error in get(): The provided list instance is NULL.\n");
+        return NULL;
+    }
+    if (index < 0) {
+        fprintf(stderr, "Error in get(): Index %d is negative and invalid.\n", index);
+        return NULL;
+    }
+    if (index >= this->_length) {
+        fprintf(stderr, "Error in get(): Index %d is out of bounds for list of size %d.\n", index, this->_length);
+        return NULL;
+    }
+    return slotValue(this, ELEMENT(this, index));
+}
+
+/**
+ * @brief Updates the value of an element at a specific index in O(1); `val` is in `readArg` form.
+ * @private
+ */
+void vectorSetValue(List this, int index, void *val){
+    if (index < 0) {
+        fprintf(stderr, "Error in set(): Index %d is negative and invalid.\n", index);
+        return;
+    }
+    if (index >= this->_length) {
+        fprintf(stderr, "Error in set(): Index %d is out of bounds for list of size %d.\n", index, this->_length);
+        return;
+    }
+    unsigned char *slot = ELEMENT(this, index);
+    // The new string is copied before the old one is freed, so `val` may alias it.
+    char *old = this->_type == STRING ? *(char **)slot : NULL;
+    writeSlot(this, slot, val);
+    releaseString(this, old);
+}
+
+/**
+ * @brief Deletes the element at a specific index, freeing its value.
+ * @param this A pointer to the list.
+ * @param index The zero-based index of the element to delete.
+ * @private
+ */
+void vectorDelete(List this, int index){
+    if (this == NULL) {
+        fprintf(stderr, "Error in delete(): The provided list instance is NULL.\n");
+        return;
+    }
+    if (index < 0) {
+        fprintf(stderr, "Error in delete(): Index %d is negative and invalid.\n", index);
+        return;
+    }
+    if (index >= this->_length) {
+        fprintf(stderr, "Error in delete(): Index %d is out of bounds for list of size %d.\n", index, this->_length);
+        return;
+    }
+    if (this->_type == STRING) {
+        releaseString(this, *(char **)ELEMENT(this, index));
+    }
+    removeElement(this, index);
+}
+
+/**
+ * @brief Inserts a new element at a specific index; `val` is in `readArg` form.
+ *
+ * Elements before the index are shifted towards the front when there is free
+ * space there and the index is in the first half; otherwise the elements after
+ * it are shifted towards the back.
+ * @private
+ */
+void vectorInsertValue(List this, int index, void *val){
+    if (index < 0 || index > this->_length) {
+        fprintf(stderr, "Error in insert(): Index %d is out of bounds. Valid range is 0 to %d.\n", index, this->_length);
+        return;
+    }
+    struct VectorStore *store = STORE(this);
+    if (store->_start > 0 && index < this->_length / 2) {
+        store->_start--;
+        memmove(ELEMENT(this, 0), ELEMENT(this, 1), (size_t)index * this->_size);
+    } else {
+        growBack(this);
+        memmove(ELEMENT(this, index + 1), ELEMENT(this, index), (size_t)(this->_length - index) * this->_size);
+    }
+    writeSlot(this, ELEMENT(this, index), val);
+    this->_length++;
+}
+
+/**
+ * @brief Inserts `n` array elements at `index`. See `insertArray`.
+ *
+ * Grows the array at most once and shifts the following elements once.
+ * @private
+ */
+void vectorInsertArray(List this, int index, const void *values, size_t n){
+    struct VectorStore *store = STORE(this);
+    int needed = this->_length + (int)n;
+    if (store->_start + needed > store->_capacity) {
+        int capacity = store->_capacity < TLIST_VECTOR_MIN_CAPACITY ? TLIST_VECTOR_MIN_CAPACITY : store->_capacity;
+        while (capacity < needed){
+            capacity = capacity > INT_MAX / 2 ? needed : capacity * 2;
+        }
+        vectorReserve(this, capacity);
+    }
+    memmove(ELEMENT(this, index + (int)n), ELEMENT(this, index), (size_t)(this->_length - index) * this->_size);
+    for (size_t i = 0; i < n; i++){
+        writeSlot(this, ELEMENT(this, index + (int)i), arrayValue(this, values, i));
+    }
+    this->_length = needed;
+}
+
+/**
+ * @brief Removes and returns the element at a specific index.
+ * @param this A pointer to the list.
+ * @param index The zero-based index of the element to remove.
+ * @return A caller-owned pointer to the removed value, or `NULL` if the index is out of bounds.
+ * @private
+ */
+void *vectorPick(List this, int index){
+    if (this == NULL) {
+        fprintf(stderr, "Error in pick(): The provided list instance is NULL.\n");
+        return NULL;
+    }
+    if (index < 0) {
+        fprintf(stderr, "Error in pick(): Index %d is negative and invalid.\n", index);
+        return NULL;
+    }
+    if (index >= this->_length) {
+        fprintf(stderr, "Error in pick(): Index %d is out of bounds for list of size %d.\n", index, this->_length);
+        return NULL;
+    }
+    void *val = detachSlot(this, ELEMENT(this, index));
+    removeElement(this, index);
+    return val;
+}
+
+/**
+ * @brief Applies a given function to each element in the list.
+ * @param this A pointer to the list.
+ * @param function The function to apply to each element's value.
+ * @private
+ */
+void vectorForeach(List this, void(*function)(void*)){
+    if (this == NULL) {
+        fprintf(stderr, "Error in foreach(): The provided list instance is NULL.\n");
+        return;
+    }
+    for (int i = 0; i < this->_length; i++){
+        function(slotValue(this, ELEMENT(this, i)));
+    }
+}
+
+/**
+ * @brief Iterator `next` for vector lists.
+ * @param iterator A pointer to the iterator.
+ * @return A pointer to the next element's value, or `NULL` if the end is reached.
+ * @private
+ */
+void* vectorNext(TIterator iterator){
+    if (iterator == NULL || iterator->_index >= iterator->_list->_length) {
+        fprintf(stderr, "Error in next(): No more elements to iterate or invalid iterator.\n");
+        return NULL;
+    }
+    List list = iterator->_list;
+    return slotValue(list, ELEMENT(list, iterator->_index++));
+}
+
+/**
+ * @brief Iterator `next` for reverse iterators over vector lists.
+ * @private
+ */
+void *vectorPrev(TIterator iterator){
+    if (iterator == NULL || iterator->_index < 0 || iterator->_index >= iterator->_list->_length) {
+        fprintf(stderr, "Error in next(): No more elements to iterate or invalid iterator.\n");
+        return NULL;
+    }
+    List list = iterator->_list;
+    return slotValue(list, ELEMENT(list, iterator->_index--));
+}
+
+/**
+ * @brief Iterator `hasNext` for reverse iterators over vector lists.
+ * @private
+ */
+bool vectorHasPrev(TIterator iterator){
+    if (iterator == NULL) {
+        return false;
+    }
+    return iterator->_index >= 0 && iterator->_index < iterator->_list->_length;
+}
+
+/**
+ * @brief `nextBatch` for vector lists.
+ * @private
+ */
+size_t vectorNextBatch(TIterator iterator, void **out, size_t max){
+    List list = iterator->_list;
+    size_t n = 0;
+    while (n < max && iterator->_index < list->_length){
+        out[n++] = slotValue(list, ELEMENT(list, iterator->_index++));
+    }
+    return n;
+}
+
+/**
+ * @brief Iterator `hasNext` for vector lists.
+ * @param iterator A pointer to the iterator.
+ * @return `true` if there is at least one more element.
+ * @private
+ */
+bool vectorHasNext(TIterator iterator){
+    if (iterator == NULL) {
+        return false;
+    }
+    return iterator->_index < iterator->_list->_length;
+}
@@ -0,0 +1,33 @@
+/**
+ * @file check.h
+ * @brief Minimal assertion helpers shared by the unit tests.
+ *
+ * `CHECK` reports a failed condition with its location and keeps going, so
+ * one run lists every failure; `checkResult` turns the count into the exit
+ * status that CTest reads.
+ */
+
+#ifndef T_LIST_CHECK
+#define T_LIST_CHECK
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/** Number of failed checks in this test program. */
+static int checkFailures;
+
+/** @brief Records a failure, with its location, when `cond` is false. */
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+        checkFailures++; \
+    } \
+} while (0)
+
+/** @brief Returns the exit status of the test program. */
+static inline int checkResult(void){
+    if (checkFailures > 0) fprintf(stderr, "%d check(s) failed\n", checkFailures);
+    return checkFailures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,166 @@
+/**
+ * @file test_alloc.c
+ * @brief Lists created with a `TAllocator` take no memory from `malloc` once created.
+ *
+ * On Linux the build links this test with `--wrap` for the C allocator, so
+ * every `malloc`, `calloc` and `realloc` made by the library is counted; the
+ * counting allocator below goes to the real functions and is not.
+ */
+
+#include "Tlist.h"
+#include "check.h"
+#include <stdint.h>
+
+/** Calls that reached the C allocator while `counting` was set. */
+static size_t mallocCalls;
+static bool counting;
+
+#ifdef TLIST_TEST_WRAP
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *pointer, size_t size);
+
+void *__wrap_malloc(size_t size){
+    if (counting) mallocCalls++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size){
+    if (counting) mallocCalls++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *pointer, size_t size){
+    if (counting) mallocCalls++;
+    return __real_realloc(pointer, size);
+}
+
+#define REAL_MALLOC __real_malloc
+#define REAL_REALLOC __real_realloc
+#else
+#define REAL_MALLOC malloc
+#define REAL_REALLOC realloc
+#endif
+
+/** Blocks handed out and returned by the counting allocator. */
+typedef struct Counts{
+    size_t allocs;
+    size_t frees;
+} Counts;
+
+static void *countAlloc(void *context, size_t size){
+    ((Counts *)context)->allocs++;
+    return REAL_MALLOC(size);
+}
+
+static void *countRealloc(void *context, void *ptr, size_t oldSize, size_t size){
+    (void)context;
+    (void)oldSize;
+    return REAL_REALLOC(ptr, size);
+}
+
+static void countFree(void *context, void *ptr){
+    ((Counts *)context)->frees++;
+    free(ptr);
+}
+
+static bool intEquals(const void *a, const void *b){
+    return *(const int *)a == *(const int *)b;
+}
+
+static size_t intHash(const void *value){
+    return (size_t)(uint32_t)*(const int *)value * 2654435761u;
+}
+
+/**
+ * @brief Runs the common operations on an `INT` list with `flags` and checks
+ * that none of them calls `malloc` and that every block goes back to the allocator.
+ */
+static void testIntList(int flags){
+    Counts counts = {0, 0};
+    TAllocator allocator = { countAlloc, countRealloc, countFree, &counts };
+    List list = newListWithFlagsAndAllocator(INT, flags, &allocator);
+    CHECK(list != NULL);
+    if (list == NULL) return;
+    List other = newListWithFlagsAndAllocator(INT, flags, &allocator);
+
+    mallocCalls = 0;
+    counting = true;
+    for (int i = 0; i < 2000; i++) pushInt(list, (i * 7919) % 2000);
+    for (int i = 0; i < 100; i++) insertInt(list, i * 3, -i);
+    for (int i = 0; i < 50; i++) listRemove(list, i * 5);
+    setInt(list, 10, 12345);
+    long sum = 0;
+    for (int i = 0; i < listLen(list); i += 17) sum += *(int *)listGet(list, i);
+    TLIST_FOREACH(list, val) sum += *(int *)val;
+    TIterator iterator = newIterator(list);
+    while (iterator->hasNext(iterator)) sum += *(int *)iterator->next(iterator);
+    iterator->free(iterator);
+    listSort(list, compareInt);
+    // Only linked lists take a hash index; the others search their storage.
+    bool linked = !(flags & (LIST_UNROLLED | LIST_VECTOR));
+    if (linked) CHECK(indexList(list, intHash, intEquals));
+    CHECK(listContains(list, 12345));
+    CHECK(removeAll(list, 12345) == 1);
+    CHECK(!listContains(list, 12345));
+    if (linked) dropIndex(list);
+    for (int i = 0; i < 100; i++) pushInt(other, i);
+    spliceRange(list, 5, other, 10, 60);
+    CHECK(listLen(other) == 50);
+    counting = false;
+    CHECK(mallocCalls == 0);
+    CHECK(sum != 0);
+
+    CHECK(counts.allocs > 0);
+    listDestroy(list);
+    listDestroy(other);
+    CHECK(counts.allocs == counts.frees);
+    free(list);
+    free(other);
+}
+
+/** @brief Same for arena and heap strings, which also keep their bytes in the allocator. */
+static void testStringList(int flags){
+    Counts counts = {0, 0};
+    TAllocator allocator = { countAlloc, countRealloc, countFree, &counts };
+    List list = newListWithFlagsAndAllocator(STRING, flags, &allocator);
+    CHECK(list != NULL);
+    if (list == NULL) return;
+
+    mallocCalls = 0;
+    counting = true;
+    for (int i = 0; i < 500; i++) pushString(list, i % 2 ? "short" : "a string too long to be stored inside the node");
+    listSort(list, compareString);
+    CHECK(listCountOf(list, "short") == 250);
+    listRemove(list, 0);
+    counting = false;
+    CHECK(mallocCalls == 0);
+
+    listDestroy(list);
+    CHECK(counts.allocs > 0 && counts.allocs == counts.frees);
+    free(list);
+}
+
+/** @brief The flags an allocator cannot serve are rejected instead of half-honoured. */
+static void testRejected(void){
+    Counts counts = {0, 0};
+    TAllocator allocator = { countAlloc, countRealloc, countFree, &counts };
+    CHECK(newListWithFlagsAndAllocator(INT, LIST_QUEUE, &allocator) == NULL);
+    TAllocator partial = { countAlloc, NULL, countFree, &counts };
+    CHECK(newListWithFlagsAndAllocator(INT, LIST_DEFAULT, &partial) == NULL);
+    List list = newListWithFlagsAndAllocator(INT, LIST_QUEUE, NULL);
+    CHECK(list != NULL);
+    listDestroy(list);
+    free(list);
+}
+
+int main(void){
+    const int flags[] = { LIST_DEFAULT, LIST_SLAB, LIST_DOUBLY, LIST_SLAB | LIST_DOUBLY,
+                          LIST_UNROLLED, LIST_VECTOR, LIST_SYNC, LIST_SYNC | LIST_VECTOR };
+    for (size_t i = 0; i < sizeof flags / sizeof flags[0]; i++) testIntList(flags[i]);
+    testStringList(LIST_DEFAULT);
+    testStringList(LIST_ARENA);
+    testStringList(LIST_INTERN | LIST_UNROLLED);
+    testRejected();
+    return checkResult();
+}
@@ -0,0 +1,221 @@
+/**
+ * @file test_arena.c
+ * @brief `LIST_ARENA` and `LIST_INTERN` strings around every string block size, and interned pointer equality.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "Tlist.h"
+#include "check.h"
+#include <string.h>
+#include <unistd.h>
+
+/** First and largest string block sizes (`TLIST_ARENA_MIN_BLOCK`, `TLIST_ARENA_MAX_BLOCK`). */
+#define MIN_BLOCK 4096
+#define MAX_BLOCK (1 << 20)
+
+/** @brief Returns a string of `length` characters that depends on `seed`. */
+static char *makeString(size_t length, int seed){
+    char *string = malloc(length + 1);
+    for (size_t i = 0; i < length; i++) string[i] = (char)('a' + (i + (size_t)seed) % 26);
+    string[length] = '\0';
+    return string;
+}
+
+/**
+ * @brief Pushes strings whose size (terminator included) lies just below, at
+ * and just above each block size, into a fresh list and after smaller strings.
+ */
+static void testBlockSizes(int flags){
+    for (size_t block = MIN_BLOCK; block <= MAX_BLOCK; block *= 2){
+        for (int warm = 0; warm < 2; warm++){
+            List list = newListWithFlags(STRING, flags);
+            if (warm) list->methods->push(list, "warm-up string");
+            int first = list->methods->len(list);
+            for (int delta = -2; delta <= 1; delta++){
+                char *string = makeString(block + (size_t)delta - 1, delta);
+                list->methods->push(list, string);
+                free(string);
+            }
+            for (int delta = -2; delta <= 1; delta++){
+                char *string = makeString(block + (size_t)delta - 1, delta);
+                const char *stored = getString(list, first + delta + 2);
+                CHECK(stored != NULL && strcmp(stored, string) == 0);
+                free(string);
+            }
+            list->methods->free(list);
+            free(list);
+        }
+    }
+}
+
+/** @brief Loads an image holding a string larger than the first blocks into an arena list. */
+static void testLoad(void){
+    List list = newList(STRING);
+    char *big = makeString(200 * 1024, 7);
+    list->methods->push(list, "before");
+    list->methods->push(list, big);
+    list->methods->push(list, "after");
+    FILE *file = tmpfile();
+    CHECK(file != NULL);
+    if (file == NULL) return;
+    CHECK(writeList(list, fileno(file)));
+    lseek(fileno(file), 0, SEEK_SET);
+    List loaded = readList(fileno(file), LIST_ARENA);
+    CHECK(loaded != NULL);
+    if (loaded != NULL) {
+        CHECK(loaded->methods->len(loaded) == 3);
+        CHECK(strcmp(getString(loaded, 0), "before") == 0);
+        CHECK(strcmp(getString(loaded, 1), big) == 0);
+        CHECK(strcmp(getString(loaded, 2), "after") == 0);
+        loaded->methods->free(loaded);
+        free(loaded);
+    }
+    fclose(file);
+    free(big);
+    list->methods->free(list);
+    free(list);
+}
+
+/** Backends the interning tests run on; `LIST_INTERN` is added to each. */
+static const int internFlags[] = {
+    LIST_DEFAULT, LIST_SLAB, LIST_UNROLLED, LIST_VECTOR, LIST_DOUBLY, LIST_SYNC, LIST_SYNC | LIST_VECTOR,
+};
+#define INTERN_FLAGS (int)(sizeof(internFlags) / sizeof(internFlags[0]))
+
+/** Distinct tokens, short and long. */
+#define WORDS 40
+static char words[WORDS][80];
+
+/**
+ * @brief Checks that every element of `list` is the interned copy of its
+ * word, and that searches agree with the word numbers in `model`.
+ */
+static void checkInterned(List list, const int *model, int n){
+    CHECK(listLen(list) == n);
+    int i = 0;
+    TLIST_FOREACH(list, val){
+        if (i < n) CHECK(val == internedString(list, words[model[i]]));
+        i++;
+    }
+    for (int w = 0; w < WORDS; w++){
+        int first = -1, count = 0;
+        for (int k = 0; k < n; k++){
+            if (model[k] != w) continue;
+            if (first < 0) first = k;
+            count++;
+        }
+        // A copy of the word, so the search has to look it up rather than match its address.
+        char copy[80];
+        strcpy(copy, words[w]);
+        CHECK(listIndexOf(list, copy) == first);
+        CHECK(listCountOf(list, copy) == count);
+        CHECK(listContains(list, copy) == (count > 0));
+        if (first >= 0) CHECK(getString(list, first) == internedString(list, copy));
+    }
+}
+
+/** @brief Equal strings share one stored copy through pushes, inserts, sets, removals and sorting. */
+static void testInterning(int flags){
+    List list = newListWithFlags(STRING, LIST_INTERN | flags);
+    static int model[3000];
+    int n = 0;
+    CHECK(internedString(list, words[0]) == NULL);
+    unsigned state = (unsigned)flags + 1;
+    for (int step = 0; step < 3000; step++){
+        state = state * 1103515245u + 12345u;
+        int word = (int)((state >> 8) % WORDS);
+        int index = n == 0 ? 0 : (int)((state >> 16) % (unsigned)n);
+        switch (n < 10 ? 0 : step % 6){
+            case 1:
+                insertString(list, index, words[word]);
+                memmove(model + index + 1, model + index, (size_t)(n++ - index) * sizeof(int));
+                model[index] = word;
+                break;
+            case 2:
+                setString(list, index, words[word]);
+                model[index] = word;
+                break;
+            case 3: {
+                char *popped = listPop(list);
+                // `pop` hands out a copy of its own.
+                CHECK(popped != NULL && strcmp(popped, words[model[0]]) == 0);
+                CHECK(popped != internedString(list, words[model[0]]));
+                free(popped);
+                memmove(model, model + 1, (size_t)--n * sizeof(int));
+                break;
+            }
+            default:
+                pushString(list, words[word]);
+                model[n++] = word;
+                break;
+        }
+        if (step % 500 == 0) checkInterned(list, model, n);
+    }
+    checkInterned(list, model, n);
+
+    // Equal strings are one pointer, distinct strings are not.
+    for (int a = 0; a < n && a < 200; a++){
+        for (int b = a + 1; b < n && b < 200; b++){
+            CHECK((getString(list, a) == getString(list, b)) == (model[a] == model[b]));
+        }
+    }
+
+    // Removing every copy of a word leaves it stored, and searches find nothing.
+    char copy[80];
+    strcpy(copy, words[3]);
+    const char *stored = internedString(list, copy);
+    int removed = 0;
+    for (int k = 0; k < n; k++) removed += model[k] == 3;
+    CHECK(removeAll(list, copy) == removed);
+    int kept = 0;
+    for (int k = 0; k < n; k++){
+        if (model[k] != 3) model[kept++] = model[k];
+    }
+    n = kept;
+    CHECK(stored == NULL || internedString(list, copy) == stored);
+    checkInterned(list, model, n);
+
+    listSort(list, NULL);
+    for (int k = 1; k < n; k++) CHECK(strcmp(getString(list, k - 1), getString(list, k)) <= 0);
+    TLIST_FOREACH(list, val) CHECK(val == internedString(list, val));
+
+    // A duplicate reads the same stored copies until it is written to.
+    List view = duplicate(list);
+    CHECK(getString(view, 0) == getString(list, 0));
+    pushString(view, words[0]);
+    CHECK(getString(view, listLen(view) - 1) == internedString(view, words[0]));
+    TLIST_FOREACH(view, val) CHECK(val == internedString(view, val));
+    TLIST_FOREACH(list, val) CHECK(val == internedString(list, val));
+    listDestroy(view);
+    free(view);
+    listDestroy(list);
+    free(list);
+}
+
+/** @brief Without `LIST_INTERN`, each string is stored on its own, and searches compare contents. */
+static void testArenaCopies(void){
+    List list = newListWithFlags(STRING, LIST_ARENA);
+    for (int i = 0; i < 100; i++) pushString(list, words[i % 3]);
+    CHECK(getString(list, 0) != getString(list, 3));
+    CHECK(strcmp(getString(list, 0), getString(list, 3)) == 0);
+    char copy[80];
+    strcpy(copy, words[1]);
+    CHECK(listIndexOf(list, copy) == 1 && listCountOf(list, copy) == 33);
+    CHECK(internedString(list, copy) == NULL);
+    listDestroy(list);
+    free(list);
+}
+
+int main(void){
+    for (int w = 0; w < WORDS; w++){
+        snprintf(words[w], sizeof words[w], "token-%d%s", w, w % 4 ? "" : " long enough to leave the short-string size behind");
+    }
+    testBlockSizes(LIST_ARENA);
+    testBlockSizes(LIST_INTERN);
+    testBlockSizes(LIST_ARENA | LIST_VECTOR);
+    testLoad();
+    for (int f = 0; f < INTERN_FLAGS; f++) testInterning(internFlags[f]);
+    testArenaCopies();
+    return checkResult();
+}
@@ -0,0 +1,199 @@
+/**
+ * @file test_doubly.c
+ * @brief `LIST_DOUBLY` lists used as deques and LRU orderings, against an array model.
+ */
+
+#include "Tlist.h"
+#include "check.h"
+#include <string.h>
+
+/** Doubly linked variants, and the singly linked lists they must agree with. */
+static const int flagSets[] = {
+    LIST_DOUBLY, LIST_SLAB | LIST_DOUBLY, LIST_SYNC | LIST_DOUBLY, LIST_DEFAULT, LIST_SLAB,
+};
+#define FLAG_SETS (int)(sizeof(flagSets) / sizeof(flagSets[0]))
+
+#define CAPACITY 8192
+
+/** @brief Checks `list` against `model` forwards, backwards and by index from both ends. */
+static void checkModel(List list, const int *model, int n){
+    CHECK(listLen(list) == n);
+    int i = 0;
+    TLIST_FOREACH(list, val) CHECK(i < n && *(int *)val == model[i++]);
+    CHECK(i == n);
+    if (list->_flags & LIST_DOUBLY) {
+        struct TIterator reverse = reverseIteratorOf(list);
+        void *val;
+        while (iteratorStep(&reverse, &val)) CHECK(i > 0 && *(int *)val == model[--i]);
+        CHECK(i == 0);
+    }
+    for (int k = 0; k < n && k < 8; k++){
+        CHECK(getInt(list, k) == model[k]);
+        CHECK(getInt(list, n - 1 - k) == model[n - 1 - k]);
+    }
+}
+
+/** @brief Random pushes and pops at both ends, plus indexed edits near each end. */
+static void testDeque(int flags){
+    List list = newListWithFlags(INT, flags);
+    static int model[2 * CAPACITY];
+    // The model is centred so that pushes at the front have room.
+    int *front = model + CAPACITY, n = 0;
+    unsigned state = (unsigned)flags + 5;
+    for (int step = 0; step < 20000; step++){
+        state = state * 1103515245u + 12345u;
+        unsigned r = state >> 8;
+        int value = (int)(r & 0xffff);
+        int op = n == 0 ? (int)(r % 2) : (int)(r % 8);
+        if (n >= CAPACITY - 1) op = 2 + op % 2;
+        if (front == model + 1 || front + n == model + 2 * CAPACITY - 1) {
+            // Recentre the model window.
+            memmove(model + CAPACITY / 2, front, (size_t)n * sizeof(int));
+            front = model + CAPACITY / 2;
+        }
+        switch (op){
+            case 0:
+                pushInt(list, value);
+                front[n++] = value;
+                break;
+            case 1:
+                pushFront(list, value);
+                *--front = value;
+                n++;
+                break;
+            case 2: {
+                int *back = popBack(list);
+                CHECK(back != NULL && *back == front[n - 1]);
+                free(back);
+                n--;
+                break;
+            }
+            case 3: {
+                int out;
+                CHECK(popInto(list, &out) && out == front[0]);
+                front++;
+                n--;
+                break;
+            }
+            case 4: {
+                // Near the back, where doubly lists walk from the tail.
+                int index = n - 1 - (int)(r / 8 % (unsigned)(n < 5 ? n : 5));
+                listRemove(list, index);
+                memmove(front + index, front + index + 1, (size_t)(--n - index) * sizeof(int));
+                break;
+            }
+            case 5: {
+                int index = n - (int)(r / 8 % (unsigned)(n < 5 ? n + 1 : 5));
+                insertInt(list, index, value);
+                memmove(front + index + 1, front + index, (size_t)(n++ - index) * sizeof(int));
+                front[index] = value;
+                break;
+            }
+            case 6: {
+                int index = (int)(r / 8 % (unsigned)n);
+                setInt(list, index, value);
+                front[index] = value;
+                break;
+            }
+            default: {
+                int index = (int)(r / 8 % (unsigned)n);
+                int *picked = listPick(list, index);
+                CHECK(picked != NULL && *picked == front[index]);
+                free(picked);
+                memmove(front + index, front + index + 1, (size_t)(--n - index) * sizeof(int));
+                break;
+            }
+        }
+        if (step % 500 == 0) checkModel(list, front, n);
+    }
+    checkModel(list, front, n);
+    while (n > 0){
+        int *back = popBack(list);
+        CHECK(back != NULL && *back == front[--n]);
+        free(back);
+    }
+    CHECK(popBack(list) == NULL && listLen(list) == 0);
+    pushFront(list, 1);
+    CHECK(getInt(list, 0) == 1);
+    listDestroy(list);
+    free(list);
+}
+
+/** @brief An LRU ordering: each access moves its key to the front through a node handle. */
+static void testLru(int flags){
+    if (!(flags & LIST_DOUBLY)) return;
+    List list = newListWithFlags(INT, flags);
+    int model[64];
+    int n = 0;
+    for (int i = 0; i < 64; i++) pushInt(list, model[n++] = i);
+    unsigned state = 11;
+    for (int step = 0; step < 5000; step++){
+        state = state * 1103515245u + 12345u;
+        int index = (int)((state >> 8) % 64);
+        Node node = nodeAt(list, index);
+        CHECK(node != NULL && *(int *)nodeValue(node) == model[index]);
+        int key = model[index];
+        removeNode(list, node);
+        pushFront(list, key);
+        memmove(model + 1, model, (size_t)index * sizeof(int));
+        model[0] = key;
+        // Evict the least recently used key and bring in a new one.
+        if (step % 10 == 0) {
+            int *evicted = popBack(list);
+            CHECK(evicted != NULL && *evicted == model[63]);
+            free(evicted);
+            pushFront(list, 1000 + step);
+            memmove(model + 1, model, 63 * sizeof(int));
+            model[0] = 1000 + step;
+        }
+    }
+    checkModel(list, model, 64);
+    // The head and the tail can be unlinked through their handles too.
+    removeNode(list, nodeAt(list, 0));
+    removeNode(list, nodeAt(list, 62));
+    checkModel(list, model + 1, 62);
+    listDestroy(list);
+    free(list);
+}
+
+#ifdef TLIST_STATS
+/** @brief Indexed lookups walk from the nearer end: the last elements cost a few steps, not the whole list. */
+static void testTraversal(void){
+    List doubly = newListWithFlags(INT, LIST_DOUBLY);
+    List singly = newList(INT);
+    for (int i = 0; i < 10000; i++){
+        pushInt(doubly, i);
+        pushInt(singly, i);
+    }
+    resetStats(doubly);
+    resetStats(singly);
+    for (int k = 2; k < 12; k++){
+        CHECK(getInt(doubly, 10000 - k) == 10000 - k);
+        CHECK(getInt(singly, 10000 - k) == 10000 - k);
+        // Drop the cursor so each lookup starts from an end.
+        pushFront(doubly, 0);
+        pushFront(singly, 0);
+        free(listPop(doubly));
+        free(listPop(singly));
+    }
+    ListStats d, s;
+    CHECK(listStats(doubly, &d) && listStats(singly, &s));
+    CHECK(d.nodesTraversed < 100);
+    CHECK(s.nodesTraversed > 10 * 9000);
+    listDestroy(doubly);
+    free(doubly);
+    listDestroy(singly);
+    free(singly);
+}
+#endif
+
+int main(void){
+    for (int f = 0; f < FLAG_SETS; f++){
+        testDeque(flagSets[f]);
+        testLru(flagSets[f]);
+    }
+#ifdef TLIST_STATS
+    testTraversal();
+#endif
+    return checkResult();
+}
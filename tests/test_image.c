@@ -0,0 +1,198 @@
+/**
+ * @file test_image.c
+ * @brief `saveList`/`loadList`/`mmapList` round trips and damaged images.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "Tlist.h"
+#include "check.h"
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+/** Size of the image header written by `writeList`. */
+#define HEADER_BYTES 32
+/** Offset of the first string offset (or value) in an image. */
+#define DATA_START HEADER_BYTES
+
+/** Options `loadList` rebuilds the images with. */
+static const int loadFlags[] = { LIST_DEFAULT, LIST_SLAB, LIST_UNROLLED, LIST_VECTOR, LIST_DOUBLY };
+
+/** Temporary image file, removed by `main`. */
+static char path[] = "/tmp/tlist_imageXXXXXX";
+
+/** @brief Returns `true` if `a` and `b` hold the same elements. */
+static bool sameList(List a, List b){
+    if (listLen(a) != listLen(b)) return false;
+    for (int i = 0; i < listLen(a); i++){
+        const void *x = listGet(a, i), *y = listGet(b, i);
+        switch (a->_type){
+            case INT: if (*(const int *)x != *(const int *)y) return false; break;
+            case FLOAT: if (memcmp(x, y, sizeof(float)) != 0) return false; break;
+            case DOUBLE: if (memcmp(x, y, sizeof(double)) != 0) return false; break;
+            default: if (strcmp(x, y) != 0) return false; break;
+        }
+    }
+    return true;
+}
+
+/** @brief Saves `list`, then checks it against every `loadList` flag set and `mmapList`. */
+static void roundTrip(List list){
+    CHECK(saveList(list, path));
+    for (size_t i = 0; i < sizeof loadFlags / sizeof loadFlags[0]; i++){
+        List loaded = loadList(path, loadFlags[i]);
+        CHECK(loaded != NULL && loaded->_type == list->_type && sameList(list, loaded));
+        if (loaded == NULL) continue;
+        listDestroy(loaded);
+        free(loaded);
+    }
+    List mapped = mmapList(path);
+    CHECK(mapped != NULL && sameList(list, mapped));
+    if (mapped == NULL) return;
+    // The first write copies the mapping; the file stays as it was.
+    if (list->_type == STRING) pushString(mapped, "appended");
+    else if (list->_type == INT) pushInt(mapped, 1);
+    else pushDouble(mapped, 1);
+    CHECK(listLen(mapped) == listLen(list) + 1);
+    listDestroy(mapped);
+    free(mapped);
+    List again = mmapList(path);
+    CHECK(again != NULL && sameList(list, again));
+    if (again == NULL) return;
+    listDestroy(again);
+    free(again);
+}
+
+static void testRoundTrips(void){
+    List ints = newList(INT);
+    List doubles = newList(DOUBLE);
+    List strings = newList(STRING);
+    roundTrip(ints);
+    roundTrip(doubles);
+    roundTrip(strings);
+    int extremes[] = { 0, -1, 1, INT32_MIN, INT32_MAX };
+    for (int i = 0; i < 5; i++) pushInt(ints, extremes[i]);
+    double specials[] = { 0.0, -0.0, 1e-310, -1e308, 0.1 };
+    for (int i = 0; i < 5; i++) pushDouble(doubles, specials[i]);
+    pushString(strings, "");
+    pushString(strings, "short");
+    pushString(strings, "a string long enough to live on the heap instead of the node");
+    for (int i = 0; i < 3000; i++){
+        pushInt(ints, i * 7 - 1000);
+        pushDouble(doubles, i / 3.0);
+        char buffer[32];
+        snprintf(buffer, sizeof buffer, "s%d", i);
+        pushString(strings, buffer);
+    }
+    roundTrip(ints);
+    roundTrip(doubles);
+    roundTrip(strings);
+    List lists[] = { ints, doubles, strings };
+    for (int i = 0; i < 3; i++) {
+        listDestroy(lists[i]);
+        free(lists[i]);
+    }
+}
+
+/** @brief Reads the image at `path` into `*bytes`. */
+static size_t readImage(unsigned char **bytes){
+    FILE *file = fopen(path, "rb");
+    fseek(file, 0, SEEK_END);
+    size_t size = (size_t)ftell(file);
+    rewind(file);
+    *bytes = malloc(size);
+    CHECK(fread(*bytes, 1, size, file) == size);
+    fclose(file);
+    return size;
+}
+
+/** @brief Replaces the image at `path` with `size` bytes. */
+static void writeImage(const unsigned char *bytes, size_t size){
+    FILE *file = fopen(path, "wb");
+    CHECK(fwrite(bytes, 1, size, file) == size);
+    fclose(file);
+}
+
+/** @brief Both readers refuse the image now at `path`. */
+static void checkRejected(void){
+    List loaded = loadList(path, LIST_DEFAULT);
+    List mapped = mmapList(path);
+    CHECK(loaded == NULL);
+    CHECK(mapped == NULL);
+    if (loaded != NULL) { listDestroy(loaded); free(loaded); }
+    if (mapped != NULL) { listDestroy(mapped); free(mapped); }
+}
+
+/** @brief Truncated images, a bad header and string offsets pointing outside the data. */
+static void testDamaged(Type type){
+    List list = newList(type);
+    for (int i = 0; i < 20; i++){
+        if (type == STRING) pushString(list, i % 2 ? "odd" : "even element");
+        else if (type == INT) pushInt(list, i);
+        else pushDouble(list, i);
+    }
+    CHECK(saveList(list, path));
+    unsigned char *image;
+    size_t size = readImage(&image);
+
+    size_t cuts[] = { 0, 3, HEADER_BYTES - 1, HEADER_BYTES, HEADER_BYTES + 5, size - 1 };
+    for (size_t i = 0; i < sizeof cuts / sizeof cuts[0]; i++){
+        writeImage(image, cuts[i]);
+        checkRejected();
+    }
+    unsigned char *copy = malloc(size + 8);
+    memcpy(copy, image, size);
+    memset(copy + size, 0, 8);
+    writeImage(copy, size + 8);
+    // `readList` stops after the image, so data may follow it on a stream; a mapping must match exactly.
+    List loaded = loadList(path, LIST_DEFAULT);
+    CHECK(loaded != NULL && sameList(list, loaded));
+    if (loaded != NULL) { listDestroy(loaded); free(loaded); }
+    CHECK(mmapList(path) == NULL);
+
+    memcpy(copy, image, size);
+    copy[0] = 'X';
+    writeImage(copy, size);
+    checkRejected();
+
+    memcpy(copy, image, size);
+    copy[8] = 9;
+    writeImage(copy, size);
+    checkRejected();
+
+    if (type == STRING) {
+        uint64_t offsets[] = { 0, 8, size - HEADER_BYTES, UINT64_MAX - 2 };
+        for (size_t i = 0; i < sizeof offsets / sizeof offsets[0]; i++){
+            memcpy(copy, image, size);
+            memcpy(copy + DATA_START + 8 * 5, &offsets[i], sizeof offsets[i]);
+            writeImage(copy, size);
+            CHECK(mmapList(path) == NULL);
+        }
+        // A length prefix that runs past the end of the data.
+        memcpy(copy, image, size);
+        uint64_t offset;
+        memcpy(&offset, copy + DATA_START, sizeof offset);
+        uint32_t length = 1u << 30;
+        memcpy(copy + DATA_START + offset - sizeof length, &length, sizeof length);
+        writeImage(copy, size);
+        checkRejected();
+    }
+    free(copy);
+    free(image);
+    listDestroy(list);
+    free(list);
+}
+
+int main(void){
+    int fd = mkstemp(path);
+    CHECK(fd >= 0);
+    if (fd < 0) return checkResult();
+    close(fd);
+    testRoundTrips();
+    testDamaged(INT);
+    testDamaged(DOUBLE);
+    testDamaged(STRING);
+    unlink(path);
+    return checkResult();
+}
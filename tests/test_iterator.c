@@ -0,0 +1,139 @@
+/**
+ * @file test_iterator.c
+ * @brief Every way of walking a list visits the same elements as indexed `get`.
+ */
+
+#include "Tlist.h"
+#include "check.h"
+#include <string.h>
+
+/** Backends and options every test runs on. */
+static const int flagSets[] = {
+    LIST_DEFAULT, LIST_SLAB, LIST_UNROLLED, LIST_VECTOR, LIST_DOUBLY, LIST_SYNC, LIST_SLAB | LIST_DOUBLY,
+    LIST_QUEUE,
+};
+#define FLAG_SETS (int)(sizeof(flagSets) / sizeof(flagSets[0]))
+
+/** Values gathered by `collect`. */
+static int collected[4096];
+static int collectedCount;
+
+static void collect(void *val){
+    collected[collectedCount++] = *(int *)val;
+}
+
+/** @brief Checks the forward walks of an `INT` list holding `expected`. */
+static void checkWalks(List list, const int *expected, int n){
+    // Heap iterator.
+    TIterator iterator = newIterator(list);
+    int i = 0;
+    while (iterator->hasNext(iterator)) CHECK(i < n && *(int *)iterator->next(iterator) == expected[i++]);
+    CHECK(i == n);
+    CHECK(!iterator->hasNext(iterator));
+    iterator->free(iterator);
+
+    // Stack iterator, through the same methods.
+    struct TIterator local = iteratorOf(list);
+    i = 0;
+    while (local.hasNext(&local)) CHECK(i < n && *(int *)local.next(&local) == expected[i++]);
+    CHECK(i == n);
+    local.free(&local);
+
+    // Batches of several sizes, including ones that do not divide the length.
+    const size_t sizes[] = { 1, 3, 64, 5000 };
+    for (int s = 0; s < 4; s++){
+        void *batch[5000];
+        struct TIterator batched = iteratorOf(list);
+        i = 0;
+        size_t got;
+        while ((got = nextBatch(&batched, batch, sizes[s])) > 0){
+            CHECK(got <= sizes[s]);
+            for (size_t j = 0; j < got; j++) CHECK(i < n && *(int *)batch[j] == expected[i++]);
+        }
+        CHECK(i == n);
+        CHECK(nextBatch(&batched, batch, sizes[s]) == 0);
+    }
+
+    // Batches mixed with single steps on one iterator.
+    struct TIterator mixed = iteratorOf(list);
+    i = 0;
+    while (mixed.hasNext(&mixed)){
+        CHECK(*(int *)mixed.next(&mixed) == expected[i++]);
+        void *batch[7];
+        size_t got = nextBatch(&mixed, batch, 7);
+        for (size_t j = 0; j < got; j++) CHECK(*(int *)batch[j] == expected[i++]);
+    }
+    CHECK(i == n);
+
+    i = 0;
+    TLIST_FOREACH(list, val) CHECK(i < n && *(int *)val == expected[i++]);
+    CHECK(i == n);
+
+    // `break` leaves the macro's loops after the current element.
+    i = 0;
+    TLIST_FOREACH(list, val){
+        if (i == n / 2) break;
+        i++;
+    }
+    CHECK(i == n / 2);
+
+    collectedCount = 0;
+    listForeach(list, collect);
+    CHECK(collectedCount == n && memcmp(collected, expected, (size_t)n * sizeof(int)) == 0);
+}
+
+/** @brief Checks the reverse walks of lists that support them. */
+static void checkReverse(List list, const int *expected, int n){
+    if (!(list->_flags & (LIST_DOUBLY | LIST_VECTOR))) return;
+    TIterator iterator = newReverseIterator(list);
+    int i = n;
+    while (iterator->hasNext(iterator)) CHECK(i > 0 && *(int *)iterator->next(iterator) == expected[--i]);
+    CHECK(i == 0);
+    iterator->free(iterator);
+    struct TIterator local = reverseIteratorOf(list);
+    void *batch[5];
+    size_t got;
+    i = n;
+    while ((got = nextBatch(&local, batch, 5)) > 0){
+        for (size_t j = 0; j < got; j++) CHECK(i > 0 && *(int *)batch[j] == expected[--i]);
+    }
+    CHECK(i == 0);
+}
+
+static void testBackend(int flags){
+    static int expected[4096];
+    const int lengths[] = { 0, 1, 2, 63, 64, 65, 1000, 4096 };
+    for (int l = 0; l < 8; l++){
+        List list = newListWithFlags(INT, flags);
+        for (int i = 0; i < lengths[l]; i++) pushInt(list, expected[i] = i * 3 - 7);
+        checkWalks(list, expected, lengths[l]);
+        checkReverse(list, expected, lengths[l]);
+        listDestroy(list);
+        free(list);
+    }
+}
+
+/** @brief After pops, inserts and removes the walks still agree with `get`. */
+static void testAfterEdits(int flags){
+    if (flags & LIST_QUEUE) return;
+    static int expected[4096];
+    List list = newListWithFlags(INT, flags);
+    for (int i = 0; i < 500; i++) pushInt(list, i);
+    for (int i = 0; i < 100; i++) free(listPop(list));
+    for (int i = 0; i < 50; i++) insertInt(list, i * 5, -i);
+    for (int i = 0; i < 50; i++) listRemove(list, i * 3);
+    int n = listLen(list);
+    for (int i = 0; i < n; i++) expected[i] = getInt(list, i);
+    checkWalks(list, expected, n);
+    checkReverse(list, expected, n);
+    listDestroy(list);
+    free(list);
+}
+
+int main(void){
+    for (int f = 0; f < FLAG_SETS; f++){
+        testBackend(flagSets[f]);
+        testAfterEdits(flagSets[f]);
+    }
+    return checkResult();
+}
@@ -0,0 +1,236 @@
+/**
+ * @file test_list.c
+ * @brief Core methods of every storage backend, against a plain array model.
+ */
+
+#include "Tlist.h"
+#include "check.h"
+#include <string.h>
+
+/** Backends and options every test runs on. */
+static const int flagSets[] = {
+    LIST_DEFAULT, LIST_SLAB, LIST_UNROLLED, LIST_VECTOR, LIST_DOUBLY, LIST_SYNC, LIST_SLAB | LIST_DOUBLY,
+};
+#define FLAG_SETS (int)(sizeof(flagSets) / sizeof(flagSets[0]))
+
+/** @brief Integers: push, get, set, insert, remove, pick and pop keep the list equal to `model`. */
+static void testInts(int flags){
+    List list = newListWithFlags(INT, flags);
+    int model[512];
+    int n = 0;
+    for (int i = 0; i < 300; i++){
+        list->methods->push(list, i * 3);
+        model[n++] = i * 3;
+    }
+    CHECK(list->methods->len(list) == n);
+    for (int i = 0; i < n; i += 7){
+        int *value = list->methods->get(list, i);
+        CHECK(value != NULL && *value == model[i]);
+    }
+    list->methods->set(list, 10, -1);
+    model[10] = -1;
+    list->methods->insert(list, 0, 1000);
+    list->methods->insert(list, 150, 1001);
+    list->methods->insert(list, n + 2, 1002);
+    memmove(model + 1, model, (size_t)n++ * sizeof(int));
+    model[0] = 1000;
+    memmove(model + 151, model + 150, (size_t)(n++ - 150) * sizeof(int));
+    model[150] = 1001;
+    model[n++] = 1002;
+    list->methods->remove(list, 42);
+    memmove(model + 42, model + 43, (size_t)(--n - 42) * sizeof(int));
+    int *picked = list->methods->pick(list, 100);
+    CHECK(picked != NULL && *picked == model[100]);
+    free(picked);
+    memmove(model + 100, model + 101, (size_t)(--n - 100) * sizeof(int));
+
+    CHECK(list->methods->len(list) == n);
+    for (int i = 0; i < n; i++){
+        CHECK(getInt(list, i) == model[i]);
+    }
+    CHECK(list->methods->get(list, n) == NULL);
+    for (int i = 0; i < n; i++){
+        int *value = list->methods->pop(list);
+        CHECK(value != NULL && *value == model[i]);
+        free(value);
+    }
+    CHECK(list->methods->pop(list) == NULL);
+    CHECK(list->methods->len(list) == 0);
+    list->methods->free(list);
+    free(list);
+}
+
+/** @brief Strings on both sides of the inline buffer are copied and freed by the list. */
+static void testStrings(int flags){
+    List list = newListWithFlags(STRING, flags);
+    char buffer[64];
+    for (int i = 0; i < 100; i++){
+        snprintf(buffer, sizeof(buffer), i % 2 ? "short %d" : "a string long enough for the heap %d", i);
+        list->methods->push(list, buffer);
+    }
+    buffer[0] = '\0';
+    CHECK(list->methods->len(list) == 100);
+    for (int i = 0; i < 100; i++){
+        snprintf(buffer, sizeof(buffer), i % 2 ? "short %d" : "a string long enough for the heap %d", i);
+        const char *value = getString(list, i);
+        CHECK(value != NULL && strcmp(value, buffer) == 0);
+    }
+    list->methods->set(list, 3, "replaced with a long string value");
+    CHECK(strcmp(getString(list, 3), "replaced with a long string value") == 0);
+    char *first = list->methods->pop(list);
+    CHECK(first != NULL && strcmp(first, "a string long enough for the heap 0") == 0);
+    free(first);
+    list->methods->free(list);
+    free(list);
+}
+
+/** @brief Doubles round-trip through the variadic and typed entry points. */
+static void testDoubles(int flags){
+    List list = newListWithFlags(DOUBLE, flags);
+    for (int i = 0; i < 50; i++) list->methods->push(list, i / 4.0);
+    pushDouble(list, -2.5);
+    CHECK(getDouble(list, 50) == -2.5);
+    for (int i = 0; i < 50; i++) CHECK(getDouble(list, i) == i / 4.0);
+    CHECK(popDouble(list) == 0.0);
+    list->methods->free(list);
+    free(list);
+}
+
+/** @brief A `LIST_SYNC` list freed while its lock is held keeps the lock until the outermost unlock. */
+static void testSyncFree(void){
+    List list = newListWithFlags(INT, LIST_SYNC);
+    list->methods->push(list, 1);
+    CHECK(listLock(list, true));
+    CHECK(listLock(list, true));
+    list->methods->free(list);
+    listUnlock(list);
+    CHECK(list->methods->len(list) == 0);
+    listUnlock(list);
+    free(list);
+}
+
+/**
+ * @brief Baseline bugs: `insert` into an empty list or at the end left `_tail`
+ * stale for the next `push`, and `remove(0)` on an empty list followed `NULL`.
+ */
+static void testTailAndEmpty(int flags){
+    List list = newListWithFlags(INT, flags);
+    list->methods->remove(list, 0);
+    CHECK(list->methods->len(list) == 0);
+    list->methods->insert(list, 0, 1);
+    list->methods->push(list, 3);
+    list->methods->insert(list, 1, 2);
+    list->methods->insert(list, 3, 4);
+    list->methods->push(list, 5);
+    CHECK(list->methods->len(list) == 5);
+    for (int i = 0; i < 5; i++) CHECK(getInt(list, i) == i + 1);
+    while (list->methods->len(list) > 0) list->methods->remove(list, 0);
+    list->methods->remove(list, 0);
+    list->methods->insert(list, 0, 7);
+    list->methods->push(list, 8);
+    CHECK(list->methods->len(list) == 2 && getInt(list, 0) == 7 && getInt(list, 1) == 8);
+    list->methods->free(list);
+    free(list);
+}
+
+/**
+ * @brief Ascending `get` loops, which reuse the cached cursor, interleaved
+ * with inserts and removes before and at the cursor position.
+ */
+static void testCursor(int flags){
+    List list = newListWithFlags(INT, flags);
+    static int model[2048];
+    int n = 0;
+    for (int i = 0; i < 1000; i++) pushInt(list, model[n++] = i);
+    unsigned state = 99;
+    for (int round = 0; round < 40; round++){
+        for (int i = 0; i < n; i++){
+            CHECK(getInt(list, i) == model[i]);
+            state = state * 1103515245u + 12345u;
+            unsigned r = state >> 8;
+            if (r % 16 != 0) continue;
+            int at = (int)(r / 16 % (unsigned)(i + 1));
+            switch (r / 16 / (unsigned)(i + 1) % 5){
+                case 0:
+                    insertInt(list, at, -round);
+                    memmove(model + at + 1, model + at, (size_t)(n++ - at) * sizeof(int));
+                    model[at] = -round;
+                    break;
+                case 1:
+                    pushFront(list, round);
+                    memmove(model + 1, model, (size_t)n++ * sizeof(int));
+                    model[0] = round;
+                    break;
+                case 2:
+                    free(listPick(list, at));
+                    memmove(model + at, model + at + 1, (size_t)(--n - at) * sizeof(int));
+                    break;
+                case 3:
+                    // Only doubly linked lists unlink a node handle; the others remove by index.
+                    if (flags & LIST_DOUBLY) removeNode(list, nodeAt(list, at));
+                    else listRemove(list, at);
+                    memmove(model + at, model + at + 1, (size_t)(--n - at) * sizeof(int));
+                    break;
+                default:
+                    listRemove(list, at);
+                    memmove(model + at, model + at + 1, (size_t)(--n - at) * sizeof(int));
+                    break;
+            }
+            if (i >= n) break;
+            CHECK(getInt(list, i) == model[i]);
+        }
+        for (; n < 900; n++) pushInt(list, model[n] = n);
+    }
+    CHECK(listLen(list) == n);
+#ifdef TLIST_STATS
+    // The ascending loops must have continued from the cursor rather than from the head.
+    if (!(flags & (LIST_SYNC | LIST_UNROLLED | LIST_VECTOR))) {
+        size_t hits, misses;
+        cursorStats(list, &hits, &misses);
+        CHECK(hits > 10 * misses);
+    }
+#endif
+    for (int i = n - 1; i >= 0; i -= 3) CHECK(getInt(list, i) == model[i]);
+    listDestroy(list);
+    free(list);
+}
+
+/** @brief The hash index and sharing give a plain list its `struct ListExtra` on demand; lookups never do. */
+static void testExtraState(void){
+    List list = newList(INT);
+    list->methods->insert(list, 0, 5);
+    CHECK(getInt(list, 0) == 5);
+    size_t hits = 1, misses = 1;
+    cursorStats(list, &hits, &misses);
+#ifdef TLIST_STATS
+    CHECK(hits == 1 && misses == 0);
+#else
+    CHECK(hits == 0 && misses == 0);
+#endif
+    for (int i = 0; i < 20; i++) list->methods->push(list, i);
+    CHECK(indexList(list, NULL, NULL));
+    CHECK(listContains(list, 19) && !listContains(list, 20));
+    List copy = duplicate(list);
+    copy->methods->push(copy, 20);
+    CHECK(listContains(copy, 20) && !listContains(list, 20));
+    copy->methods->free(copy);
+    free(copy);
+    list->methods->free(list);
+    list->methods->push(list, 1);
+    CHECK(getInt(list, 0) == 1);
+    list->methods->free(list);
+    free(list);
+}
+
+int main(void){
+    for (int i = 0; i < FLAG_SETS; i++){
+        testInts(flagSets[i]);
+        testStrings(flagSets[i]);
+        testDoubles(flagSets[i]);
+        testTailAndEmpty(flagSets[i]);
+        testCursor(flagSets[i]);
+    }
+    testSyncFree();
+    testExtraState();
+    return checkResult();
+}
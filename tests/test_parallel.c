@@ -0,0 +1,116 @@
+/**
+ * @file test_parallel.c
+ * @brief `parallelMap` and `parallelForeach` against the same work done serially.
+ */
+
+#include "Tlist.h"
+#include "check.h"
+#include <stdatomic.h>
+#include <string.h>
+
+/** Backends and options every test runs on. */
+static const int flagSets[] = {
+    LIST_DEFAULT, LIST_SLAB, LIST_UNROLLED, LIST_VECTOR, LIST_DOUBLY, LIST_SYNC, LIST_ARENA,
+};
+#define FLAG_SETS (int)(sizeof(flagSets) / sizeof(flagSets[0]))
+
+/** Thread counts to try; 0 means one per online CPU. */
+static const int threadCounts[] = { 1, 2, 3, 8, 0 };
+#define THREAD_COUNTS (int)(sizeof(threadCounts) / sizeof(threadCounts[0]))
+
+static void squareToDouble(void *val, void *out){
+    int x = *(int *)val;
+    *(double *)out = (double)x * x + 0.5;
+}
+
+static void negate(void *val, void *out){
+    *(int *)out = -*(int *)val;
+}
+
+static void describe(void *val, void *out){
+    char *string = malloc(48);
+    snprintf(string, 48, "value %d%s", *(int *)val, *(int *)val % 5 ? "" : " with a longer tail");
+    *(char **)out = string;
+}
+
+static void stringLength(void *val, void *out){
+    *(int *)out = (int)strlen(val);
+}
+
+static atomic_long visitedSum;
+static atomic_int visitedCount;
+
+static void visit(void *val){
+    atomic_fetch_add(&visitedSum, *(int *)val);
+    atomic_fetch_add(&visitedCount, 1);
+}
+
+/** @brief Maps `list` in parallel and checks every result against `function` called in order. */
+static void checkMap(List list, Type type, void (*function)(void *, void *), int nthreads){
+    List mapped = parallelMap(list, type, function, nthreads);
+    CHECK(mapped != NULL);
+    if (mapped == NULL) return;
+    CHECK(listLen(mapped) == listLen(list));
+    // Walked with an iterator: `get` on a `LIST_SYNC` list restarts from the head.
+    TIterator results = newIterator(mapped);
+    TLIST_FOREACH(list, val){
+        unsigned char expected[sizeof(double)];
+        function(val, expected);
+        const void *got = results->hasNext(results) ? results->next(results) : NULL;
+        if (type == STRING) {
+            CHECK(got != NULL && strcmp(got, *(char **)expected) == 0);
+            free(*(char **)expected);
+        } else {
+            size_t size = type == DOUBLE ? sizeof(double) : sizeof(int);
+            CHECK(got != NULL && memcmp(got, expected, size) == 0);
+        }
+    }
+    results->free(results);
+    listDestroy(mapped);
+    free(mapped);
+}
+
+static void testMaps(int flags, int n){
+    List ints = newListWithFlags(INT, flags);
+    for (int i = 0; i < n; i++) pushInt(ints, i * 31 - n);
+    for (int t = 0; t < THREAD_COUNTS; t++){
+        checkMap(ints, DOUBLE, squareToDouble, threadCounts[t]);
+        checkMap(ints, INT, negate, threadCounts[t]);
+        checkMap(ints, STRING, describe, threadCounts[t]);
+
+        atomic_store(&visitedSum, 0);
+        atomic_store(&visitedCount, 0);
+        parallelForeach(ints, visit, threadCounts[t]);
+        long sum = 0;
+        TLIST_FOREACH(ints, val) sum += *(int *)val;
+        CHECK(atomic_load(&visitedCount) == n && atomic_load(&visitedSum) == sum);
+    }
+    List strings = newListWithFlags(STRING, flags);
+    char buffer[64];
+    for (int i = 0; i < n; i++){
+        snprintf(buffer, sizeof buffer, "%*d", 1 + i % 40, i);
+        pushString(strings, buffer);
+    }
+    checkMap(strings, INT, stringLength, 4);
+    List lists[] = { ints, strings };
+    for (int i = 0; i < 2; i++){
+        listDestroy(lists[i]);
+        free(lists[i]);
+    }
+}
+
+int main(void){
+    const int lengths[] = { 0, 1, 7, 1000, 100000 };
+    for (int f = 0; f < FLAG_SETS; f++){
+        for (int l = 0; l < 5; l++) testMaps(flagSets[f], lengths[l]);
+    }
+    parallelShutdown();
+    // The pool starts again after a shutdown.
+    List list = newList(INT);
+    for (int i = 0; i < 5000; i++) pushInt(list, i);
+    checkMap(list, INT, negate, 4);
+    listDestroy(list);
+    free(list);
+    parallelShutdown();
+    return checkResult();
+}
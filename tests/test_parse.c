@@ -0,0 +1,338 @@
+/**
+ * @file test_parse.c
+ * @brief `readInts`, `readDoubles` and `readLines` fed through pipes in slices of every size.
+ *
+ * A writer thread feeds the text a slice at a time, so fields are split
+ * across reads at many points; the largest slices fill the whole input
+ * buffer, so values also straddle its refill boundary. Results are compared
+ * with `strtol`, `strtod` and `strtof` on the same text.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "Tlist.h"
+#include "check.h"
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+/** Slice sizes the writer uses; the last one is larger than the parser's read buffer. */
+static const size_t slices[] = { 1, 7, 4093, 1 << 20 };
+#define SLICES (int)(sizeof(slices) / sizeof(slices[0]))
+
+/** Text written to a pipe by a thread. */
+typedef struct Feed{
+    int fds[2];
+    const char *text;
+    size_t n;
+    size_t slice;
+    pthread_t thread;
+} Feed;
+
+static void *writeSlices(void *argument){
+    Feed *feed = argument;
+    for (size_t done = 0; done < feed->n;){
+        size_t size = feed->n - done < feed->slice ? feed->n - done : feed->slice;
+        ssize_t wrote = write(feed->fds[1], feed->text + done, size);
+        if (wrote <= 0) break;
+        done += (size_t)wrote;
+        // Let the reader catch up so small slices arrive as separate reads.
+        if (feed->slice < 8 && done % 64 == 0) sched_yield();
+    }
+    close(feed->fds[1]);
+    return NULL;
+}
+
+/** @brief Starts feeding `text` in slices of `slice` bytes and returns the end to read from. */
+static int startFeed(Feed *feed, const char *text, size_t slice){
+    CHECK(pipe(feed->fds) == 0);
+    feed->text = text;
+    feed->n = strlen(text);
+    feed->slice = slice;
+    pthread_create(&feed->thread, NULL, writeSlices, feed);
+    return feed->fds[0];
+}
+
+static void endFeed(Feed *feed){
+    // Drain what the reader left after an error, so the writer can finish.
+    char rest[4096];
+    while (read(feed->fds[0], rest, sizeof rest) > 0){}
+    pthread_join(feed->thread, NULL);
+    close(feed->fds[0]);
+}
+
+/** @brief Reads `text` with `readInts` through a pipe and checks the result. */
+static void checkInts(const char *text, char delim, bool ok, const int *expected, int n){
+    for (int s = 0; s < SLICES; s++){
+        Feed feed;
+        List list = newList(INT);
+        CHECK(readInts(list, startFeed(&feed, text, slices[s]), delim) == ok);
+        endFeed(&feed);
+        CHECK(listLen(list) == n);
+        for (int i = 0; i < n && i < listLen(list); i++) CHECK(getInt(list, i) == expected[i]);
+        listDestroy(list);
+        free(list);
+    }
+}
+
+static void testIntFields(void){
+    const int limits[] = { INT_MAX, INT_MIN, 5, 0, 0, 7, 42, -42 };
+    checkInts("2147483647,-2147483648,+5, 0 ,\r\n-0,,7\r\n\n000000000000000000000000042,\t-00042\t\n",
+              ',', true, limits, 8);
+    const int spaced[] = { 1, 2, 3 };
+    checkInts(" 1 \n\n  2\r\n3", '\n', true, spaced, 3);
+    checkInts("1;2;3;", ';', true, spaced, 3);
+    checkInts("", ',', true, NULL, 0);
+    checkInts(",,\n,\r\n", ',', true, NULL, 0);
+    // Reading stops at the first bad field; the values before it stay appended.
+    const int one[] = { 1 };
+    checkInts("1,2147483648,3", ',', false, one, 1);
+    checkInts("1,-2147483649,3", ',', false, one, 1);
+    checkInts("1,+2147483648", ',', false, one, 1);
+    checkInts("1,99999999999999999999", ',', false, one, 1);
+    checkInts("1,18446744073709551617", ',', false, one, 1);
+    checkInts("1,12a", ',', false, one, 1);
+    checkInts("1,-", ',', false, one, 1);
+    checkInts("1,+\n", ',', false, one, 1);
+    checkInts("1,1 2", ',', false, one, 1);
+    checkInts("1,0x10", ',', false, one, 1);
+}
+
+/** @brief Writes `count` integers of every length to `text`; values split across reads at many points. */
+static size_t writeInts(char *text, int *values, int count){
+    size_t n = 0;
+    unsigned state = 3;
+    for (int i = 0; i < count; i++){
+        state = state * 1103515245u + 12345u;
+        int value;
+        switch (i % 5){
+            case 0: value = (int)(state >> 28); break;
+            case 1: value = -(int)(state >> 12); break;
+            case 2: value = i % 10 == 2 ? INT_MIN : (int)state; break;
+            case 3: value = i % 10 == 3 ? INT_MAX : (int)(state >> 1); break;
+            default: value = (int)(state % 1000) - 500; break;
+        }
+        values[i] = value;
+        n += (size_t)sprintf(text + n, "%d%s", value, i % 7 == 6 ? "\r\n" : i % 3 ? "," : " , ");
+    }
+    return n;
+}
+
+static void testIntStream(void){
+    enum { COUNT = 60000 };
+    char *text = malloc((size_t)COUNT * 16);
+    int *values = malloc(COUNT * sizeof(int));
+    writeInts(text, values, COUNT);
+    checkInts(text, ',', true, values, COUNT);
+    free(text);
+    free(values);
+}
+
+/**
+ * @brief Reads `text` with `readDoubles` into a `DOUBLE` list and, if
+ *        `floats`, a `FLOAT` list, and checks each field against `strtod` and `strtof`.
+ */
+static void checkNumbers(const char *text, char delim, size_t slice, bool floats){
+    char *copy = strdup(text);
+    List doubles = newList(DOUBLE);
+    List floatList = newList(FLOAT);
+    Feed feed;
+    CHECK(readDoubles(doubles, startFeed(&feed, text, slice), delim));
+    endFeed(&feed);
+    if (floats) {
+        CHECK(readDoubles(floatList, startFeed(&feed, text, slice), delim));
+        endFeed(&feed);
+    }
+    int i = 0;
+    char separators[] = { delim, '\n', '\0' };
+    for (char *state, *field = strtok_r(copy, separators, &state); field != NULL; field = strtok_r(NULL, separators, &state)){
+        while (*field == ' ' || *field == '\t') field++;
+        if (*field == '\0' || *field == '\r') continue;
+        if (i < listLen(doubles)) {
+            double d = strtod(field, NULL);
+            double got = getDouble(doubles, i);
+            CHECK(memcmp(&got, &d, sizeof d) == 0 || (isnan(got) && isnan(d)));
+            if (memcmp(&got, &d, sizeof d) != 0 && !isnan(d)) fprintf(stderr, "double \"%s\": %.17g, expected %.17g\n", field, got, d);
+        }
+        if (i < listLen(floatList)) {
+            float f = strtof(field, NULL);
+            float got = getFloat(floatList, i);
+            CHECK(memcmp(&got, &f, sizeof f) == 0 || (isnan(got) && isnan(f)));
+            if (memcmp(&got, &f, sizeof f) != 0 && !isnan(f)) fprintf(stderr, "float \"%s\": %.9g, expected %.9g\n", field, got, f);
+        }
+        i++;
+    }
+    CHECK(listLen(doubles) == i && listLen(floatList) == (floats ? i : 0));
+    listDestroy(doubles);
+    free(doubles);
+    listDestroy(floatList);
+    free(floatList);
+    free(copy);
+}
+
+static void testNumberFields(void){
+    // Ties round to even: 2^53 + 1 and 2^53 + 3 lie halfway between two doubles.
+    const char *ties = "9007199254740993,9007199254740995,-9007199254740993,"
+                       "1.00000005960464477539062500,1.000000178813934326171875,"
+                       "16777217,16777219,33554434e0\n";
+    // Just above the float midpoints: rounding to a double first would land on the midpoint.
+    const char *nearTies = "1.000000059604644776,1.0000000596046448,1.00000005960464478,"
+                           "1.000000178813934325,16777217.000000001,16777217.00000001\n";
+    // Subnormals, the smallest normals, and values that underflow to zero.
+    const char *tiny = "4.9e-324,2.4703282292062328e-324,2.4703282292062327e-324,"
+                       "2.2250738585072011e-308,2.2250738585072014e-308,1e-400,"
+                       "1.4e-45,1e-45,7.1e-46,7e-46,1.1754942e-38,1.17549435e-38\n";
+    const char *mixed = " 0.1 , -0.0 ,3.4028234e38,\r\n.5,5.,+.25e+1,1E-5,0x1p-3,inf,-INF,nan,,\n"
+                        "12345678901234567890123456789,0.000000000000000000000000000001234\n";
+    // Only doubles hold these.
+    const char *large = "1e308,1.7976931348623157e308,-3.5e38,1e39,123456789012345678901234567890123456789012345\n";
+    const char *fields[] = { ties, nearTies, tiny, mixed, large };
+    for (int f = 0; f < 5; f++){
+        for (int s = 0; s < SLICES; s++) checkNumbers(fields[f], ',', slices[s], fields[f] != large);
+    }
+    const double expected[] = { 9007199254740992.0, 9007199254740996.0, -9007199254740992.0 };
+    List list = newList(DOUBLE);
+    Feed feed;
+    CHECK(readDoubles(list, startFeed(&feed, ties, 1), ','));
+    endFeed(&feed);
+    for (int i = 0; i < 3; i++) CHECK(getDouble(list, i) == expected[i]);
+    listDestroy(list);
+    free(list);
+    list = newList(FLOAT);
+    CHECK(readDoubles(list, startFeed(&feed, nearTies, 1 << 20), ','));
+    endFeed(&feed);
+    CHECK(getFloat(list, 0) == 1.0f + FLT_EPSILON);
+    listDestroy(list);
+    free(list);
+    list = newList(DOUBLE);
+    CHECK(readDoubles(list, startFeed(&feed, "4.9e-324", 3), ','));
+    endFeed(&feed);
+    CHECK(listLen(list) == 1 && getDouble(list, 0) == DBL_TRUE_MIN);
+    listDestroy(list);
+    free(list);
+
+    // Out-of-range and malformed fields stop the reading.
+    const char *bad[] = { "1,1e400", "1,-1e400", "1,1.5.2", "1,e5", "1,1e", "1,--1", "1,1 2" };
+    for (int b = 0; b < 7; b++){
+        list = newList(DOUBLE);
+        CHECK(!readDoubles(list, startFeed(&feed, bad[b], 2), ','));
+        endFeed(&feed);
+        CHECK(listLen(list) == 1 && getDouble(list, 0) == 1.0);
+        listDestroy(list);
+        free(list);
+    }
+    list = newList(FLOAT);
+    CHECK(!readDoubles(list, startFeed(&feed, "1\n3.5e38\n", 1 << 20), ','));
+    endFeed(&feed);
+    CHECK(listLen(list) == 1);
+    listDestroy(list);
+    free(list);
+}
+
+/** @brief Random decimals of 1 to 20 significant digits, many of them in the parser's fast path. */
+static void testNumberStream(void){
+    enum { COUNT = 40000 };
+    char *text = malloc((size_t)COUNT * 40);
+    size_t n = 0;
+    unsigned long long state = 7;
+    for (int i = 0; i < COUNT; i++){
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        int digits = 1 + (int)(state >> 59) % 20;
+        unsigned long long mantissa = (state >> 3) % 10000000000000000000ull;
+        char buffer[32];
+        int length = snprintf(buffer, sizeof buffer, "%020llu", mantissa);
+        int point = (int)(state >> 40) % (digits + 1);
+        const char *start = buffer + length - digits;
+        // At most 20 digits and an exponent of 18 stay below FLT_MAX.
+        int exponent = (int)(state >> 48) % 49 - 30;
+        n += (size_t)sprintf(text + n, "%s%.*s.%se%d%s", state >> 62 ? "" : "-", point, start, start + point,
+                             i % 4 ? exponent : exponent / 10, i % 5 ? "," : "\n");
+    }
+    text[n] = '\0';
+    for (int s = 0; s < SLICES; s++) checkNumbers(text, ',', slices[s], true);
+    free(text);
+}
+
+/** @brief Reads `text` with `readLines` through a pipe and checks each line. */
+static void checkLines(const char *text, const char *const *expected, int n){
+    for (int s = 0; s < SLICES; s++){
+        Feed feed;
+        List list = newListWithFlags(STRING, s % 2 ? LIST_ARENA : LIST_DEFAULT);
+        CHECK(readLines(list, startFeed(&feed, text, slices[s])));
+        endFeed(&feed);
+        CHECK(listLen(list) == n);
+        for (int i = 0; i < n && i < listLen(list); i++) CHECK(strcmp(getString(list, i), expected[i]) == 0);
+        listDestroy(list);
+        free(list);
+    }
+}
+
+static void testLines(void){
+    const char *crlf[] = { "a", "b", "", "", "last" };
+    checkLines("a\r\nb\n\n\r\nlast", crlf, 5);
+    const char *inner[] = { "x\ry", " spaced ", "\t", "end\r" };
+    checkLines("x\ry\n spaced \r\n\t\nend\r\r\n", inner, 4);
+    checkLines("", NULL, 0);
+    const char *empty[] = { "" };
+    checkLines("\n", empty, 1);
+    checkLines("\r\n", empty, 1);
+
+    // Lines longer than the read buffer, and many short ones around them.
+    enum { LONG = 200000, SHORT = 30000 };
+    char *text = malloc(2 * LONG + SHORT * 12 + 16);
+    char **lines = malloc((SHORT + 2) * sizeof(char *));
+    size_t n = 0;
+    int count = 0;
+    for (int i = 0; i < SHORT + 2; i++){
+        lines[count] = text + n;
+        if (i == 10 || i == SHORT / 2) {
+            for (int k = 0; k < LONG; k++) text[n++] = (char)('a' + k % 26);
+        } else {
+            n += (size_t)sprintf(text + n, "line %d", i);
+        }
+        count++;
+        text[n++] = i % 3 ? '\n' : '\r';
+        if (i % 3 == 0) text[n++] = '\n';
+    }
+    text[n] = '\0';
+    char *copy = malloc(n + 1);
+    memcpy(copy, text, n + 1);
+    // The expected lines are the text with each terminator cut off.
+    for (int i = 0; i < count; i++){
+        char *line = copy + (lines[i] - text);
+        line[strcspn(line, "\r\n")] = '\0';
+        lines[i] = line;
+    }
+    checkLines(text, (const char *const *)lines, count);
+    free(lines);
+    free(copy);
+    free(text);
+}
+
+/** @brief `readInts` and `readDoubles` report a field that does not fit, even when a refill splits it. */
+static void testSplitErrors(void){
+    // The bad value straddles the first refill whatever the pipe delivers at once.
+    enum { PAD = (1 << 16) - 3 };
+    char *text = malloc(PAD + 64);
+    memset(text, ' ', PAD);
+    strcpy(text + PAD, "1,2147483648,5");
+    const int one[] = { 1 };
+    checkInts(text, ',', false, one, 1);
+    strcpy(text + PAD, "2147483647,5");
+    const int fits[] = { INT_MAX, 5 };
+    checkInts(text, ',', true, fits, 2);
+    free(text);
+}
+
+int main(void){
+    testIntFields();
+    testIntStream();
+    testNumberFields();
+    testNumberStream();
+    testLines();
+    testSplitErrors();
+    return checkResult();
+}
@@ -0,0 +1,119 @@
+/**
+ * @file test_queue.c
+ * @brief Multi-producer, multi-consumer stress of `LIST_QUEUE` lists.
+ *
+ * Every pushed value must be popped exactly once. Each round starts a new
+ * set of threads, so hazard records are registered while other threads scan
+ * them. Configure with `-DCMAKE_C_FLAGS=-fsanitize=thread` to run it under
+ * ThreadSanitizer.
+ */
+
+#include "Tlist.h"
+#include "check.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <string.h>
+
+/** Values each producer pushes per round. */
+#define PER_PRODUCER 20000
+
+/** Largest number of producers (and of consumers) in a round. */
+#define MAX_THREADS 4
+
+/**
+ * @struct Round
+ * @brief State the producers and consumers of one round share.
+ */
+typedef struct Round{
+    List _list;
+    int _producers;
+    atomic_int _nextProducer;       /**< Hands each producer its own range of values. */
+    atomic_long _remaining;         /**< Values still to be popped. */
+    atomic_uchar *_seen;            /**< How often each value was popped. */
+} Round;
+
+static void *produce(void *argument){
+    Round *r = argument;
+    int base = atomic_fetch_add(&r->_nextProducer, 1) * PER_PRODUCER;
+    for (int i = 0; i < PER_PRODUCER; i += 2){
+        r->_list->methods->push(r->_list, base + i);
+        int pair[2] = { base + i + 1, 0 };
+        pushArray(r->_list, pair, 1);
+    }
+    return NULL;
+}
+
+static void *consume(void *argument){
+    Round *r = argument;
+    int value;
+    while (atomic_load(&r->_remaining) > 0){
+        if (popInto(r->_list, &value)){
+            if (value >= 0 && value < r->_producers * PER_PRODUCER) atomic_fetch_add(&r->_seen[value], 1);
+            atomic_fetch_sub(&r->_remaining, 1);
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/** @brief Runs `producers` producers and `consumers` consumers on a fresh queue. */
+static void testRound(int producers, int consumers){
+    long total = (long)producers * PER_PRODUCER;
+    Round r = { ._list = newListWithFlags(INT, LIST_QUEUE), ._producers = producers };
+    atomic_init(&r._nextProducer, 0);
+    atomic_init(&r._remaining, total);
+    r._seen = calloc((size_t)total, sizeof(atomic_uchar));
+    pthread_t threads[2 * MAX_THREADS];
+    for (int i = 0; i < consumers; i++) pthread_create(&threads[i], NULL, consume, &r);
+    for (int i = 0; i < producers; i++) pthread_create(&threads[consumers + i], NULL, produce, &r);
+    for (int i = 0; i < producers + consumers; i++) pthread_join(threads[i], NULL);
+
+    long wrong = 0;
+    for (long i = 0; i < total; i++) wrong += atomic_load(&r._seen[i]) != 1;
+    CHECK(wrong == 0);
+    CHECK(r._list->methods->len(r._list) == 0);
+    CHECK(r._list->methods->pop(r._list) == NULL);
+    free(r._seen);
+    r._list->methods->free(r._list);
+    free(r._list);
+}
+
+/** Strings popped by `churnStrings` that were not pushed; `CHECK` itself is not thread-safe. */
+static atomic_int corruptStrings;
+
+/** @brief Strings are copied on push and handed to the consumer on pop, from any thread. */
+static void *churnStrings(void *argument){
+    List list = argument;
+    char buffer[48];
+    for (int i = 0; i < 5000; i++){
+        snprintf(buffer, sizeof(buffer), "a string long enough for the heap %d", i);
+        list->methods->push(list, buffer);
+        char *value = list->methods->pop(list);
+        if (value != NULL && strncmp(value, "a string long enough", 20) != 0) atomic_fetch_add(&corruptStrings, 1);
+        free(value);
+    }
+    return NULL;
+}
+
+static void testStrings(void){
+    List list = newListWithFlags(STRING, LIST_QUEUE);
+    pthread_t threads[MAX_THREADS];
+    for (int i = 0; i < MAX_THREADS; i++) pthread_create(&threads[i], NULL, churnStrings, list);
+    for (int i = 0; i < MAX_THREADS; i++) pthread_join(threads[i], NULL);
+    CHECK(atomic_load(&corruptStrings) == 0);
+    CHECK(list->methods->len(list) == 0);
+    list->methods->free(list);
+    free(list);
+}
+
+int main(void){
+    for (int producers = 1; producers <= MAX_THREADS; producers++){
+        for (int consumers = 1; consumers <= MAX_THREADS; consumers *= 2){
+            testRound(producers, consumers);
+        }
+    }
+    testStrings();
+    return checkResult();
+}
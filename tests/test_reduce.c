@@ -0,0 +1,125 @@
+/**
+ * @file test_reduce.c
+ * @brief Reductions and searches under every kernel set, against plain loops.
+ *
+ * Lengths run past several vector widths and past the staging buffer of
+ * linked lists, so both the vector bodies and the scalar tails are covered.
+ */
+
+#include "Tlist.h"
+#include "TlistPrivate.h"
+#include "check.h"
+#include <limits.h>
+#include <math.h>
+
+static const char *const levels[] = { "scalar", "sse2", "avx2" };
+static const int backends[] = { LIST_DEFAULT, LIST_UNROLLED, LIST_VECTOR };
+static const size_t extraLengths[] = { 255, 256, 257, 1023, 1025, 4099 };
+
+#define COUNT(array) (sizeof(array) / sizeof(array[0]))
+#define MAX_LENGTH 4099
+
+/** @brief A value that repeats every 101 elements, exactly representable as `float`. */
+static double valueAt(size_t i){
+    return (double)((long)(i * 37 % 101) - 50) / 4.0;
+}
+
+/** @brief `INT` lists, with `INT_MAX` every 13 elements so that 32-bit sums would overflow. */
+static void testInts(int flags, size_t n){
+    static int v[MAX_LENGTH];
+    List list = newListWithFlags(INT, flags);
+    for (size_t i = 0; i < n; i++) v[i] = i % 13 == 12 ? INT_MAX : (int)(valueAt(i) * 4);
+    if (n > 0) v[n - 1] = 7777;
+    pushArray(list, v, n);
+
+    long long sum = 0;
+    int min = n > 0 ? v[0] : 0, max = min;
+    for (size_t i = 0; i < n; i++){
+        sum += v[i];
+        if (v[i] < min) min = v[i];
+        if (v[i] > max) max = v[i];
+    }
+    CHECK(listSum(list) == (double)sum);
+    CHECK(listMean(list) == (n > 0 ? (double)sum / (double)n : 0));
+    CHECK(listMin(list) == min);
+    CHECK(listMax(list) == max);
+
+    int needles[] = { n > 0 ? v[n / 2] : 0, 7777, INT_MAX, 123456 };
+    for (size_t k = 0; k < COUNT(needles); k++){
+        int first = -1, count = 0;
+        for (size_t i = 0; i < n; i++){
+            if (v[i] == needles[k] && count++ == 0) first = (int)i;
+        }
+        CHECK(listIndexOf(list, needles[k]) == first);
+        CHECK(listCountOf(list, needles[k]) == count);
+    }
+    list->methods->free(list);
+    free(list);
+}
+
+/** @brief `FLOAT` and `DOUBLE` lists; `nan` puts a NaN in the middle of the list. */
+static void testReals(Type type, int flags, size_t n, bool nan){
+    static double v[MAX_LENGTH];
+    static float f[MAX_LENGTH];
+    List list = newListWithFlags(type, flags);
+    for (size_t i = 0; i < n; i++) v[i] = valueAt(i);
+    if (n > 0) v[n - 1] = 99.5;
+    if (nan && n > 0) v[n / 2] = NAN;
+    for (size_t i = 0; i < n; i++) f[i] = (float)v[i];
+    if (type == FLOAT) pushArray(list, f, n);
+    else pushArray(list, v, n);
+
+    double sum = 0, min = n > 0 ? v[0] : 0, max = min;
+    for (size_t i = 0; i < n; i++){
+        sum += v[i];
+        if (v[i] < min) min = v[i];
+        if (v[i] > max) max = v[i];
+    }
+    if (nan && n > 0) {
+        CHECK(isnan(listSum(list)));
+        CHECK(isnan(listMean(list)));
+    } else {
+        // Quarters of small integers add up exactly in any order.
+        CHECK(listSum(list) == sum);
+        CHECK(listMean(list) == (n > 0 ? sum / (double)n : 0));
+        CHECK(listMin(list) == min);
+        CHECK(listMax(list) == max);
+    }
+
+    double needles[] = { n > 0 ? v[n / 3] : 0, 99.5, 1000.25, NAN };
+    for (size_t k = 0; k < COUNT(needles); k++){
+        int first = -1, count = 0;
+        for (size_t i = 0; i < n; i++){
+            if (v[i] == needles[k] && count++ == 0) first = (int)i;
+        }
+        CHECK(listIndexOf(list, needles[k]) == first);
+        CHECK(listCountOf(list, needles[k]) == count);
+    }
+    list->methods->free(list);
+    free(list);
+}
+
+static void testLength(int flags, size_t n){
+    testInts(flags, n);
+    testReals(FLOAT, flags, n, false);
+    testReals(DOUBLE, flags, n, false);
+    testReals(FLOAT, flags, n, true);
+    testReals(DOUBLE, flags, n, true);
+}
+
+int main(void){
+    for (size_t l = 0; l < COUNT(levels); l++){
+        if (!forceSimdLevel(levels[l])) {
+            printf("%s kernels not available, skipped\n", levels[l]);
+            continue;
+        }
+        CHECK(strcmp(simdLevel(), levels[l]) == 0);
+        for (size_t b = 0; b < COUNT(backends); b++){
+            for (size_t n = 0; n <= 67; n++) testLength(backends[b], n);
+            for (size_t k = 0; k < COUNT(extraLengths); k++) testLength(backends[b], extraLengths[k]);
+        }
+    }
+    CHECK(forceSimdLevel(NULL));
+    CHECK(!forceSimdLevel("mmx"));
+    return checkResult();
+}
@@ -0,0 +1,351 @@
+/**
+ * @file test_search.c
+ * @brief `listIndexOf`, `listCountOf`, `listContains`, `removeValue` and `removeAll`
+ *        against an array model, on every backend, with and without a hash index.
+ */
+
+#include "Tlist.h"
+#include "check.h"
+#include <math.h>
+#include <string.h>
+
+/** Backends and options every test runs on. */
+static const int flagSets[] = {
+    LIST_DEFAULT, LIST_SLAB, LIST_DOUBLY, LIST_SLAB | LIST_DOUBLY, LIST_UNROLLED, LIST_VECTOR,
+    LIST_SYNC, LIST_SYNC | LIST_DOUBLY, LIST_SYNC | LIST_VECTOR,
+};
+#define FLAG_SETS (int)(sizeof(flagSets) / sizeof(flagSets[0]))
+
+/** Values are numbered: the model holds numbers, the list the values they stand for. */
+#define VALUES 30
+/** Numbers from `VALUES` on are never stored. */
+#define QUERIES (VALUES + 4)
+#define MAX_MODEL 1024
+
+/** @brief The `DOUBLE` value of number `code`: 1 is -0.0, which equals 0's 0.0, and 2 is NaN, which equals nothing. */
+static double doubleOf(int code){
+    if (code == 1) return -0.0;
+    if (code == 2) return NAN;
+    return code * 0.5;
+}
+
+/** @brief The `STRING` value of number `code`, sometimes long enough for the heap. */
+static const char *stringOf(int code){
+    static char strings[QUERIES][64];
+    if (strings[code][0] == '\0') {
+        snprintf(strings[code], sizeof strings[code], "value %d%s", code, code % 3 ? "" : " with a longer tail");
+    }
+    return strings[code];
+}
+
+/** @brief Whether the values numbered `a` and `b` are equal for the list's type. */
+static bool equal(Type type, int a, int b){
+    return type == DOUBLE ? doubleOf(a) == doubleOf(b) : a == b;
+}
+
+/* The value of a number, passed as each variadic function takes it. */
+#define WITH_VALUE(type, code, call) \
+    ((type) == INT ? call(code) : (type) == DOUBLE ? call(doubleOf(code)) : call(stringOf(code)))
+
+static void pushCode(List list, int code){
+    if (list->_type == INT) pushInt(list, code);
+    else if (list->_type == DOUBLE) pushDouble(list, doubleOf(code));
+    else pushString(list, stringOf(code));
+}
+
+static void insertCode(List list, int index, int code){
+    if (list->_type == INT) insertInt(list, index, code);
+    else if (list->_type == DOUBLE) insertDouble(list, index, doubleOf(code));
+    else insertString(list, index, stringOf(code));
+}
+
+static void setCode(List list, int index, int code){
+    if (list->_type == INT) setInt(list, index, code);
+    else if (list->_type == DOUBLE) setDouble(list, index, doubleOf(code));
+    else setString(list, index, stringOf(code));
+}
+
+/** @brief Whether `val`, as returned by `get`, is the value of number `code`, bit for bit. */
+static bool holds(Type type, const void *val, int code){
+    if (type == INT) return *(const int *)val == code;
+    if (type == DOUBLE) {
+        double expected = doubleOf(code);
+        return memcmp(val, &expected, sizeof expected) == 0;
+    }
+    return strcmp(val, stringOf(code)) == 0;
+}
+
+/** A list with the numbers of the values it must hold. */
+typedef struct Modelled{
+    List list;
+    int codes[MAX_MODEL];
+    int n;
+} Modelled;
+
+/** @brief Checks the elements of `m->list`, then every query for every number. */
+static void checkModel(const Modelled *m){
+    List list = m->list;
+    Type type = list->_type;
+    CHECK(listLen(list) == m->n);
+    int i = 0;
+    TLIST_FOREACH(list, val){
+        if (i < m->n) CHECK(holds(type, val, m->codes[i]));
+        i++;
+    }
+    CHECK(i == m->n);
+    for (int code = 0; code < QUERIES; code++){
+        int first = -1, count = 0;
+        for (int k = 0; k < m->n; k++){
+            if (!equal(type, m->codes[k], code)) continue;
+            if (first < 0) first = k;
+            count++;
+        }
+#define INDEX_OF(value) listIndexOf(list, value)
+#define COUNT_OF(value) listCountOf(list, value)
+#define CONTAINS(value) listContains(list, value)
+        CHECK(WITH_VALUE(type, code, INDEX_OF) == first);
+        CHECK(WITH_VALUE(type, code, COUNT_OF) == count);
+        CHECK(WITH_VALUE(type, code, CONTAINS) == (count > 0));
+    }
+}
+
+/** @brief `removeValue` of number `code` on the list and on the model. */
+static void removeFirst(Modelled *m, int code){
+    Type type = m->list->_type;
+    List list = m->list;
+    int k = 0;
+    while (k < m->n && !equal(type, m->codes[k], code)) k++;
+#define REMOVE_VALUE(value) removeValue(list, value)
+    CHECK(WITH_VALUE(type, code, REMOVE_VALUE) == (k < m->n));
+    if (k < m->n) memmove(m->codes + k, m->codes + k + 1, (size_t)(--m->n - k) * sizeof(int));
+}
+
+/** @brief `removeAll` of number `code` on the list and on the model. */
+static void removeEvery(Modelled *m, int code){
+    Type type = m->list->_type;
+    List list = m->list;
+    int kept = 0;
+    for (int k = 0; k < m->n; k++){
+        if (!equal(type, m->codes[k], code)) m->codes[kept++] = m->codes[k];
+    }
+#define REMOVE_ALL(value) removeAll(list, value)
+    CHECK(WITH_VALUE(type, code, REMOVE_ALL) == m->n - kept);
+    m->n = kept;
+}
+
+/** @brief Applies one random modification to `m` and its model. */
+static void modify(Modelled *m, unsigned r){
+    List list = m->list;
+    int code = (int)(r >> 20) % VALUES;
+    // Half of the operations add an element, so the list grows until the model is full.
+    int op = m->n == 0 ? 0 : (int)(r % 16);
+    if (m->n >= MAX_MODEL - 1) op = 4;
+    int index = m->n == 0 ? 0 : (int)(r / 16 % (unsigned)m->n);
+    switch (op){
+        case 2:
+            insertCode(list, index, code);
+            memmove(m->codes + index + 1, m->codes + index, (size_t)(m->n++ - index) * sizeof(int));
+            m->codes[index] = code;
+            break;
+        case 3:
+            setCode(list, index, code);
+            m->codes[index] = code;
+            break;
+        case 4:
+            listRemove(list, index);
+            memmove(m->codes + index, m->codes + index + 1, (size_t)(--m->n - index) * sizeof(int));
+            break;
+        case 5:
+            free(listPop(list));
+            memmove(m->codes, m->codes + 1, (size_t)--m->n * sizeof(int));
+            break;
+        case 6:
+            free(popBack(list));
+            m->n--;
+            break;
+        case 7:
+            free(listPick(list, index));
+            memmove(m->codes + index, m->codes + index + 1, (size_t)(--m->n - index) * sizeof(int));
+            break;
+        case 8:
+            removeFirst(m, code);
+            break;
+        case 9:
+            // Every fourth time only, so that the list keeps growing.
+            if (r / 16 % 4 == 0) removeEvery(m, code);
+            else removeFirst(m, m->codes[index]);
+            break;
+        default:
+            pushCode(list, code);
+            m->codes[m->n++] = code;
+            break;
+    }
+}
+
+/** @brief Random edits and removals by value, checked against the model; linked lists are indexed if `indexed`. */
+static void testBackend(Type type, int flags, bool indexed){
+    bool linked = !(flags & (LIST_UNROLLED | LIST_VECTOR));
+    if (indexed && !linked) {
+        // Only linked lists take an index.
+        List list = newListWithFlags(type, flags);
+        CHECK(!indexList(list, NULL, NULL));
+        listDestroy(list);
+        free(list);
+        return;
+    }
+    static Modelled m;
+    m.list = newListWithFlags(type, flags);
+    m.n = 0;
+    unsigned state = (unsigned)(flags * 7 + type * 3 + indexed);
+    for (int step = 0; step < 2500; step++){
+        state = state * 1103515245u + 12345u;
+        modify(&m, state >> 2);
+        // The index is built over a list that already holds values, then dropped and built again.
+        if (indexed && step == 100) CHECK(indexList(m.list, NULL, NULL));
+        if (indexed && step == 1500) dropIndex(m.list);
+        if (indexed && step == 1700) CHECK(indexList(m.list, NULL, NULL));
+        if (step % 100 == 0) checkModel(&m);
+    }
+    checkModel(&m);
+    CHECK(m.n > 200);
+    // Empty the list value by value.
+    for (int code = 0; code < VALUES; code++) removeEvery(&m, code);
+    // Only NaNs, which equal nothing, are left.
+    for (int k = 0; k < m.n; k++) CHECK(type == DOUBLE && m.codes[k] == 2);
+    checkModel(&m);
+    listDestroy(m.list);
+    free(m.list);
+}
+
+/** Hash that sends every value to the last three slots of the table, so probe sequences wrap around. */
+static size_t clusteredHash(const void *value){
+    return (size_t)0 - 1 - (size_t)(*(const int *)value % 3);
+}
+
+static bool sameInt(const void *a, const void *b){
+    return *(const int *)a == *(const int *)b;
+}
+
+/**
+ * @brief Long, wrapping probe sequences: every deletion shifts entries back
+ * across the end of the table, and the entries left must still be found.
+ */
+static void testBackwardShift(int flags){
+    static Modelled m;
+    m.list = newListWithFlags(INT, flags);
+    m.n = 0;
+    for (int i = 0; i < 400; i++){
+        pushInt(m.list, i % VALUES);
+        m.codes[m.n++] = i % VALUES;
+    }
+    CHECK(indexList(m.list, clusteredHash, sameInt));
+    unsigned state = 99;
+    for (int step = 0; step < 600; step++){
+        state = state * 1103515245u + 12345u;
+        modify(&m, state >> 2);
+        if (step % 50 == 0) checkModel(&m);
+    }
+    checkModel(&m);
+    // Delete from the middle of the clusters first, then the rest.
+    for (int code = 1; code < VALUES; code += 2) removeEvery(&m, code);
+    checkModel(&m);
+    for (int code = 0; code < VALUES; code += 2) removeEvery(&m, code);
+    checkModel(&m);
+    listDestroy(m.list);
+    free(m.list);
+}
+
+/** @brief The index follows a list through copy-on-write: it is rebuilt when the list copies, and kept when it takes the storage over. */
+static void testUnshare(int flags){
+    static Modelled m, copy;
+    m.list = newListWithFlags(INT, flags);
+    m.n = 0;
+    for (int i = 0; i < 300; i++){
+        pushInt(m.list, i % VALUES);
+        m.codes[m.n++] = i % VALUES;
+    }
+    CHECK(indexList(m.list, NULL, NULL));
+    unsigned state = 5;
+    for (int round = 0; round < 3; round++){
+        copy.list = round == 1 ? snapshot(m.list) : duplicate(m.list);
+        copy.n = m.n;
+        memcpy(copy.codes, m.codes, (size_t)m.n * sizeof(int));
+        checkModel(&m);
+        checkModel(&copy);
+        // Round 0: the indexed list writes first and copies the storage.
+        // Round 1: the copy writes first, and the indexed list takes the storage over.
+        // Round 2: the copy goes unwritten, and the indexed list takes the storage over.
+        Modelled *first = round == 0 ? &m : &copy;
+        Modelled *second = round == 0 ? &copy : &m;
+        if (round < 2) {
+            for (int step = 0; step < 50; step++){
+                state = state * 1103515245u + 12345u;
+                modify(first, state >> 2);
+            }
+            checkModel(&m);
+            checkModel(&copy);
+        }
+        for (int step = 0; step < 50; step++){
+            state = state * 1103515245u + 12345u;
+            modify(second, state >> 2);
+        }
+        checkModel(&m);
+        checkModel(&copy);
+        listDestroy(copy.list);
+        free(copy.list);
+        removeEvery(&m, 3);
+        checkModel(&m);
+    }
+    listDestroy(m.list);
+    free(m.list);
+}
+
+/** A `T` element, equal to another with the same `key`. */
+struct Record { int key; int payload; };
+
+static size_t hashRecord(const void *value){
+    return (size_t)((const struct Record *)value)->key * 2654435761u;
+}
+
+static bool sameRecord(const void *a, const void *b){
+    return ((const struct Record *)a)->key == ((const struct Record *)b)->key;
+}
+
+/** @brief `T` lists compare pointers, unless an index supplies an equality. */
+static void testRecords(int flags){
+    List list = newListWithFlags(T, flags);
+    static struct Record records[200];
+    for (int i = 0; i < 200; i++){
+        records[i] = (struct Record){ i % 20, i };
+        pushPtr(list, &records[i]);
+    }
+    struct Record probe = { 7, -1 };
+    CHECK(listIndexOf(list, &records[27]) == 27 && listCountOf(list, &records[27]) == 1);
+    CHECK(!listContains(list, &probe) && listIndexOf(list, &probe) == -1);
+    CHECK(!indexList(list, NULL, NULL));
+    if (!(flags & (LIST_UNROLLED | LIST_VECTOR))) {
+        CHECK(indexList(list, hashRecord, sameRecord));
+        CHECK(listIndexOf(list, &probe) == 7 && listCountOf(list, &probe) == 10);
+        CHECK(removeValue(list, &probe) && listIndexOf(list, &probe) == 26);
+        CHECK(removeAll(list, &probe) == 9 && !listContains(list, &probe));
+        CHECK(listLen(list) == 190);
+    }
+    listDestroy(list);
+    free(list);
+}
+
+int main(void){
+    const Type types[] = { INT, DOUBLE, STRING };
+    for (int f = 0; f < FLAG_SETS; f++){
+        for (int t = 0; t < 3; t++){
+            testBackend(types[t], flagSets[f], false);
+            testBackend(types[t], flagSets[f], true);
+        }
+        testRecords(flagSets[f]);
+        if (!(flagSets[f] & (LIST_UNROLLED | LIST_VECTOR))) {
+            testBackwardShift(flagSets[f]);
+            testUnshare(flagSets[f]);
+        }
+    }
+    return checkResult();
+}
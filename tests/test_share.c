@@ -0,0 +1,398 @@
+/**
+ * @file test_share.c
+ * @brief Copy-on-write views made by `duplicate`, `snapshot` and `mmapList`.
+ *
+ * Every list viewing shared storage must read as an independent copy: writes
+ * through one view leave the others as they were, the last view left takes
+ * the storage over without copying it, and the storage outlives whichever
+ * list happens to be freed first.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "Tlist.h"
+#include "check.h"
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+/** Backends and options every test runs on. */
+static const int flagSets[] = {
+    LIST_DEFAULT, LIST_SLAB, LIST_UNROLLED, LIST_VECTOR, LIST_DOUBLY, LIST_SLAB | LIST_DOUBLY,
+    LIST_SYNC, LIST_SYNC | LIST_VECTOR, LIST_SYNC | LIST_UNROLLED,
+};
+#define FLAG_SETS (int)(sizeof(flagSets) / sizeof(flagSets[0]))
+
+#define MAX_MODEL 1024
+
+/** A list with the array it must stay equal to. */
+typedef struct Modelled{
+    List list;
+    int values[MAX_MODEL];
+    int n;
+} Modelled;
+
+/** @brief Reads element `i` of an `INT` or `STRING` list as a number. */
+static int valueAt(List list, int i){
+    return list->_type == STRING ? atoi(listGet(list, i)) : getInt(list, i);
+}
+
+/** @brief Checks `m->list` against its model with an iterator and with indexed reads. */
+static void checkModel(const Modelled *m){
+    List list = m->list;
+    CHECK(listLen(list) == m->n);
+    int i = 0;
+    TLIST_FOREACH(list, val){
+        int value = list->_type == STRING ? atoi(val) : *(int *)val;
+        if (i < m->n) CHECK(value == m->values[i]);
+        i++;
+    }
+    CHECK(i == m->n);
+    for (int k = 0; k < m->n && k < 4; k++){
+        CHECK(valueAt(list, k) == m->values[k]);
+        CHECK(valueAt(list, m->n - 1 - k) == m->values[m->n - 1 - k]);
+    }
+}
+
+/** @brief Appends `value` to `list`; strings are sometimes long enough for the heap. */
+static void pushNumber(List list, int value){
+    if (list->_type == STRING) {
+        char buffer[48];
+        snprintf(buffer, sizeof buffer, "%d%s", value, value % 4 ? "" : " is long enough for the heap");
+        pushString(list, buffer);
+    } else {
+        pushInt(list, value);
+    }
+}
+
+static void fill(Modelled *m, Type type, int flags, int n){
+    m->list = newListWithFlags(type, flags);
+    m->n = 0;
+    for (int i = 0; i < n; i++){
+        pushNumber(m->list, i * 7);
+        m->values[m->n++] = i * 7;
+    }
+}
+
+/** @brief Makes `copy` a view of `m->list` with the same model. */
+static void share(Modelled *copy, const Modelled *m, bool useSnapshot){
+    copy->list = useSnapshot ? snapshot(m->list) : duplicate(m->list);
+    copy->n = m->n;
+    memcpy(copy->values, m->values, (size_t)m->n * sizeof(int));
+}
+
+static void release(Modelled *m){
+    listDestroy(m->list);
+    free(m->list);
+}
+
+/** @brief Applies one random modification to `m` and its model. */
+static void modify(Modelled *m, unsigned r){
+    List list = m->list;
+    int value = (int)(r >> 12 & 0xfff);
+    int op = m->n == 0 ? 0 : (int)(r % 7);
+    if (m->n >= MAX_MODEL - 1) op = 4;
+    int index = m->n == 0 ? 0 : (int)(r / 7 % (unsigned)m->n);
+    switch (op){
+        case 0:
+            pushNumber(list, value);
+            m->values[m->n++] = value;
+            break;
+        case 1:
+            if (list->_type == STRING) {
+                char buffer[16];
+                snprintf(buffer, sizeof buffer, "%d", value);
+                insertString(list, index, buffer);
+            } else {
+                insertInt(list, index, value);
+            }
+            memmove(m->values + index + 1, m->values + index, (size_t)(m->n++ - index) * sizeof(int));
+            m->values[index] = value;
+            break;
+        case 2:
+            if (list->_type == STRING) {
+                char buffer[16];
+                snprintf(buffer, sizeof buffer, "%d", value);
+                setString(list, index, buffer);
+            } else {
+                setInt(list, index, value);
+            }
+            m->values[index] = value;
+            break;
+        case 3:
+            listRemove(list, index);
+            memmove(m->values + index, m->values + index + 1, (size_t)(--m->n - index) * sizeof(int));
+            break;
+        case 4:
+            free(listPop(list));
+            memmove(m->values, m->values + 1, (size_t)--m->n * sizeof(int));
+            break;
+        case 5: {
+            void *back = popBack(list);
+            CHECK(back != NULL);
+            free(back);
+            m->n--;
+            break;
+        }
+        default: {
+            void *picked = listPick(list, index);
+            CHECK(picked != NULL && (list->_type == STRING ? atoi(picked) : *(int *)picked) == m->values[index]);
+            free(picked);
+            memmove(m->values + index, m->values + index + 1, (size_t)(--m->n - index) * sizeof(int));
+            break;
+        }
+    }
+}
+
+/** @brief Writes through each of several views, and through a view of a view, while the others stay intact. */
+static void testIndependentViews(Type type, int flags){
+    static Modelled source, copy, snap, nested;
+    fill(&source, type, flags, 300);
+    share(&copy, &source, false);
+    share(&snap, &source, true);
+    share(&nested, &copy, false);
+    checkModel(&copy);
+    checkModel(&snap);
+    checkModel(&nested);
+    Modelled *views[] = { &copy, &source, &nested, &snap };
+    unsigned state = (unsigned)flags * 17u + (unsigned)type;
+    for (int v = 0; v < 4; v++){
+        for (int step = 0; step < 40; step++){
+            state = state * 1103515245u + 12345u;
+            modify(views[v], state >> 4);
+        }
+        // The modified view has its own storage; the others still read the shared one.
+        for (int w = 0; w < 4; w++) checkModel(views[w]);
+    }
+    // Every list has been written to, so none of them shares storage any more.
+    for (int v = 0; v < 4; v++){
+        state = state * 1103515245u + 12345u;
+        modify(views[v], state >> 4);
+        for (int w = 0; w < 4; w++) checkModel(views[w]);
+    }
+    release(&source);
+    release(&copy);
+    release(&snap);
+    release(&nested);
+}
+
+/** @brief The last view writes in place; earlier writers copy and leave the storage where it was. */
+static void testTakeover(int flags){
+    static Modelled source, copy;
+    fill(&source, INT, flags, 200);
+    const int *first = listGet(source.list, 0);
+
+    // Alone again after its duplicate is freed, the source keeps its storage.
+    share(&copy, &source, false);
+    CHECK(listGet(copy.list, 0) == first);
+    release(&copy);
+    setInt(source.list, 199, -1);
+    source.values[199] = -1;
+    CHECK(listGet(source.list, 0) == first);
+    checkModel(&source);
+
+    // With two views, the writer copies and the other keeps the storage,
+    // then takes it over when it writes in turn.
+    share(&copy, &source, false);
+    setInt(source.list, 0, -2);
+    source.values[0] = -2;
+    CHECK(listGet(source.list, 0) != first && listGet(copy.list, 0) == first);
+    setInt(copy.list, 199, -3);
+    copy.values[199] = -3;
+    CHECK(listGet(copy.list, 0) == first);
+    checkModel(&source);
+    checkModel(&copy);
+    release(&source);
+
+    // A duplicate that outlives the list it was made from takes the storage over.
+    share(&source, &copy, false);
+    release(&copy);
+    setInt(source.list, 5, 5);
+    source.values[5] = 5;
+    CHECK(listGet(source.list, 0) == first);
+    checkModel(&source);
+    release(&source);
+}
+
+/** @brief Views may be freed in any order, and the storage lives until the last one goes. */
+static void testFreeOrder(Type type, int flags){
+    for (int order = 0; order < 3; order++){
+        static Modelled source, views[3];
+        fill(&source, type, flags, 100);
+        for (int v = 0; v < 3; v++) share(&views[v], v == 2 ? &views[0] : &source, v == 1);
+        if (order == 0) {
+            // The list everything was made from goes first.
+            release(&source);
+            for (int v = 0; v < 3; v++) checkModel(&views[v]);
+            release(&views[0]);
+            checkModel(&views[1]);
+            checkModel(&views[2]);
+            modify(&views[2], 12345u);
+            checkModel(&views[1]);
+            checkModel(&views[2]);
+            release(&views[2]);
+            modify(&views[1], 54321u);
+            checkModel(&views[1]);
+            release(&views[1]);
+        } else if (order == 1) {
+            // Views go first, unread and unmodified.
+            for (int v = 2; v >= 0; v--) release(&views[v]);
+            checkModel(&source);
+            modify(&source, 999u);
+            checkModel(&source);
+            release(&source);
+        } else {
+            // Interleaved, with one view emptied before it is freed.
+            release(&views[1]);
+            while (views[0].n > 0) modify(&views[0], 4u);
+            checkModel(&views[0]);
+            release(&source);
+            checkModel(&views[2]);
+            release(&views[0]);
+            checkModel(&views[2]);
+            release(&views[2]);
+        }
+    }
+}
+
+/** A `LIST_SYNC` list written by one thread while others copy it. */
+typedef struct ShareJob{
+    List list;
+    int rounds;
+    int bad;
+} ShareJob;
+
+#define SYNC_BASE 500
+
+/** @brief Grows and shrinks the list; element `i` always holds `i`. */
+static void *writeLoop(void *argument){
+    ShareJob *job = argument;
+    for (int i = 0; i < job->rounds; i++){
+        int n = listLen(job->list);
+        if (i % 3 == 2 && n > SYNC_BASE) free(popBack(job->list));
+        else pushInt(job->list, n);
+    }
+    return NULL;
+}
+
+/** @brief Copies the list, checks each copy is whole, and writes to some copies. */
+static void *copyLoop(void *argument){
+    ShareJob *job = argument;
+    for (int i = 0; i < job->rounds; i++){
+        List copy = i % 2 ? snapshot(job->list) : duplicate(job->list);
+        if (copy == NULL) {
+            job->bad++;
+            continue;
+        }
+        int expected = 0;
+        TLIST_FOREACH(copy, val){
+            if (*(int *)val != expected) job->bad++;
+            expected++;
+        }
+        if (expected < SYNC_BASE) job->bad++;
+        if (i % 3 == 0) {
+            setInt(copy, 0, -1);
+            if (getInt(copy, 0) != -1 || getInt(copy, 1) != 1) job->bad++;
+        }
+        listDestroy(copy);
+        free(copy);
+    }
+    return NULL;
+}
+
+/** @brief Copies of a `LIST_SYNC` list taken while another thread writes to it are consistent. */
+static void testSyncSharing(int flags){
+    List list = newListWithFlags(INT, LIST_SYNC | flags);
+    for (int i = 0; i < SYNC_BASE; i++) pushInt(list, i);
+    ShareJob writer = { list, 3000, 0 };
+    ShareJob copiers[2] = { { list, 200, 0 }, { list, 200, 0 } };
+    pthread_t threads[3];
+    pthread_create(&threads[0], NULL, writeLoop, &writer);
+    pthread_create(&threads[1], NULL, copyLoop, &copiers[0]);
+    pthread_create(&threads[2], NULL, copyLoop, &copiers[1]);
+    for (int t = 0; t < 3; t++) pthread_join(threads[t], NULL);
+    CHECK(copiers[0].bad == 0 && copiers[1].bad == 0);
+    int i = 0;
+    TLIST_FOREACH(list, val) CHECK(*(int *)val == i++);
+    CHECK(i == listLen(list));
+    listDestroy(list);
+    free(list);
+}
+
+/** Temporary image file, removed by `main`. */
+static char path[] = "/tmp/tlist_shareXXXXXX";
+
+/** @brief `mmapList` views copy on their first write, even when alone, and never change the file. */
+static void testMapped(Type type){
+    static Modelled saved, mapped, copy;
+    fill(&saved, type, LIST_DEFAULT, 400);
+    CHECK(saveList(saved.list, path));
+    for (int order = 0; order < 2; order++){
+        mapped.list = mmapList(path);
+        CHECK(mapped.list != NULL);
+        if (mapped.list == NULL) return;
+        mapped.n = saved.n;
+        memcpy(mapped.values, saved.values, (size_t)saved.n * sizeof(int));
+        checkModel(&mapped);
+        share(&copy, &mapped, order == 1);
+        const void *inMapping = listGet(mapped.list, 0);
+        CHECK(listGet(copy.list, 0) == inMapping);
+        Modelled *writer = order == 0 ? &mapped : &copy;
+        Modelled *reader = order == 0 ? &copy : &mapped;
+        modify(writer, 7u);
+        CHECK(listGet(writer->list, 0) != inMapping && listGet(reader->list, 0) == inMapping);
+        checkModel(writer);
+        checkModel(reader);
+        release(writer);
+        // The last view of a mapping still copies it rather than writing to the file.
+        modify(reader, 2u);
+        CHECK(listGet(reader->list, 0) != inMapping);
+        checkModel(reader);
+        release(reader);
+    }
+    // A mapping freed before its duplicate is written to stays readable through it.
+    mapped.list = mmapList(path);
+    CHECK(mapped.list != NULL);
+    if (mapped.list == NULL) return;
+    copy.list = duplicate(mapped.list);
+    copy.n = saved.n;
+    memcpy(copy.values, saved.values, (size_t)saved.n * sizeof(int));
+    release(&mapped);
+    checkModel(&copy);
+    modify(&copy, 3u);
+    checkModel(&copy);
+    release(&copy);
+    // The file is unchanged.
+    mapped.list = loadList(path, LIST_DEFAULT);
+    mapped.n = saved.n;
+    memcpy(mapped.values, saved.values, (size_t)saved.n * sizeof(int));
+    checkModel(&mapped);
+    release(&mapped);
+    release(&saved);
+}
+
+int main(void){
+    for (int f = 0; f < FLAG_SETS; f++){
+        testIndependentViews(INT, flagSets[f]);
+        testIndependentViews(STRING, flagSets[f]);
+        testTakeover(flagSets[f]);
+        testFreeOrder(INT, flagSets[f]);
+        testFreeOrder(STRING, flagSets[f]);
+    }
+    const int stringFlags[] = { LIST_ARENA, LIST_INTERN, LIST_ARENA | LIST_VECTOR, LIST_ARENA | LIST_SYNC };
+    for (int f = 0; f < 4; f++){
+        testIndependentViews(STRING, stringFlags[f]);
+        testFreeOrder(STRING, stringFlags[f]);
+    }
+    testSyncSharing(LIST_DEFAULT);
+    testSyncSharing(LIST_VECTOR);
+    testSyncSharing(LIST_DOUBLY);
+    int fd = mkstemp(path);
+    CHECK(fd >= 0);
+    if (fd < 0) return checkResult();
+    close(fd);
+    testMapped(INT);
+    testMapped(STRING);
+    unlink(path);
+    return checkResult();
+}
@@ -0,0 +1,160 @@
+/**
+ * @file test_sort.c
+ * @brief `listSort` stability on every backend, and the radix path against comparison sorting.
+ */
+
+#include "Tlist.h"
+#include "check.h"
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+
+/** Backends and options every test runs on. */
+static const int flagSets[] = {
+    LIST_DEFAULT, LIST_SLAB, LIST_UNROLLED, LIST_VECTOR, LIST_DOUBLY, LIST_SYNC, LIST_SLAB | LIST_DOUBLY,
+    LIST_SYNC | LIST_VECTOR,
+};
+#define FLAG_SETS (int)(sizeof(flagSets) / sizeof(flagSets[0]))
+
+/** Lengths around the small cases and the radix threshold (`TLIST_RADIX_MIN`). */
+static const int lengths[] = { 0, 1, 2, 3, 17, 255, 256, 1000 };
+#define LENGTHS (int)(sizeof(lengths) / sizeof(lengths[0]))
+
+/** A `T` element: sorted by `key` only, `order` records the insertion order. */
+struct Record { int key; int order; };
+
+static int compareKey(const void *a, const void *b){
+    return compareInt(&((const struct Record *)a)->key, &((const struct Record *)b)->key);
+}
+
+/** Orders strings by their first character only, so most of them tie. */
+static int compareFirst(const void *a, const void *b){
+    return (int)*(const unsigned char *)a - (int)*(const unsigned char *)b;
+}
+
+/** Natural order under another name, which keeps `listSort` off the radix path. */
+static int compareIntSlow(const void *a, const void *b){
+    return compareInt(a, b);
+}
+
+static int compareFloatSlow(const void *a, const void *b){
+    return compareFloat(a, b);
+}
+
+/** @brief Equal keys keep their insertion order for `T` elements. */
+static void testStableRecords(int flags, int n){
+    List list = newListWithFlags(T, flags);
+    struct Record *records = malloc((size_t)(n > 0 ? n : 1) * sizeof(struct Record));
+    for (int i = 0; i < n; i++){
+        records[i].key = (i * 37) % 11;
+        records[i].order = i;
+        pushPtr(list, &records[i]);
+    }
+    listSort(list, compareKey);
+    CHECK(listLen(list) == n);
+    for (int i = 1; i < n; i++){
+        const struct Record *a = listGet(list, i - 1), *b = listGet(list, i);
+        CHECK(a->key < b->key || (a->key == b->key && a->order < b->order));
+    }
+    listDestroy(list);
+    free(list);
+    free(records);
+}
+
+/** @brief Equal keys keep their insertion order for `STRING` elements. */
+static void testStableStrings(int flags, int n){
+    List list = newListWithFlags(STRING, flags);
+    char buffer[64];
+    for (int i = 0; i < n; i++){
+        snprintf(buffer, sizeof buffer, "%c%06d%s", 'a' + (i * 7) % 5, i, i % 3 ? "" : " with a heap-sized tail");
+        pushString(list, buffer);
+    }
+    listSort(list, compareFirst);
+    for (int i = 1; i < n; i++){
+        const char *a = listGet(list, i - 1), *b = listGet(list, i);
+        CHECK(a[0] < b[0] || (a[0] == b[0] && atoi(a + 1) < atoi(b + 1)));
+    }
+    listDestroy(list);
+    free(list);
+}
+
+/** @brief Radix-sorted `INT` lists equal the same lists sorted by comparison. */
+static void testRadixInts(int flags, int n){
+    List radix = newListWithFlags(INT, flags);
+    List merge = newListWithFlags(INT, flags);
+    const int extremes[] = { INT_MIN, INT_MAX, 0, -1, 1, INT_MIN + 1, INT_MAX - 1, 256, -256, 65536 };
+    unsigned state = (unsigned)n;
+    for (int i = 0; i < n; i++){
+        state = state * 1103515245u + 12345u;
+        int value = i % 4 == 0 ? extremes[(state >> 8) % 10] : (int)(state ^ (state << 13));
+        pushInt(radix, value);
+        pushInt(merge, value);
+    }
+    listSort(radix, NULL);
+    listSort(merge, compareIntSlow);
+    for (int i = 0; i < n; i++){
+        CHECK(getInt(radix, i) == getInt(merge, i));
+        if (i > 0) CHECK(getInt(radix, i - 1) <= getInt(radix, i));
+    }
+    listDestroy(radix);
+    free(radix);
+    listDestroy(merge);
+    free(merge);
+}
+
+/** @brief Radix-sorted `FLOAT` lists equal the same lists sorted by comparison. */
+static void testRadixFloats(int flags, int n){
+    List radix = newListWithFlags(FLOAT, flags);
+    List merge = newListWithFlags(FLOAT, flags);
+    const float specials[] = { 0.0f, -0.0f, INFINITY, -INFINITY, FLT_MAX, -FLT_MAX, FLT_MIN, -FLT_MIN, 1e-45f, -1e-45f };
+    unsigned state = (unsigned)n + 1;
+    for (int i = 0; i < n; i++){
+        state = state * 1103515245u + 12345u;
+        float value = i % 3 == 0 ? specials[(state >> 8) % 10] : ((float)(int)(state >> 4) - 1e8f) / 977.0f;
+        pushFloat(radix, value);
+        pushFloat(merge, value);
+    }
+    listSort(radix, compareFloat);
+    listSort(merge, compareFloatSlow);
+    for (int i = 0; i < n; i++){
+        // -0.0 and 0.0 compare equal, so only their relative order may differ.
+        CHECK(getFloat(radix, i) == getFloat(merge, i));
+        if (i > 0) CHECK(getFloat(radix, i - 1) <= getFloat(radix, i));
+    }
+    listDestroy(radix);
+    free(radix);
+    listDestroy(merge);
+    free(merge);
+}
+
+/** @brief The radix path orders -0.0 before 0.0 and leaves a hash index usable. */
+static void testRadixDetails(void){
+    List list = newList(FLOAT);
+    for (int i = 0; i < 300; i++) pushFloat(list, i % 2 ? 0.0f : -0.0f);
+    listSort(list, NULL);
+    for (int i = 0; i < 300; i++) CHECK((signbit(getFloat(list, i)) != 0) == (i < 150));
+    listDestroy(list);
+    free(list);
+
+    List ints = newList(INT);
+    for (int i = 0; i < 500; i++) pushInt(ints, 499 - i);
+    CHECK(indexList(ints, NULL, NULL));
+    listSort(ints, NULL);
+    for (int i = 0; i < 500; i++) CHECK(getInt(ints, i) == i && listIndexOf(ints, i) == i);
+    listDestroy(ints);
+    free(ints);
+}
+
+int main(void){
+    for (int f = 0; f < FLAG_SETS; f++){
+        for (int l = 0; l < LENGTHS; l++){
+            testStableRecords(flagSets[f], lengths[l]);
+            testStableStrings(flagSets[f], lengths[l]);
+            testRadixInts(flagSets[f], lengths[l]);
+            testRadixFloats(flagSets[f], lengths[l]);
+        }
+    }
+    testRadixDetails();
+    return checkResult();
+}
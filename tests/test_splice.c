@@ -0,0 +1,299 @@
+/**
+ * @file test_splice.c
+ * @brief `spliceRange`, `listConcat` and `splitAt` for every pair of backends.
+ *
+ * Pairs with the same plain linked, doubly, unrolled or vector storage move
+ * their elements; slab, arena and indexed lists, mismatched storage and
+ * mismatched allocators go through the copy fallback. Both must leave the
+ * lists equal to an array model.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "Tlist.h"
+#include "check.h"
+#include <pthread.h>
+#include <string.h>
+
+/** Storage variants paired with each other. */
+static const int flagSets[] = {
+    LIST_DEFAULT, LIST_DOUBLY, LIST_SLAB, LIST_SLAB | LIST_DOUBLY, LIST_UNROLLED, LIST_VECTOR,
+    LIST_SYNC, LIST_SYNC | LIST_DOUBLY, LIST_SYNC | LIST_VECTOR,
+};
+#define FLAG_SETS (int)(sizeof(flagSets) / sizeof(flagSets[0]))
+
+#define MAX_MODEL 4096
+
+/** A list with the array it must stay equal to. */
+typedef struct Modelled{
+    List list;
+    int values[MAX_MODEL];
+    int n;
+} Modelled;
+
+/** @brief Checks `m->list` against its model, forwards and, where supported, backwards. */
+static void checkModel(Modelled *m){
+    List list = m->list;
+    CHECK(listLen(list) == m->n);
+    int i = 0;
+    TLIST_FOREACH(list, val){
+        int value = list->_type == STRING ? atoi(val) : *(int *)val;
+        if (i < m->n) CHECK(value == m->values[i]);
+        i++;
+    }
+    CHECK(i == m->n);
+    if (list->_flags & (LIST_DOUBLY | LIST_VECTOR)) {
+        // Reverse iteration follows the back-links the splice rewrote.
+        TIterator iterator = newReverseIterator(list);
+        i = m->n;
+        while (iterator->hasNext(iterator)){
+            void *val = iterator->next(iterator);
+            int value = list->_type == STRING ? atoi(val) : *(int *)val;
+            CHECK(i > 0 && value == m->values[--i]);
+        }
+        CHECK(i == 0);
+        iterator->free(iterator);
+    }
+}
+
+/** @brief Creates a modelled list of `n` values starting at `base`. */
+static void fill(Modelled *m, Type type, int flags, int n, int base){
+    m->list = newListWithFlags(type, flags);
+    m->n = 0;
+    char buffer[48];
+    for (int i = 0; i < n; i++){
+        int value = base + i;
+        if (type == STRING) {
+            snprintf(buffer, sizeof buffer, "%d%s", value, i % 4 ? "" : " is long enough for the heap");
+            pushString(m->list, buffer);
+        } else {
+            pushInt(m->list, value);
+        }
+        m->values[m->n++] = value;
+    }
+}
+
+/** @brief Applies `spliceRange(dst, pos, src, from, to)` to the models as well. */
+static void splice(Modelled *dst, int pos, Modelled *src, int from, int to){
+    spliceRange(dst->list, pos, src->list, from, to);
+    int n = to - from;
+    memmove(dst->values + pos + n, dst->values + pos, (size_t)(dst->n - pos) * sizeof(int));
+    memcpy(dst->values + pos, src->values + from, (size_t)n * sizeof(int));
+    dst->n += n;
+    memmove(src->values + from, src->values + to, (size_t)(src->n - to) * sizeof(int));
+    src->n -= n;
+}
+
+static void release(Modelled *m){
+    listDestroy(m->list);
+    free(m->list);
+}
+
+/** @brief Random splices in both directions between lists with `dstFlags` and `srcFlags`. */
+static void testPair(Type type, int dstFlags, int srcFlags){
+    static Modelled a, b;
+    fill(&a, type, dstFlags, 300, 0);
+    fill(&b, type, srcFlags, 200, 10000);
+    unsigned state = (unsigned)(dstFlags * 31 + srcFlags);
+    for (int step = 0; step < 60; step++){
+        state = state * 1103515245u + 12345u;
+        unsigned r = state >> 8;
+        Modelled *dst = step % 2 ? &a : &b;
+        Modelled *src = step % 2 ? &b : &a;
+        if (src->n == 0 || dst->n + src->n > MAX_MODEL) continue;
+        int from = (int)(r % (unsigned)src->n);
+        int to = from + (int)(r / 7 % (unsigned)(src->n - from + 1));
+        int pos = (int)(r / 13 % (unsigned)(dst->n + 1));
+        // Touch the destination first so its cursor has to follow the insertion.
+        if (dst->n > 0) listGet(dst->list, dst->n - 1);
+        splice(dst, pos, src, from, to);
+        checkModel(dst);
+        checkModel(src);
+    }
+    // Edge ranges: empty, whole list, and the ends.
+    splice(&a, 0, &b, 0, 0);
+    splice(&a, a.n, &b, 0, b.n);
+    checkModel(&a);
+    checkModel(&b);
+    splice(&b, 0, &a, 0, 1);
+    splice(&b, 1, &a, a.n - 1, a.n);
+    checkModel(&a);
+    checkModel(&b);
+    release(&a);
+    release(&b);
+}
+
+/** @brief Same-storage linked splices relink the nodes; slab lists copy them. */
+static void testRelinking(void){
+    static Modelled a, b;
+    const int storages[] = { LIST_DEFAULT, LIST_DOUBLY, LIST_SLAB };
+    for (int s = 0; s < 3; s++){
+        fill(&a, INT, storages[s], 10, 0);
+        fill(&b, INT, storages[s], 10, 100);
+        int *moved = listGet(b.list, 4);
+        splice(&a, 3, &b, 4, 7);
+        int *now = listGet(a.list, 3);
+        CHECK(*now == 104);
+        CHECK((now == moved) == !(storages[s] & LIST_SLAB));
+        checkModel(&a);
+        checkModel(&b);
+        release(&a);
+        release(&b);
+    }
+}
+
+/** @brief The destination cursor shifts past an insertion at or before it. */
+static void testCursorShift(void){
+    static Modelled a, b;
+    fill(&a, INT, LIST_DEFAULT, 100, 0);
+    fill(&b, INT, LIST_DEFAULT, 50, 1000);
+    CHECK(getInt(a.list, 60) == 60);
+    splice(&a, 60, &b, 10, 30);
+    CHECK(getInt(a.list, 80) == 60);
+    CHECK(getInt(a.list, 81) == 61);
+    CHECK(getInt(a.list, 60) == 1010);
+    CHECK(getInt(a.list, 20) == 20);
+    // An insertion after the cursor leaves it in place.
+    CHECK(getInt(a.list, 10) == 10);
+    splice(&a, 50, &b, 0, 5);
+    CHECK(getInt(a.list, 11) == 11);
+    checkModel(&a);
+    checkModel(&b);
+    release(&a);
+    release(&b);
+}
+
+/** @brief Hash-indexed lists take the copy path and keep their index current. */
+static void testIndexed(void){
+    static Modelled a, b;
+    fill(&a, INT, LIST_DEFAULT, 100, 0);
+    fill(&b, INT, LIST_DEFAULT, 100, 1000);
+    CHECK(indexList(a.list, NULL, NULL));
+    CHECK(indexList(b.list, NULL, NULL));
+    splice(&a, 50, &b, 20, 40);
+    checkModel(&a);
+    checkModel(&b);
+    CHECK(listIndexOf(a.list, 1020) == 50 && listIndexOf(a.list, 50) == 70);
+    CHECK(!listContains(b.list, 1020) && listIndexOf(b.list, 1040) == 20);
+    release(&a);
+    release(&b);
+}
+
+static void *countAlloc(void *context, size_t size){
+    (*(int *)context)++;
+    return malloc(size);
+}
+
+static void *countRealloc(void *context, void *ptr, size_t oldSize, size_t size){
+    (void)context;
+    (void)oldSize;
+    return realloc(ptr, size);
+}
+
+static void countFree(void *context, void *ptr){
+    (*(int *)context)--;
+    free(ptr);
+}
+
+/** @brief Lists with different allocators copy, so each frees only its own memory. */
+static void testAllocatorMismatch(void){
+    int live = 0;
+    TAllocator allocator = { countAlloc, countRealloc, countFree, &live };
+    const int storages[] = { LIST_DEFAULT, LIST_DOUBLY, LIST_UNROLLED, LIST_VECTOR };
+    for (int s = 0; s < 4; s++){
+        static Modelled a, b;
+        fill(&b, INT, storages[s], 100, 1000);
+        a.list = newListWithFlagsAndAllocator(INT, storages[s], &allocator);
+        a.n = 0;
+        splice(&a, 0, &b, 10, 60);
+        splice(&b, 5, &a, 20, 30);
+        checkModel(&a);
+        checkModel(&b);
+        release(&b);
+        release(&a);
+        CHECK(live == 0);
+    }
+}
+
+/** @brief `listConcat` and `splitAt` on mixed backends. */
+static void testConcatSplit(void){
+    for (int f = 0; f < FLAG_SETS; f++){
+        static Modelled a, b;
+        fill(&a, INT, flagSets[f], 40, 0);
+        fill(&b, INT, flagSets[(f + 1) % FLAG_SETS], 30, 40);
+        listConcat(a.list, b.list);
+        CHECK(listLen(a.list) == 70 && listLen(b.list) == 0);
+        List tail = splitAt(a.list, 25);
+        CHECK(tail != NULL && listLen(tail) == 45 && listLen(a.list) == 25);
+        for (int i = 0; i < 45; i++) CHECK(getInt(tail, i) == 25 + i);
+        for (int i = 0; i < 25; i++) CHECK(getInt(a.list, i) == i);
+        listDestroy(tail);
+        free(tail);
+        release(&a);
+        release(&b);
+    }
+}
+
+/** Two lists spliced into each other by two threads at once. */
+typedef struct SpliceJob{
+    List from;
+    List to;
+    int rounds;
+} SpliceJob;
+
+static void *spliceLoop(void *argument){
+    SpliceJob *job = argument;
+    for (int i = 0; i < job->rounds; i++){
+        // Lengths may change between the call and the lock, so out-of-range calls are expected and refused.
+        int n = listLen(job->from);
+        if (n > 4) spliceRange(job->to, 0, job->from, n / 4, n / 2);
+        if (i % 16 == 0) listConcat(job->to, job->from);
+    }
+    return NULL;
+}
+
+/** @brief Opposite-direction splices on `LIST_SYNC` lists finish and conserve the elements. */
+static void testConcurrent(int flags){
+    List a = newListWithFlags(INT, LIST_SYNC | flags);
+    List b = newListWithFlags(INT, LIST_SYNC | flags);
+    long sum = 0;
+    for (int i = 0; i < 2000; i++){
+        pushInt(i % 2 ? a : b, i);
+        sum += i;
+    }
+    SpliceJob forward = { a, b, 2000 }, backward = { b, a, 2000 };
+    pthread_t threads[2];
+    pthread_create(&threads[0], NULL, spliceLoop, &forward);
+    pthread_create(&threads[1], NULL, spliceLoop, &backward);
+    pthread_join(threads[0], NULL);
+    pthread_join(threads[1], NULL);
+    CHECK(listLen(a) + listLen(b) == 2000);
+    long total = 0;
+    TLIST_FOREACH(a, val) total += *(int *)val;
+    TLIST_FOREACH(b, val) total += *(int *)val;
+    CHECK(total == sum);
+    listDestroy(a);
+    free(a);
+    listDestroy(b);
+    free(b);
+}
+
+int main(void){
+    for (int d = 0; d < FLAG_SETS; d++){
+        for (int s = 0; s < FLAG_SETS; s++) testPair(INT, flagSets[d], flagSets[s]);
+    }
+    const int stringFlags[] = { LIST_DEFAULT, LIST_ARENA, LIST_INTERN, LIST_DOUBLY, LIST_UNROLLED, LIST_VECTOR };
+    for (int d = 0; d < 6; d++){
+        for (int s = 0; s < 6; s++) testPair(STRING, stringFlags[d], stringFlags[s]);
+    }
+    testRelinking();
+    testCursorShift();
+    testIndexed();
+    testAllocatorMismatch();
+    testConcatSplit();
+    testConcurrent(LIST_DEFAULT);
+    testConcurrent(LIST_DOUBLY);
+    testConcurrent(LIST_VECTOR);
+    testConcurrent(LIST_UNROLLED);
+    return checkResult();
+}
@@ -0,0 +1,264 @@
+/**
+ * @file test_stats.c
+ * @brief The counters of the instrumentation build, and their absence from other builds.
+ *
+ * Built with `TLIST_STATS`, it checks calls per operation, traversals,
+ * allocations and held bytes on every backend, the process-wide totals, the
+ * latency histograms and `resetStats`. Without it, every reader must report
+ * that no counters exist.
+ */
+
+#include "Tlist.h"
+#include "check.h"
+#include <string.h>
+
+/** @brief Returns `true` if `dumpStats` output contains `text`. */
+static bool dumpContains(const char *text){
+    FILE *file = tmpfile();
+    CHECK(file != NULL);
+    if (file == NULL) return false;
+    dumpStats(file);
+    rewind(file);
+    char buffer[4096];
+    size_t n = fread(buffer, 1, sizeof buffer - 1, file);
+    buffer[n] = '\0';
+    fclose(file);
+    return strstr(buffer, text) != NULL;
+}
+
+#ifdef TLIST_STATS
+
+/** Backends and options every test runs on. */
+static const int flagSets[] = {
+    LIST_DEFAULT, LIST_SLAB, LIST_UNROLLED, LIST_VECTOR, LIST_DOUBLY, LIST_SYNC, LIST_SYNC | LIST_VECTOR,
+};
+#define FLAG_SETS (int)(sizeof(flagSets) / sizeof(flagSets[0]))
+
+static void nothing(void *val){
+    (void)val;
+}
+
+/** @brief Each call is counted once, under its own operation, in the list and in the totals. */
+static void testCalls(int flags){
+    ListStats before, list, after;
+    CHECK(globalStats(&before));
+    List ints = newListWithFlags(INT, flags);
+    for (int i = 0; i < 100; i++) pushInt(ints, i);
+    listPush(ints, 100);
+    const int batch[] = { 1, 2, 3 };
+    pushArray(ints, batch, 3);
+    insertArray(ints, 0, batch, 3);
+    for (int i = 0; i < 50; i++) listGet(ints, i);
+    getInt(ints, 7);
+    for (int i = 0; i < 10; i++) setInt(ints, i, -i);
+    for (int i = 0; i < 5; i++) insertInt(ints, i * 2, i);
+    pushFront(ints, 9);
+    for (int i = 0; i < 3; i++) listRemove(ints, i);
+    free(listPick(ints, 4));
+    free(popBack(ints));
+    for (int i = 0; i < 4; i++) free(listPop(ints));
+    int out;
+    CHECK(popInto(ints, &out));
+    listLen(ints);
+    listForeach(ints, nothing);
+
+    CHECK(listStats(ints, &list));
+    CHECK(list.calls[LIST_OP_PUSH] == 101);
+    CHECK(list.calls[LIST_OP_ARRAY] == 2);
+    CHECK(list.calls[LIST_OP_GET] == 51);
+    CHECK(list.calls[LIST_OP_SET] == 10);
+    CHECK(list.calls[LIST_OP_INSERT] == 6);
+    CHECK(list.calls[LIST_OP_REMOVE] == 3);
+    CHECK(list.calls[LIST_OP_PICK] == 2);
+    CHECK(list.calls[LIST_OP_POP] == 5);
+    CHECK(list.calls[LIST_OP_FOREACH] == 1);
+    CHECK(list.calls[LIST_OP_PRINT] == 0 && list.calls[LIST_OP_FREE] == 0);
+    CHECK(list.calls[LIST_OP_LEN] >= 1);
+    CHECK(globalStats(&after));
+    for (int op = 0; op < LIST_OP_COUNT; op++) CHECK(after.calls[op] - before.calls[op] == list.calls[op]);
+    CHECK(after.mallocs - before.mallocs == list.mallocs);
+
+    // Resetting the list clears its calls but keeps the bytes it holds, and leaves the totals alone.
+    resetStats(ints);
+    ListStats reset;
+    CHECK(listStats(ints, &reset));
+    for (int op = 0; op < LIST_OP_COUNT; op++) CHECK(reset.calls[op] == 0);
+    CHECK(reset.mallocs == 0 && reset.frees == 0 && reset.nodesTraversed == 0);
+    CHECK(reset.nodeBytes == list.nodeBytes && reset.valueBytes == list.valueBytes);
+    CHECK(globalStats(&after) && after.calls[LIST_OP_GET] - before.calls[LIST_OP_GET] == 51);
+
+    listDestroy(ints);
+    CHECK(globalStats(&after));
+    CHECK(after.calls[LIST_OP_FREE] - before.calls[LIST_OP_FREE] == 1);
+    free(ints);
+}
+
+/** @brief Held bytes rise with the elements and return to where they were once the list is freed. */
+static void testMemory(Type type, int flags){
+    ListStats before, full, after;
+    CHECK(globalStats(&before));
+    List list = newListWithFlags(type, flags);
+    char buffer[64];
+    size_t stringBytes = 0;
+    for (int i = 0; i < 1000; i++){
+        if (type == STRING) {
+            snprintf(buffer, sizeof buffer, "string %d%s", i, i % 2 ? "" : " long enough to need the heap");
+            pushString(list, buffer);
+            if (i % 2 == 0) stringBytes += strlen(buffer) + 1;
+        } else {
+            pushInt(list, i);
+        }
+    }
+    CHECK(listStats(list, &full));
+    CHECK(full.nodeBytes >= (long long)(1000 * (type == STRING ? sizeof(char *) : sizeof(int))));
+    if (type == STRING) {
+        CHECK(full.valueBytes >= (long long)stringBytes);
+    } else {
+        CHECK(full.valueBytes == 0);
+    }
+    CHECK(full.mallocs > 0 && full.mallocs <= 1000 + (type == STRING ? 1000u : 0u));
+    // `pop` and `pick` hand out values, copied or not: allocations the list never frees.
+    for (int i = 0; i < 10; i++) free(listPop(list));
+    free(listPick(list, 3));
+    ListStats popped;
+    CHECK(listStats(list, &popped));
+    CHECK(popped.mallocs >= full.mallocs && popped.frees >= full.frees);
+
+    // A duplicate shares the storage, so no bytes are added until one of them writes.
+    List copy = duplicate(list);
+    ListStats shared;
+    CHECK(globalStats(&shared));
+    if (type == STRING) {
+        setString(copy, 0, "written");
+    } else {
+        setInt(copy, 0, -1);
+    }
+    ListStats copied;
+    CHECK(globalStats(&copied));
+    CHECK(copied.nodeBytes > shared.nodeBytes);
+    listDestroy(copy);
+    free(copy);
+
+    listDestroy(list);
+    free(list);
+    CHECK(globalStats(&after));
+    CHECK(after.nodeBytes == before.nodeBytes);
+    CHECK(after.valueBytes == before.valueBytes);
+    // Every allocation was freed, except the 11 copies handed out.
+    CHECK((after.mallocs - before.mallocs) - (after.frees - before.frees) == 11);
+}
+
+/** @brief Linked lookups count the nodes walked; vector lookups walk none, unrolled ones skip chunks. */
+static void testTraversal(int flags){
+    List list = newListWithFlags(INT, flags);
+    for (int i = 0; i < 4000; i++) pushInt(list, i);
+    resetStats(list);
+    CHECK(getInt(list, 2000) == 2000);
+    ListStats stats;
+    CHECK(listStats(list, &stats));
+    if (flags & LIST_VECTOR) {
+        CHECK(stats.nodesTraversed == 0);
+    } else if (flags & LIST_UNROLLED) {
+        CHECK(stats.nodesTraversed > 0 && stats.nodesTraversed < 500);
+    } else if (flags & LIST_DOUBLY) {
+        CHECK(stats.nodesTraversed >= 1900 && stats.nodesTraversed <= 2000);
+    } else {
+        CHECK(stats.nodesTraversed >= 1990 && stats.nodesTraversed <= 2000);
+    }
+    // An ascending loop resumes from the cursor, so linked lists walk each node about once.
+    // Unrolled lists skip whole chunks from the head, and linked `LIST_SYNC` lists keep no cursor.
+    resetStats(list);
+    for (int i = 0; i < 4000; i++) CHECK(getInt(list, i) == i);
+    CHECK(listStats(list, &stats));
+    size_t hits, misses;
+    cursorStats(list, &hits, &misses);
+    if (flags & LIST_VECTOR) {
+        CHECK(stats.nodesTraversed == 0);
+    } else if (flags & LIST_UNROLLED) {
+        CHECK(stats.nodesTraversed < 4000u * 4000u / 16u);
+    } else if (flags & LIST_SYNC) {
+        CHECK(stats.nodesTraversed >= 4000u * 3990u / 2u && hits == 0);
+    } else {
+        CHECK(stats.nodesTraversed <= 4000 && hits > 10 * misses);
+    }
+    listDestroy(list);
+    free(list);
+}
+
+/** @brief Latencies are recorded only while timing is on, one bucket entry per call. */
+static void testLatency(void){
+    List list = newListWithFlags(INT, LIST_DEFAULT);
+    for (int i = 0; i < 100; i++) pushInt(list, i);
+    statsTiming(true);
+    for (int i = 0; i < 100; i++) listGet(list, i);
+    statsTiming(false);
+    for (int i = 0; i < 100; i++) listGet(list, i);
+    ListStats stats;
+    CHECK(listStats(list, &stats));
+    size_t timed = 0;
+    for (int b = 0; b < TLIST_LATENCY_BUCKETS; b++) timed += stats.latency[LIST_OP_GET][b];
+    CHECK(timed == 100 && stats.calls[LIST_OP_GET] == 200);
+    timed = 0;
+    for (int b = 0; b < TLIST_LATENCY_BUCKETS; b++) timed += stats.latency[LIST_OP_PUSH][b];
+    CHECK(timed == 0);
+    CHECK(dumpContains("get") && dumpContains("nodes traversed"));
+    listDestroy(list);
+    free(list);
+
+    // A global reset clears the totals but not the byte counts.
+    ListStats before, after;
+    CHECK(globalStats(&before));
+    resetStats(NULL);
+    CHECK(globalStats(&after));
+    for (int op = 0; op < LIST_OP_COUNT; op++) CHECK(after.calls[op] == 0);
+    CHECK(after.mallocs == 0 && after.frees == 0);
+    CHECK(after.nodeBytes == before.nodeBytes && after.valueBytes == before.valueBytes);
+    CHECK(!dumpContains("get "));
+}
+
+#else
+
+/** @brief Without `TLIST_STATS`, every reader reports zeroed counters and failure. */
+static void testDisabled(void){
+    List list = newList(INT);
+    for (int i = 0; i < 100; i++) pushInt(list, i);
+    for (int i = 0; i < 100; i++) getInt(list, i);
+    ListStats stats;
+    memset(&stats, 0xff, sizeof stats);
+    CHECK(!listStats(list, &stats));
+    ListStats zero;
+    memset(&zero, 0, sizeof zero);
+    CHECK(memcmp(&stats, &zero, sizeof stats) == 0);
+    memset(&stats, 0xff, sizeof stats);
+    CHECK(!globalStats(&stats));
+    CHECK(memcmp(&stats, &zero, sizeof stats) == 0);
+    size_t hits = 1, misses = 1;
+    cursorStats(list, &hits, &misses);
+    CHECK(hits == 0 && misses == 0);
+    statsTiming(true);
+    resetStats(list);
+    resetStats(NULL);
+    statsTiming(false);
+    CHECK(dumpContains("not available"));
+    listDestroy(list);
+    free(list);
+}
+
+#endif
+
+int main(void){
+#ifdef TLIST_STATS
+    for (int f = 0; f < FLAG_SETS; f++){
+        testCalls(flagSets[f]);
+        testMemory(INT, flagSets[f]);
+        testMemory(STRING, flagSets[f]);
+        testTraversal(flagSets[f]);
+    }
+    testMemory(STRING, LIST_ARENA);
+    testMemory(STRING, LIST_INTERN);
+    testLatency();
+#else
+    testDisabled();
+#endif
+    return checkResult();
+}
@@ -0,0 +1,152 @@
+/**
+ * @file test_template.c
+ * @brief Lists generated by `TLIST_DEFINE`, against a plain array model and against `List`.
+ */
+
+#include "Tlist.h"
+#include "TlistTemplate.h"
+#include "check.h"
+#include <string.h>
+
+struct Point { int x, y; };
+
+TLIST_DECLARE(IntList, int)
+TLIST_DEFINE(IntList, int)
+TLIST_DECLARE(PointList, struct Point)
+TLIST_DEFINE(PointList, struct Point)
+
+/** Sum of the values visited by `addInt`. */
+static long visited;
+
+static void addInt(int *value){
+    visited += *value;
+}
+
+static void movePoint(struct Point *point){
+    point->x += 1;
+}
+
+/** @brief Random pushes, inserts, sets, removes, picks and pops against an array and a `List`. */
+static void testRandom(void){
+    IntList list = newIntList();
+    List reference = newList(INT);
+    static int model[4096];
+    int n = 0;
+    unsigned state = 3;
+    for (int step = 0; step < 8000; step++){
+        state = state * 1103515245u + 12345u;
+        unsigned r = state >> 8;
+        int index = (int)(r / 8 % (unsigned)(n + 1));
+        int value = (int)(r & 0xffff);
+        switch (n == 0 ? 0 : (int)(r % 8)){
+            case 0: case 1:
+                if (n == 4096) break;
+                IntListPush(list, value);
+                pushInt(reference, value);
+                model[n++] = value;
+                break;
+            case 2: case 3:
+                if (n == 4096) break;
+                IntListInsert(list, index, value);
+                insertInt(reference, index, value);
+                memmove(model + index + 1, model + index, (size_t)(n++ - index) * sizeof(int));
+                model[index] = value;
+                break;
+            case 4:
+                if (index == n) index--;
+                IntListSet(list, index, value);
+                setInt(reference, index, value);
+                model[index] = value;
+                break;
+            case 5:
+                if (index == n) index--;
+                IntListRemove(list, index);
+                listRemove(reference, index);
+                memmove(model + index, model + index + 1, (size_t)(--n - index) * sizeof(int));
+                break;
+            case 6: {
+                if (index == n) index--;
+                int out = -1;
+                CHECK(IntListPick(list, index, &out) && out == model[index]);
+                free(listPick(reference, index));
+                memmove(model + index, model + index + 1, (size_t)(--n - index) * sizeof(int));
+                break;
+            }
+            default: {
+                int out = -1;
+                CHECK(IntListPop(list, &out) && out == model[0]);
+                free(listPop(reference));
+                memmove(model, model + 1, (size_t)--n * sizeof(int));
+                break;
+            }
+        }
+        CHECK(IntListLen(list) == n);
+        if (step % 200 == 0) {
+            int i = 0;
+            for (IntListIterator it = IntListBegin(list); IntListHasNext(&it); i++){
+                int value = *IntListNext(&it);
+                CHECK(value == model[i] && value == getInt(reference, i));
+            }
+            CHECK(i == n);
+        }
+    }
+    long sum = 0;
+    for (int i = 0; i < n; i++) sum += model[i];
+    visited = 0;
+    IntListForeach(list, addInt);
+    CHECK(visited == sum && (long)listSum(reference) == sum);
+    IntListFree(list);
+    free(list);
+    listDestroy(reference);
+    free(reference);
+}
+
+/** @brief Edge cases: empty pops, out-of-range indices, the tail after removals, reuse after `Free`. */
+static void testEdges(void){
+    IntList list = newIntList();
+    int out = 7;
+    CHECK(!IntListPop(list, &out) && out == 7);
+    CHECK(!IntListPick(list, 3, &out));
+    CHECK(IntListGet(list, 0) == NULL);
+    IntListInsert(list, 1, 5);
+    CHECK(IntListLen(list) == 0);
+    IntListInsert(list, 0, 2);
+    IntListInsert(list, 1, 4);
+    IntListInsert(list, 1, 3);
+    IntListRemove(list, 2);
+    IntListPush(list, 9);
+    CHECK(IntListLen(list) == 3);
+    CHECK(*IntListGet(list, 0) == 2 && *IntListGet(list, 1) == 3 && *IntListGet(list, 2) == 9);
+    IntListFree(list);
+    CHECK(IntListLen(list) == 0);
+    IntListPush(list, 1);
+    CHECK(*IntListGet(list, 0) == 1);
+    IntListFree(list);
+    free(list);
+}
+
+/** @brief Struct elements are stored by value and can be updated in place. */
+static void testStructs(void){
+    PointList points = newPointList();
+    for (int i = 0; i < 100; i++) PointListPush(points, (struct Point){ i, -i });
+    PointListForeach(points, movePoint);
+    PointListGet(points, 50)->y = 1000;
+    struct Point out;
+    CHECK(PointListPick(points, 50, &out) && out.x == 51 && out.y == 1000);
+    int i = 0;
+    for (PointListIterator it = PointListBegin(points); PointListHasNext(&it); i++){
+        struct Point *point = PointListNext(&it);
+        int original = i < 50 ? i : i + 1;
+        CHECK(point->x == original + 1 && point->y == -original);
+    }
+    CHECK(i == 99);
+    PointListFree(points);
+    free(points);
+}
+
+int main(void){
+    testRandom();
+    testEdges();
+    testStructs();
+    return checkResult();
+}
@@ -0,0 +1,57 @@
+/**
+ * @file test_typed.c
+ * @brief Typed entry points and the `_Generic` front end, built as a release (`NDEBUG`) client.
+ */
+
+#ifndef NDEBUG
+#define NDEBUG
+#endif
+
+#include "Tlist.h"
+#include "check.h"
+#include <string.h>
+
+/** @brief Wrong-type calls leave the list untouched even with `NDEBUG`. */
+static void testMismatch(int flags){
+    List list = newListWithFlags(DOUBLE, flags);
+    listPush(list, 1.5);
+    listPush(list, 1);
+    listInsert(list, 0, 2);
+    listSet(list, 0, 3);
+    pushString(list, "text");
+    CHECK(listLen(list) == 1);
+    CHECK(getDouble(list, 0) == 1.5);
+    CHECK(getInt(list, 0) == 0);
+    listDestroy(list);
+    free(list);
+}
+
+/** @brief `listPush` and friends pick the entry point from the static type of the value. */
+static void testDispatch(void){
+    List ints = newList(INT);
+    List floats = newList(FLOAT);
+    List strings = newList(STRING);
+    listPush(ints, 7);
+    listInsert(ints, 0, 6);
+    listSet(ints, 1, 8);
+    listPush(floats, 2.5f);
+    listPush(strings, "abc");
+    const char *text = "def";
+    listPush(strings, text);
+    CHECK(getInt(ints, 0) == 6 && getInt(ints, 1) == 8);
+    CHECK(getFloat(floats, 0) == 2.5f);
+    CHECK(strcmp(getString(strings, 1), "def") == 0);
+    List lists[] = { ints, floats, strings };
+    for (int i = 0; i < 3; i++) {
+        listDestroy(lists[i]);
+        free(lists[i]);
+    }
+}
+
+int main(void){
+    testMismatch(LIST_DEFAULT);
+    testMismatch(LIST_VECTOR);
+    testMismatch(LIST_UNROLLED);
+    testDispatch();
+    return checkResult();
+}
@@ -0,0 +1,137 @@
+/**
+ * @file test_unrolled.c
+ * @brief `LIST_UNROLLED` chunk splits and merges, with the chunk chain checked after every step.
+ */
+
+#include "Tlist.h"
+#include "TlistPrivate.h"
+#include "check.h"
+#include <string.h>
+
+/** @brief Checks the chunk chain of `list` and returns its number of chunks. */
+static int checkChunks(List list){
+    struct UnrolledStore *store = listStore(list);
+    int chunks = 0, total = 0;
+    struct Chunk *last = NULL;
+    for (struct Chunk *chunk = store->_first; chunk != NULL; chunk = chunk->_nextChunk){
+        CHECK(chunk->_count > 0 && chunk->_count <= store->_capacity);
+        total += chunk->_count;
+        last = chunk;
+        chunks++;
+    }
+    CHECK(store->_last == last);
+    CHECK(total == listLen(list));
+    return chunks;
+}
+
+/** @brief Returns `true` if `list` holds the `n` integers of `model`. */
+static bool sameInts(List list, const int *model, int n){
+    if (listLen(list) != n) return false;
+    int i = 0;
+    TLIST_FOREACH(list, val) if (*(int *)val != model[i++]) return false;
+    return true;
+}
+
+/** @brief Inserting into a full chunk splits it in two; emptying below half merges it back. */
+static void testSplitMerge(void){
+    List list = newListWithFlags(INT, LIST_UNROLLED);
+    int capacity = ((struct UnrolledStore *)listStore(list))->_capacity;
+    int model[64];
+    int n = 0;
+    for (int i = 0; i < capacity; i++) pushInt(list, model[n++] = i);
+    CHECK(checkChunks(list) == 1);
+
+    insertInt(list, 5, -5);
+    memmove(model + 6, model + 5, (size_t)(n++ - 5) * sizeof(int));
+    model[5] = -5;
+    CHECK(checkChunks(list) == 2);
+    struct UnrolledStore *store = listStore(list);
+    CHECK(store->_first->_count >= capacity / 2 && store->_last->_count >= capacity / 2);
+    CHECK(sameInts(list, model, n));
+
+    // The first chunk falls below half capacity while both halves fit in one chunk.
+    while (store->_first->_count >= capacity / 2){
+        listRemove(list, 0);
+        memmove(model, model + 1, (size_t)--n * sizeof(int));
+    }
+    CHECK(n <= capacity);
+    CHECK(checkChunks(list) == 1);
+    CHECK(sameInts(list, model, n));
+
+    // Removing the last element of a chunk unlinks it.
+    while (listLen(list) > 0) listRemove(list, listLen(list) - 1);
+    CHECK(checkChunks(list) == 0);
+    CHECK(store->_first == NULL);
+    pushInt(list, 1);
+    CHECK(checkChunks(list) == 1 && getInt(list, 0) == 1);
+    listDestroy(list);
+    free(list);
+}
+
+/** @brief Random inserts, removes, picks and sets against an array, checking the chain each time. */
+static void testRandom(int seed){
+    List list = newListWithFlags(INT, LIST_UNROLLED);
+    static int model[4096];
+    int n = 0;
+    unsigned state = (unsigned)seed;
+    for (int step = 0; step < 6000; step++){
+        state = state * 1103515245u + 12345u;
+        unsigned r = state >> 8;
+        // Grow during the first half, shrink during the second, so chunks both split and merge.
+        int op = (int)(r % 8);
+        if (step >= 3000 && op < 3) op += 4;
+        int index = n > 0 ? (int)(r / 8 % (unsigned)n) : 0;
+        if (n == 0 || (op <= 1 && n < 4096)) {
+            int value = (int)(r & 0xffff);
+            pushInt(list, value);
+            model[n++] = value;
+        } else if (op <= 3 && n < 4096) {
+            int value = -(int)(r & 0xffff);
+            insertInt(list, index, value);
+            memmove(model + index + 1, model + index, (size_t)(n++ - index) * sizeof(int));
+            model[index] = value;
+        } else if (op <= 5) {
+            listRemove(list, index);
+            memmove(model + index, model + index + 1, (size_t)(--n - index) * sizeof(int));
+        } else if (op == 6) {
+            int *value = listPick(list, index);
+            CHECK(value != NULL && *value == model[index]);
+            free(value);
+            memmove(model + index, model + index + 1, (size_t)(--n - index) * sizeof(int));
+        } else {
+            setInt(list, index, step);
+            model[index] = step;
+        }
+        checkChunks(list);
+        if (step % 100 == 0) CHECK(sameInts(list, model, n));
+    }
+    CHECK(sameInts(list, model, n));
+    for (int i = 0; i < n; i++) CHECK(getInt(list, i) == model[i]);
+    listDestroy(list);
+    free(list);
+}
+
+/** @brief Heap strings move with their slots when chunks split and merge. */
+static void testStrings(void){
+    List list = newListWithFlags(STRING, LIST_UNROLLED);
+    char buffer[64];
+    for (int i = 0; i < 200; i++){
+        snprintf(buffer, sizeof buffer, "a string long enough for the heap, number %d", i);
+        listInsert(list, i / 2, buffer);
+    }
+    checkChunks(list);
+    for (int i = 0; i < 150; i++) listRemove(list, (i * 7) % listLen(list));
+    checkChunks(list);
+    CHECK(listLen(list) == 50);
+    TLIST_FOREACH(list, val) CHECK(strncmp(val, "a string long enough", 20) == 0);
+    listDestroy(list);
+    free(list);
+}
+
+int main(void){
+    testSplitMerge();
+    testRandom(1);
+    testRandom(42);
+    testStrings();
+    return checkResult();
+}
@@ -0,0 +1,162 @@
+/**
+ * @file test_vector.c
+ * @brief `LIST_VECTOR` growth, `listReserve` and the shifting done by insert and remove.
+ */
+
+#include "Tlist.h"
+#include "TlistPrivate.h"
+#include "check.h"
+#include <string.h>
+
+/** @brief Checks that the element window of `list` lies inside its array. */
+static void checkWindow(List list){
+    struct VectorStore *store = listStore(list);
+    CHECK(store->_start >= 0);
+    CHECK(store->_start + listLen(list) <= store->_capacity);
+    if (listLen(list) == 0) CHECK(store->_start == 0);
+}
+
+/** @brief The array starts at `TLIST_VECTOR_MIN_CAPACITY` slots and doubles when full. */
+static void testGrowth(void){
+    List list = newListWithFlags(INT, LIST_VECTOR);
+    struct VectorStore *store = listStore(list);
+    CHECK(store->_data == NULL && store->_capacity == 0);
+    int expected = TLIST_VECTOR_MIN_CAPACITY;
+    int grows = 0;
+    for (int i = 0; i < 5000; i++){
+        int before = store->_capacity;
+        pushInt(list, i);
+        if (store->_capacity != before) {
+            CHECK(store->_capacity == expected);
+            expected *= 2;
+            grows++;
+        }
+        checkWindow(list);
+    }
+    CHECK(grows == 11);
+    for (int i = 0; i < 5000; i++) CHECK(getInt(list, i) == i);
+
+    // Popping only moves the window. Once over half the array lies before it,
+    // the next push past the end compacts instead of growing.
+    int capacity = store->_capacity;
+    for (int i = 0; i < 4200; i++) {
+        int value;
+        CHECK(popInto(list, &value) && value == i);
+    }
+    CHECK(store->_start == 4200);
+    for (int i = 0; i < capacity - 5000; i++) pushInt(list, i);
+    CHECK(store->_start + listLen(list) == capacity);
+    pushInt(list, -1);
+    CHECK(store->_capacity == capacity && store->_start == 0);
+    CHECK(getInt(list, 0) == 4200 && getInt(list, listLen(list) - 1) == -1);
+    listDestroy(list);
+    CHECK(store->_data == NULL && store->_capacity == 0);
+    free(list);
+}
+
+/** @brief `listReserve` grows once up front, never shrinks, and ignores other backends. */
+static void testReserve(void){
+    List list = newListWithFlags(DOUBLE, LIST_VECTOR);
+    struct VectorStore *store = listStore(list);
+    listReserve(list, 1000);
+    CHECK(store->_capacity >= 1000);
+    unsigned char *data = store->_data;
+    for (int i = 0; i < 1000; i++) pushDouble(list, i);
+    CHECK(store->_data == data);
+    listReserve(list, 10);
+    CHECK(store->_capacity >= 1000 && store->_data == data);
+
+    // Reserving with a popped prefix first moves the elements back to slot 0.
+    for (int i = 0; i < 600; i++) free(listPop(list));
+    listReserve(list, 900);
+    CHECK(store->_start == 0);
+    for (int i = 0; i < 400; i++) CHECK(getDouble(list, i) == 600 + i);
+    checkWindow(list);
+    listDestroy(list);
+    free(list);
+
+    List linked = newList(INT);
+    listReserve(linked, 1000);
+    pushInt(linked, 1);
+    CHECK(listLen(linked) == 1 && getInt(linked, 0) == 1);
+    listDestroy(linked);
+    free(linked);
+}
+
+/** @brief Inserts and removes shift the shorter side of the array. */
+static void testShifting(void){
+    List list = newListWithFlags(INT, LIST_VECTOR);
+    struct VectorStore *store = listStore(list);
+    for (int i = 0; i < 16; i++) pushInt(list, i);
+    // Removing in the first half shifts the front up by one slot.
+    listRemove(list, 3);
+    CHECK(store->_start == 1);
+    // Removing in the second half shifts the back down.
+    listRemove(list, 12);
+    CHECK(store->_start == 1);
+    // With room at the front, inserting in the first half shifts the front down.
+    insertInt(list, 2, 100);
+    CHECK(store->_start == 0);
+    insertInt(list, 10, 200);
+    CHECK(store->_start == 0);
+    int expected[] = { 0, 1, 100, 2, 4, 5, 6, 7, 8, 9, 200, 10, 11, 12, 14, 15 };
+    CHECK(listLen(list) == 16);
+    for (int i = 0; i < 16; i++) CHECK(getInt(list, i) == expected[i]);
+    listDestroy(list);
+    free(list);
+}
+
+/** @brief Random inserts, array inserts, removes and pops against a plain array. */
+static void testRandom(Type type){
+    List list = newListWithFlags(type, LIST_VECTOR);
+    static int model[8192];
+    int n = 0;
+    unsigned state = 7;
+    char buffer[48];
+    for (int step = 0; step < 8000; step++){
+        state = state * 1103515245u + 12345u;
+        unsigned r = state >> 8;
+        int op = (int)(r % 7);
+        int index = (int)(r / 7 % (unsigned)(n + 1));
+        int value = (int)(r & 0xfff);
+        snprintf(buffer, sizeof buffer, "%d %s", value, value % 3 ? "short" : "a value stored on the heap");
+        if (n < 8000 && (op <= 2 || n == 0)) {
+            if (type == STRING) listInsert(list, index, buffer);
+            else insertInt(list, index, value);
+            memmove(model + index + 1, model + index, (size_t)(n++ - index) * sizeof(int));
+            model[index] = value;
+        } else if (op == 3 && n < 8000 - 3) {
+            int values[3] = { value, value + 1, value + 2 };
+            if (type == INT) {
+                insertArray(list, index, values, 3);
+                memmove(model + index + 3, model + index, (size_t)(n - index) * sizeof(int));
+                memcpy(model + index, values, sizeof values);
+                n += 3;
+            }
+        } else if (op == 4 && n > 0) {
+            free(listPop(list));
+            memmove(model, model + 1, (size_t)--n * sizeof(int));
+        } else if (n > 0) {
+            if (index == n) index--;
+            listRemove(list, index);
+            memmove(model + index, model + index + 1, (size_t)(--n - index) * sizeof(int));
+        }
+        checkWindow(list);
+        CHECK(listLen(list) == n);
+    }
+    for (int i = 0; i < n; i++){
+        if (type == STRING) CHECK(atoi(listGet(list, i)) == model[i]);
+        else CHECK(getInt(list, i) == model[i]);
+    }
+    listDestroy(list);
+    free(list);
+}
+
+int main(void){
+    testGrowth();
+    testReserve();
+    testShifting();
+    testRandom(INT);
+    testRandom(STRING);
+    return checkResult();
+}